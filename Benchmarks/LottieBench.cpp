@@ -0,0 +1,239 @@
+#include <LottieCpp/LottieCpp.h>
+#include <LottieCpp/NullCanvasImpl.h>
+#include <LottieCpp/lottiejson11.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::string directory;
+    int loadIterations = 10;
+    int framePasses = 3;
+    int maxFrames = 0;
+    int width = 512;
+    int height = 512;
+};
+
+class PhaseSamples {
+public:
+    void add(double microseconds) {
+        _samples.push_back(microseconds);
+    }
+
+    lottiejson11::Json toJson() {
+        std::sort(_samples.begin(), _samples.end());
+
+        lottiejson11::Json::object result;
+        result.insert(std::make_pair("samples", (int)_samples.size()));
+        result.insert(std::make_pair("p50", percentile(0.5)));
+        result.insert(std::make_pair("p99", percentile(0.99)));
+        result.insert(std::make_pair("max", _samples.empty() ? 0.0 : _samples.back()));
+        return lottiejson11::Json(result);
+    }
+
+private:
+    /// Nearest-rank percentile, samples must already be sorted.
+    double percentile(double fraction) const {
+        if (_samples.empty()) {
+            return 0.0;
+        }
+        size_t rank = (size_t)std::ceil(fraction * (double)_samples.size());
+        rank = std::max((size_t)1, std::min(rank, _samples.size()));
+        return _samples[rank - 1];
+    }
+
+private:
+    std::vector<double> _samples;
+};
+
+class Stopwatch {
+public:
+    Stopwatch() :
+    _start(std::chrono::steady_clock::now()) {
+    }
+
+    double elapsedMicroseconds() const {
+        auto delta = std::chrono::steady_clock::now() - _start;
+        return std::chrono::duration<double, std::micro>(delta).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point _start;
+};
+
+void printUsage(char const *executable) {
+    fprintf(stderr,
+        "Usage: %s <directory> [--load-iterations N] [--frame-passes N] [--max-frames N] [--size WxH]\n"
+        "\n"
+        "Loads every .json animation in <directory> and reports p50/p99/max timings\n"
+        "in microseconds for Renderer::make, Renderer::setFrame, Renderer::renderNode\n"
+        "and CanvasRenderer::render (into NullCanvasImpl) as JSON on stdout.\n"
+        "CanvasRenderer::render fetches the render node itself, so the renderInclusive\n"
+        "phase includes the work measured by the renderNode phase.\n",
+        executable
+    );
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--load-iterations" && hasValue) {
+            options.loadIterations = std::max(1, atoi(argv[++i]));
+        } else if (argument == "--frame-passes" && hasValue) {
+            options.framePasses = std::max(1, atoi(argv[++i]));
+        } else if (argument == "--max-frames" && hasValue) {
+            options.maxFrames = std::max(0, atoi(argv[++i]));
+        } else if (argument == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 || options.width <= 0 || options.height <= 0) {
+                return false;
+            }
+        } else if (argument == "--help" || argument == "-h") {
+            return false;
+        } else if (options.directory.empty() && argument.size() != 0 && argument[0] != '-') {
+            options.directory = argument;
+        } else {
+            return false;
+        }
+    }
+    return !options.directory.empty();
+}
+
+bool readFile(std::filesystem::path const &path, std::string &result) {
+    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << stream.rdbuf();
+    result = contents.str();
+    return true;
+}
+
+lottiejson11::Json benchmarkFile(std::filesystem::path const &path, Options const &options) {
+    lottiejson11::Json::object result;
+    result.insert(std::make_pair("file", path.filename().string()));
+
+    std::string jsonString;
+    if (!readFile(path, jsonString)) {
+        result.insert(std::make_pair("error", "read failed"));
+        return lottiejson11::Json(result);
+    }
+    result.insert(std::make_pair("bytes", (double)jsonString.size()));
+
+    PhaseSamples makeSamples;
+    std::shared_ptr<lottie::Renderer> renderer;
+    for (int i = 0; i < options.loadIterations; i++) {
+        Stopwatch stopwatch;
+        auto loadedRenderer = lottie::Renderer::make(jsonString);
+        makeSamples.add(stopwatch.elapsedMicroseconds());
+
+        if (!loadedRenderer) {
+            result.insert(std::make_pair("error", "Renderer::make failed"));
+            return lottiejson11::Json(result);
+        }
+        renderer = loadedRenderer;
+    }
+
+    int frameCount = std::max(1, renderer->frameCount());
+    if (options.maxFrames != 0) {
+        frameCount = std::min(frameCount, options.maxFrames);
+    }
+    result.insert(std::make_pair("frames", frameCount));
+
+    PhaseSamples setFrameSamples;
+    PhaseSamples renderNodeSamples;
+    /// `CanvasRenderer::render` calls `Renderer::renderNode` before replaying the tree into the canvas.
+    PhaseSamples canvasRenderSamples;
+
+    lottie::CanvasRenderer canvasRenderer;
+    lottie::CanvasRenderer::Configuration configuration;
+    auto canvas = std::make_shared<lottie::NullCanvasImpl>(options.width, options.height);
+    lottie::Vector2D size((float)options.width, (float)options.height);
+
+    for (int pass = 0; pass < options.framePasses; pass++) {
+        for (int frame = 0; frame < frameCount; frame++) {
+            {
+                Stopwatch stopwatch;
+                renderer->setFrame((float)frame);
+                setFrameSamples.add(stopwatch.elapsedMicroseconds());
+            }
+            {
+                Stopwatch stopwatch;
+                auto renderNode = renderer->renderNode();
+                renderNodeSamples.add(stopwatch.elapsedMicroseconds());
+            }
+            {
+                Stopwatch stopwatch;
+                canvasRenderer.render(renderer, canvas, size, configuration);
+                canvasRenderSamples.add(stopwatch.elapsedMicroseconds());
+            }
+        }
+    }
+
+    lottiejson11::Json::object phases;
+    phases.insert(std::make_pair("make", makeSamples.toJson()));
+    phases.insert(std::make_pair("setFrame", setFrameSamples.toJson()));
+    phases.insert(std::make_pair("renderNode", renderNodeSamples.toJson()));
+    phases.insert(std::make_pair("renderInclusive", canvasRenderSamples.toJson()));
+    result.insert(std::make_pair("phases", phases));
+
+    return lottiejson11::Json(result);
+}
+
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(options.directory, error)) {
+        fprintf(stderr, "%s is not a directory\n", options.directory.c_str());
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> paths;
+    for (const auto &entry : std::filesystem::directory_iterator(options.directory, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    lottiejson11::Json::array files;
+    for (const auto &path : paths) {
+        files.push_back(benchmarkFile(path, options));
+    }
+
+    lottiejson11::Json::object parameters;
+    parameters.insert(std::make_pair("loadIterations", options.loadIterations));
+    parameters.insert(std::make_pair("framePasses", options.framePasses));
+    parameters.insert(std::make_pair("maxFrames", options.maxFrames));
+    parameters.insert(std::make_pair("width", options.width));
+    parameters.insert(std::make_pair("height", options.height));
+
+    lottiejson11::Json::object report;
+    report.insert(std::make_pair("unit", "us"));
+    report.insert(std::make_pair("parameters", parameters));
+    report.insert(std::make_pair("files", files));
+
+    std::cout << lottiejson11::Json(report).dump() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,752 @@
+#include <LottieCpp/lottiejson11.hpp>
+#include <LottieCpp/BezierPath.h>
+
+#include "Lottie/Public/Keyframes/Keyframe.hpp"
+#include "Lottie/Private/MainThread/NodeRenderSystem/NodeProperties/ValueProviders/KeyframeInterpolator.hpp"
+#include "Lottie/Private/MainThread/NodeRenderSystem/NodeProperties/ValueProviders/KeyframeChannelBatch.hpp"
+#include "Lottie/Private/Utility/Primitives/PathKernels.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// Heap allocations made by the process so far, so that parsers can be compared by allocation count. The benchmarks run
+/// on one thread.
+static size_t heapAllocationCount = 0;
+
+void *operator new(size_t size) {
+    heapAllocationCount++;
+    if (void *pointer = malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    free(pointer);
+}
+
+namespace {
+
+struct Options {
+    int iterations = 20;
+    std::string jsonDirectory;
+};
+
+class Stopwatch {
+public:
+    Stopwatch() :
+    _start(std::chrono::steady_clock::now()) {
+    }
+
+    double elapsedNanoseconds() const {
+        auto delta = std::chrono::steady_clock::now() - _start;
+        return std::chrono::duration<double, std::nano>(delta).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point _start;
+};
+
+/// Keeps the optimizer from discarding benchmarked results.
+volatile float benchmarkSink = 0.0f;
+
+void printUsage(char const *executable) {
+    fprintf(stderr,
+        "Usage: %s [--iterations N] [--json-directory DIR]\n"
+        "\n"
+        "Runs microbenchmarks of individual hot functions and reports the time per call\n"
+        "in nanoseconds (minimum over N iterations) and accuracy as JSON on stdout.\n"
+        "The JSON parsing benchmark reads every .json file in DIR, or a generated\n"
+        "animation if no directory is given.\n",
+        executable
+    );
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--iterations" && hasValue) {
+            options.iterations = std::max(1, atoi(argv[++i]));
+        } else if (argument == "--json-directory" && hasValue) {
+            options.jsonDirectory = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Reference value of a timing curve, solved by bisection in double precision.
+double referenceEasing(double progress, lottie::Vector2D const &P1, lottie::Vector2D const &P2) {
+    double cx = 3.0 * P1.x;
+    double bx = 3.0 * (P2.x - P1.x) - cx;
+    double ax = 1.0 - cx - bx;
+    double cy = 3.0 * P1.y;
+    double by = 3.0 * (P2.y - P1.y) - cy;
+    double ay = 1.0 - cy - by;
+
+    double lower = 0.0;
+    double upper = 1.0;
+    for (int i = 0; i < 80; i++) {
+        double t = 0.5 * (lower + upper);
+        if (((ax * t + bx) * t + cx) * t < progress) {
+            lower = t;
+        } else {
+            upper = t;
+        }
+    }
+    double t = 0.5 * (lower + upper);
+    return ((ay * t + by) * t + cy) * t;
+}
+
+/// Compares `CubicBezierEasing` with the `cubicBezierInterpolate` solver it replaces on keyframe spans.
+lottiejson11::Json benchmarkEasing(Options const &options) {
+    std::vector<std::pair<lottie::Vector2D, lottie::Vector2D>> curves;
+    /// Common presets (ease, ease-in, ease-out, ease-in-out, After Effects easy ease, overshoot) plus a grid.
+    curves.push_back(std::make_pair(lottie::Vector2D(0.25f, 0.1f), lottie::Vector2D(0.25f, 1.0f)));
+    curves.push_back(std::make_pair(lottie::Vector2D(0.42f, 0.0f), lottie::Vector2D(1.0f, 1.0f)));
+    curves.push_back(std::make_pair(lottie::Vector2D(0.0f, 0.0f), lottie::Vector2D(0.58f, 1.0f)));
+    curves.push_back(std::make_pair(lottie::Vector2D(0.42f, 0.0f), lottie::Vector2D(0.58f, 1.0f)));
+    curves.push_back(std::make_pair(lottie::Vector2D(0.333f, 0.0f), lottie::Vector2D(0.667f, 1.0f)));
+    curves.push_back(std::make_pair(lottie::Vector2D(0.34f, 1.56f), lottie::Vector2D(0.64f, 1.0f)));
+    for (int i = 0; i <= 4; i++) {
+        for (int j = 0; j <= 4; j++) {
+            float x1 = (float)i / 4.0f;
+            float x2 = (float)j / 4.0f;
+            curves.push_back(std::make_pair(lottie::Vector2D(x1, 0.0f), lottie::Vector2D(x2, 1.0f)));
+            curves.push_back(std::make_pair(lottie::Vector2D(x1, 1.0f), lottie::Vector2D(x2, 0.0f)));
+        }
+    }
+
+    const int progressCount = 1000;
+    std::vector<float> progressValues;
+    for (int i = 1; i < progressCount; i++) {
+        progressValues.push_back((float)i / (float)progressCount);
+    }
+
+    std::vector<lottie::CubicBezierEasing> easings;
+    for (const auto &curve : curves) {
+        easings.push_back(lottie::CubicBezierEasing(curve.first, curve.second));
+    }
+
+    double solverError = 0.0;
+    double easingError = 0.0;
+    for (size_t i = 0; i < curves.size(); i++) {
+        for (float progress : progressValues) {
+            double reference = referenceEasing(progress, curves[i].first, curves[i].second);
+            solverError = std::max(solverError, std::fabs(lottie::cubicBezierInterpolate(progress, curves[i].first, curves[i].second) - reference));
+            easingError = std::max(easingError, std::fabs(easings[i].value(progress) - reference));
+        }
+    }
+
+    double evaluationCount = (double)(curves.size() * progressValues.size());
+    double solverTime = INFINITY;
+    double easingTime = INFINITY;
+    double setupTime = INFINITY;
+    for (int iteration = 0; iteration < options.iterations; iteration++) {
+        {
+            Stopwatch stopwatch;
+            float sum = 0.0f;
+            for (const auto &curve : curves) {
+                for (float progress : progressValues) {
+                    sum += lottie::cubicBezierInterpolate(progress, curve.first, curve.second);
+                }
+            }
+            benchmarkSink = sum;
+            solverTime = std::min(solverTime, stopwatch.elapsedNanoseconds() / evaluationCount);
+        }
+        {
+            Stopwatch stopwatch;
+            float sum = 0.0f;
+            for (const auto &easing : easings) {
+                for (float progress : progressValues) {
+                    sum += easing.value(progress);
+                }
+            }
+            benchmarkSink = sum;
+            easingTime = std::min(easingTime, stopwatch.elapsedNanoseconds() / evaluationCount);
+        }
+        {
+            Stopwatch stopwatch;
+            float sum = 0.0f;
+            for (const auto &curve : curves) {
+                lottie::CubicBezierEasing easing(curve.first, curve.second);
+                sum += easing.value(0.5f);
+            }
+            benchmarkSink = sum;
+            setupTime = std::min(setupTime, stopwatch.elapsedNanoseconds() / (double)curves.size());
+        }
+    }
+
+    lottiejson11::Json::object result;
+    result.insert(std::make_pair("curves", (int)curves.size()));
+    result.insert(std::make_pair("evaluationsPerCurve", (int)progressValues.size()));
+    result.insert(std::make_pair("cubicBezierInterpolate", solverTime));
+    result.insert(std::make_pair("CubicBezierEasing::value", easingTime));
+    result.insert(std::make_pair("CubicBezierEasing::CubicBezierEasing", setupTime));
+    result.insert(std::make_pair("cubicBezierInterpolateMaxError", solverError));
+    result.insert(std::make_pair("CubicBezierEasingMaxError", easingError));
+    return lottiejson11::Json(result);
+}
+
+/// Evaluates keyframe interpolators in playback order and at random frames, for growing keyframe counts.
+/// Random access should grow with log(keyframe count), sequential access should stay flat.
+lottiejson11::Json benchmarkKeyframeSeek(Options const &options) {
+    lottiejson11::Json::object result;
+
+    for (int keyframeCount : { 10, 100, 1000, 10000 }) {
+        std::vector<lottie::Keyframe<lottie::Vector1D>> keyframes;
+        for (int i = 0; i < keyframeCount; i++) {
+            keyframes.push_back(lottie::Keyframe<lottie::Vector1D>(
+                lottie::Vector1D((float)(i % 7)),
+                (float)i,
+                false,
+                std::nullopt,
+                std::nullopt,
+                std::nullopt,
+                std::nullopt
+            ));
+        }
+        lottie::KeyframeGroup<lottie::Vector1D> keyframeGroup(std::move(keyframes));
+        lottie::KeyframeInterpolator<lottie::Vector1D> interpolator(keyframeGroup);
+
+        const int frameCount = 10000;
+        std::vector<float> sequentialFrames;
+        std::vector<float> randomFrames;
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> distribution(0.0f, (float)keyframeCount);
+        for (int i = 0; i < frameCount; i++) {
+            sequentialFrames.push_back((float)i * (float)keyframeCount / (float)frameCount);
+            randomFrames.push_back(distribution(random));
+        }
+
+        double sequentialTime = INFINITY;
+        double randomTime = INFINITY;
+        for (int iteration = 0; iteration < options.iterations; iteration++) {
+            {
+                Stopwatch stopwatch;
+                float sum = 0.0f;
+                for (float frame : sequentialFrames) {
+                    sum += interpolator.value(frame).value;
+                }
+                benchmarkSink = sum;
+                sequentialTime = std::min(sequentialTime, stopwatch.elapsedNanoseconds() / (double)frameCount);
+            }
+            {
+                Stopwatch stopwatch;
+                float sum = 0.0f;
+                for (float frame : randomFrames) {
+                    sum += interpolator.value(frame).value;
+                }
+                benchmarkSink = sum;
+                randomTime = std::min(randomTime, stopwatch.elapsedNanoseconds() / (double)frameCount);
+            }
+        }
+
+        lottiejson11::Json::object entry;
+        entry.insert(std::make_pair("sequential", sequentialTime));
+        entry.insert(std::make_pair("random", randomTime));
+        result.insert(std::make_pair(std::to_string(keyframeCount), entry));
+    }
+
+    return lottiejson11::Json(result);
+}
+
+/// Plays back many linear or eased Vector3D channels, polling one `KeyframeInterpolator` per channel as the shape outputs used
+/// to, and evaluating them all at once with `KeyframeChannelBatch`. Reports the time per channel per frame.
+lottiejson11::Json benchmarkChannelBatch(Options const &options, bool eased) {
+    const int channelCount = 1000;
+    const int keyframeCount = 10;
+    const int frameCount = 300;
+
+    std::vector<lottie::KeyframeGroup<lottie::Vector3D>> keyframeGroups;
+    for (int channel = 0; channel < channelCount; channel++) {
+        std::vector<lottie::Keyframe<lottie::Vector3D>> keyframes;
+        for (int i = 0; i < keyframeCount; i++) {
+            keyframes.push_back(lottie::Keyframe<lottie::Vector3D>(
+                lottie::Vector3D((float)(channel % 13), (float)(i % 5), (float)((channel + i) % 3)),
+                (float)(i * frameCount / (keyframeCount - 1)),
+                false,
+                eased ? std::optional<lottie::Vector2D>(lottie::Vector2D(0.58f, 1.0f)) : std::nullopt,
+                eased ? std::optional<lottie::Vector2D>(lottie::Vector2D(0.42f, 0.0f)) : std::nullopt,
+                std::nullopt,
+                std::nullopt
+            ));
+        }
+        keyframeGroups.push_back(lottie::KeyframeGroup<lottie::Vector3D>(std::move(keyframes)));
+    }
+
+    double interpolatorTime = INFINITY;
+    double batchTime = INFINITY;
+    for (int iteration = 0; iteration < options.iterations; iteration++) {
+        {
+            std::vector<std::unique_ptr<lottie::KeyframeInterpolator<lottie::Vector3D>>> interpolators;
+            for (const auto &keyframeGroup : keyframeGroups) {
+                interpolators.push_back(std::make_unique<lottie::KeyframeInterpolator<lottie::Vector3D>>(keyframeGroup));
+            }
+
+            Stopwatch stopwatch;
+            float sum = 0.0f;
+            for (int frame = 0; frame < frameCount; frame++) {
+                for (const auto &interpolator : interpolators) {
+                    if (interpolator->hasUpdate((float)frame)) {
+                        sum += interpolator->value((float)frame).x;
+                    }
+                }
+            }
+            benchmarkSink = sum;
+            interpolatorTime = std::min(interpolatorTime, stopwatch.elapsedNanoseconds() / (double)(channelCount * frameCount));
+        }
+        {
+            lottie::KeyframeChannelBatch batch;
+            std::vector<int> channels;
+            for (const auto &keyframeGroup : keyframeGroups) {
+                channels.push_back(batch.addChannel(keyframeGroup));
+            }
+
+            Stopwatch stopwatch;
+            float sum = 0.0f;
+            for (int frame = 0; frame < frameCount; frame++) {
+                batch.evaluate((float)frame);
+                for (int channel : channels) {
+                    if (batch.hasUpdate(channel)) {
+                        sum += batch.vector3DValue(channel).x;
+                    }
+                }
+            }
+            benchmarkSink = sum;
+            batchTime = std::min(batchTime, stopwatch.elapsedNanoseconds() / (double)(channelCount * frameCount));
+        }
+    }
+
+    lottiejson11::Json::object result;
+    result.insert(std::make_pair("channels", channelCount));
+    result.insert(std::make_pair("KeyframeInterpolator", interpolatorTime));
+    result.insert(std::make_pair("KeyframeChannelBatch", batchTime));
+    return lottiejson11::Json(result);
+}
+
+/// Runs every `PathKernels` implementation the CPU supports on the float layout of a path with `elementCount`
+/// elements (six floats each). Reports the time per element and whether each result matches the scalar kernels bit
+/// for bit.
+lottiejson11::Json benchmarkPathKernels(Options const &options) {
+    const int elementCount = 4096;
+    const int floatCount = elementCount * 6;
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> distribution(-500.0f, 500.0f);
+    std::vector<float> from(floatCount);
+    std::vector<float> to(floatCount);
+    for (int i = 0; i < floatCount; i++) {
+        from[i] = distribution(random);
+        to[i] = distribution(random);
+    }
+    float matrix[6] = { 0.8f, 0.6f, -0.6f, 0.8f, 12.5f, -3.25f };
+    /// The random floats double as the four control values of one-dimensional spans for `curveExtrema`.
+    const int spanCount = floatCount / 4;
+    float const *controls[4] = { from.data(), from.data() + spanCount, from.data() + spanCount * 2, from.data() + spanCount * 3 };
+
+    std::vector<lottie::PathKernels const *> kernels = lottie::PathKernels::supported();
+    lottie::PathKernels const &scalar = *kernels[0];
+
+    std::vector<float> scalarLerp(floatCount);
+    std::vector<float> scalarTransform(floatCount);
+    float scalarMin = 0.0f;
+    float scalarMax = 0.0f;
+    scalar.lerp(from.data(), to.data(), scalarLerp.data(), floatCount, 0.375f);
+    scalar.transformPoints(from.data(), scalarTransform.data(), floatCount / 2, matrix);
+    scalar.minMax(from.data(), floatCount, scalarMin, scalarMax);
+    std::vector<float> scalarExtrema(spanCount * 2);
+    scalar.curveExtrema(controls[0], controls[1], controls[2], controls[3], spanCount, scalarExtrema.data(), scalarExtrema.data() + spanCount);
+
+    lottiejson11::Json::object result;
+    result.insert(std::make_pair("elements", elementCount));
+    result.insert(std::make_pair("selected", lottie::PathKernels::current().name));
+
+    std::vector<float> output(floatCount);
+    for (lottie::PathKernels const *implementation : kernels) {
+        bool matchesScalar = true;
+        implementation->lerp(from.data(), to.data(), output.data(), floatCount, 0.375f);
+        matchesScalar = matchesScalar && memcmp(output.data(), scalarLerp.data(), floatCount * sizeof(float)) == 0;
+        implementation->transformPoints(from.data(), output.data(), floatCount / 2, matrix);
+        matchesScalar = matchesScalar && memcmp(output.data(), scalarTransform.data(), floatCount * sizeof(float)) == 0;
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        implementation->minMax(from.data(), floatCount, minValue, maxValue);
+        matchesScalar = matchesScalar && minValue == scalarMin && maxValue == scalarMax;
+        implementation->curveExtrema(controls[0], controls[1], controls[2], controls[3], spanCount, output.data(), output.data() + spanCount);
+        matchesScalar = matchesScalar && memcmp(output.data(), scalarExtrema.data(), spanCount * 2 * sizeof(float)) == 0;
+
+        double lerpTime = INFINITY;
+        double minMaxTime = INFINITY;
+        double transformTime = INFINITY;
+        double curveExtremaTime = INFINITY;
+        for (int iteration = 0; iteration < options.iterations; iteration++) {
+            {
+                Stopwatch stopwatch;
+                implementation->lerp(from.data(), to.data(), output.data(), floatCount, (float)iteration / (float)options.iterations);
+                benchmarkSink = output[iteration % floatCount];
+                lerpTime = std::min(lerpTime, stopwatch.elapsedNanoseconds() / (double)elementCount);
+            }
+            {
+                Stopwatch stopwatch;
+                /// Bounding boxes reduce the x and y coordinates separately, each about a third of the floats.
+                implementation->minMax(from.data(), floatCount / 3, minValue, maxValue);
+                implementation->minMax(to.data(), floatCount / 3, minValue, maxValue);
+                benchmarkSink = minValue + maxValue;
+                minMaxTime = std::min(minMaxTime, stopwatch.elapsedNanoseconds() / (double)elementCount);
+            }
+            {
+                Stopwatch stopwatch;
+                implementation->transformPoints(from.data(), output.data(), floatCount / 2, matrix);
+                benchmarkSink = output[iteration % floatCount];
+                transformTime = std::min(transformTime, stopwatch.elapsedNanoseconds() / (double)elementCount);
+            }
+            {
+                Stopwatch stopwatch;
+                implementation->curveExtrema(controls[0], controls[1], controls[2], controls[3], spanCount, output.data(), output.data() + spanCount);
+                benchmarkSink = output[iteration % (spanCount * 2)];
+                curveExtremaTime = std::min(curveExtremaTime, stopwatch.elapsedNanoseconds() / (double)spanCount);
+            }
+        }
+
+        lottiejson11::Json::object entry;
+        entry.insert(std::make_pair("lerp", lerpTime));
+        entry.insert(std::make_pair("minMax", minMaxTime));
+        entry.insert(std::make_pair("transformPoints", transformTime));
+        entry.insert(std::make_pair("curveExtrema", curveExtremaTime));
+        entry.insert(std::make_pair("matchesScalar", matchesScalar));
+        result.insert(std::make_pair(implementation->name, entry));
+    }
+
+    return lottiejson11::Json(result);
+}
+
+/// Affine matrix products, inverses and rect transforms as done per layer and per path while rendering.
+lottiejson11::Json benchmarkTransform(Options const &options) {
+    const int transformCount = 4096;
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> angleDistribution(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> scaleDistribution(0.25f, 4.0f);
+    std::uniform_real_distribution<float> offsetDistribution(-500.0f, 500.0f);
+    std::vector<lottie::Transform2D> transforms;
+    transforms.reserve(transformCount);
+    for (int i = 0; i < transformCount; i++) {
+        lottie::Transform2D transform = lottie::Transform2D::makeRotation(angleDistribution(random))
+            .scaled(lottie::Vector2D(scaleDistribution(random), scaleDistribution(random)))
+            .translated(lottie::Vector2D(offsetDistribution(random), offsetDistribution(random)));
+        transforms.push_back(transform);
+    }
+    lottie::CGRect rect(-12.5f, 3.0f, 240.0f, 120.0f);
+
+    double multiplyTime = INFINITY;
+    double invertTime = INFINITY;
+    double rectTime = INFINITY;
+    for (int iteration = 0; iteration < options.iterations; iteration++) {
+        {
+            Stopwatch stopwatch;
+            lottie::Transform2D accumulated = lottie::Transform2D::identity();
+            for (int i = 0; i < transformCount; i++) {
+                accumulated = transforms[i] * transforms[(i + iteration) % transformCount];
+            }
+            benchmarkSink = accumulated.rows().columns[2][0];
+            multiplyTime = std::min(multiplyTime, stopwatch.elapsedNanoseconds() / (double)transformCount);
+        }
+        {
+            Stopwatch stopwatch;
+            float sum = 0.0f;
+            for (int i = 0; i < transformCount; i++) {
+                sum += transforms[i].inverted().rows().columns[2][0];
+            }
+            benchmarkSink = sum;
+            invertTime = std::min(invertTime, stopwatch.elapsedNanoseconds() / (double)transformCount);
+        }
+        {
+            Stopwatch stopwatch;
+            float sum = 0.0f;
+            for (int i = 0; i < transformCount; i++) {
+                sum += rect.applyingTransform(transforms[i]).width;
+            }
+            benchmarkSink = sum;
+            rectTime = std::min(rectTime, stopwatch.elapsedNanoseconds() / (double)transformCount);
+        }
+    }
+
+    lottiejson11::Json::object result;
+    result.insert(std::make_pair("transforms", transformCount));
+    result.insert(std::make_pair("multiply", multiplyTime));
+    result.insert(std::make_pair("invert", invertTime));
+    result.insert(std::make_pair("rectTransform", rectTime));
+    return lottiejson11::Json(result);
+}
+
+
+/// Short trims sliding along paths of increasing length, as for an animated trim path on a long stroke.
+lottiejson11::Json benchmarkTrim(Options const &options) {
+    const int trimCount = 200;
+
+    lottiejson11::Json::object result;
+    for (int elementCount : { 16, 256, 4096 }) {
+        lottie::BezierPath path(lottie::CurveVertex::absolute(lottie::Vector2D(0.0f, 0.0f), lottie::Vector2D(0.0f, 0.0f), lottie::Vector2D(0.0f, 0.0f)));
+        for (int i = 1; i < elementCount; i++) {
+            float x = (float)i * 10.0f;
+            float y = sinf((float)i * 0.3f) * 40.0f;
+            path.addCurve(lottie::Vector2D(x, y), lottie::Vector2D(x - 7.0f, y + 20.0f), lottie::Vector2D(x - 3.0f, y - 20.0f));
+        }
+        float length = path.length();
+
+        double trimTime = INFINITY;
+        for (int iteration = 0; iteration < options.iterations; iteration++) {
+            Stopwatch stopwatch;
+            size_t pathCount = 0;
+            for (int i = 0; i < trimCount; i++) {
+                float start = length * (0.3f + 0.2f * (float)i / (float)trimCount);
+                pathCount += path.trim(start, start + length * 0.02f, 0.0f).size();
+            }
+            benchmarkSink = (float)pathCount;
+            trimTime = std::min(trimTime, stopwatch.elapsedNanoseconds() / (double)trimCount);
+        }
+        result.insert(std::make_pair(std::to_string(elementCount), trimTime));
+    }
+    return lottiejson11::Json(result);
+}
+
+/// Flattening a wavy path into line segments at a few on-screen scales, reported per curve together with the number of
+/// points produced.
+lottiejson11::Json benchmarkFlatten(Options const &options) {
+    const int elementCount = 1024;
+    const float tolerance = 0.25f;
+
+    lottie::BezierPath path(lottie::CurveVertex::absolute(lottie::Vector2D(0.0f, 0.0f), lottie::Vector2D(0.0f, 0.0f), lottie::Vector2D(0.0f, 0.0f)));
+    for (int i = 1; i < elementCount; i++) {
+        float x = (float)i * 10.0f;
+        float y = sinf((float)i * 0.3f) * 40.0f;
+        path.addCurve(lottie::Vector2D(x, y), lottie::Vector2D(x - 7.0f, y + 20.0f), lottie::Vector2D(x - 3.0f, y - 20.0f));
+    }
+
+    lottiejson11::Json::object result;
+    lottie::FlattenedBezierPath flattened;
+    for (int scalePercent : { 50, 100, 400 }) {
+        float scale = (float)scalePercent / 100.0f;
+        double flattenTime = INFINITY;
+        for (int iteration = 0; iteration < options.iterations; iteration++) {
+            Stopwatch stopwatch;
+            path.flatten(tolerance, scale, flattened);
+            benchmarkSink = flattened.points.back().x;
+            flattenTime = std::min(flattenTime, stopwatch.elapsedNanoseconds() / (double)(elementCount - 1));
+        }
+
+        lottiejson11::Json::object entry;
+        entry.insert(std::make_pair("flatten", flattenTime));
+        entry.insert(std::make_pair("points", (int)flattened.points.size()));
+        result.insert(std::make_pair(std::to_string(scalePercent) + "%", entry));
+    }
+    return lottiejson11::Json(result);
+}
+
+bool readFile(std::filesystem::path const &path, std::string &result) {
+    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << stream.rdbuf();
+    result = contents.str();
+    return true;
+}
+
+/// An animation shaped like exported ones: layers of grouped shapes whose properties are keyframed with easing.
+std::string makeGeneratedAnimation() {
+    auto keyframedProperty = [](int seed) {
+        lottiejson11::Json::array keyframes;
+        for (int i = 0; i < 8; i++) {
+            lottiejson11::Json::object keyframe;
+            keyframe.insert(std::make_pair("t", i * 15));
+            keyframe.insert(std::make_pair("s", lottiejson11::Json::array { (double)((seed + i) % 17) * 12.5, (double)((seed * i) % 11) * 7.25 }));
+            keyframe.insert(std::make_pair("i", lottiejson11::Json::object { { "x", lottiejson11::Json::array { 0.667 } }, { "y", lottiejson11::Json::array { 1.0 } } }));
+            keyframe.insert(std::make_pair("o", lottiejson11::Json::object { { "x", lottiejson11::Json::array { 0.333 } }, { "y", lottiejson11::Json::array { 0.0 } } }));
+            keyframes.push_back(keyframe);
+        }
+        return lottiejson11::Json::object { { "a", 1 }, { "k", keyframes } };
+    };
+
+    lottiejson11::Json::array layers;
+    for (int layer = 0; layer < 40; layer++) {
+        lottiejson11::Json::array shapes;
+        for (int shape = 0; shape < 6; shape++) {
+            lottiejson11::Json::array vertices;
+            for (int vertex = 0; vertex < 12; vertex++) {
+                vertices.push_back(lottiejson11::Json::array { (double)vertex * 3.5, (double)((layer + vertex) % 9) * -4.75 });
+            }
+            lottiejson11::Json::object path {
+                { "ty", "sh" },
+                { "ks", lottiejson11::Json::object { { "a", 0 }, { "k", lottiejson11::Json::object { { "c", true }, { "v", vertices }, { "i", vertices }, { "o", vertices } } } } }
+            };
+            lottiejson11::Json::object fill {
+                { "ty", "fl" },
+                { "c", lottiejson11::Json::object { { "a", 0 }, { "k", lottiejson11::Json::array { 0.9, 0.4, 0.1, 1.0 } } } },
+                { "o", lottiejson11::Json::object { { "a", 0 }, { "k", 100 } } }
+            };
+            shapes.push_back(lottiejson11::Json::object {
+                { "ty", "gr" },
+                { "nm", "Group " + std::to_string(shape) },
+                { "it", lottiejson11::Json::array { path, fill, lottiejson11::Json::object { { "ty", "tr" }, { "p", keyframedProperty(layer + shape) } } } }
+            });
+        }
+        layers.push_back(lottiejson11::Json::object {
+            { "ty", 4 },
+            { "ind", layer + 1 },
+            { "nm", "Layer " + std::to_string(layer) },
+            { "ip", 0 },
+            { "op", 120 },
+            { "ks", lottiejson11::Json::object { { "p", keyframedProperty(layer) }, { "s", keyframedProperty(layer * 3) } } },
+            { "shapes", shapes }
+        });
+    }
+
+    return lottiejson11::Json(lottiejson11::Json::object {
+        { "v", "5.7.4" },
+        { "fr", 60 },
+        { "ip", 0 },
+        { "op", 120 },
+        { "w", 512 },
+        { "h", 512 },
+        { "layers", layers }
+    }).dump();
+}
+
+/// Parses animation documents into a `Json` tree and into an arena-backed `JsonDocument`. Reports the time per parse, the
+/// heap allocations each parse makes, the arena usage, and whether the document converts back to the same `Json` tree.
+/// Clears `roundTripsMatch` if any document does not.
+lottiejson11::Json benchmarkJsonParse(Options const &options, bool &roundTripsMatch) {
+    std::vector<std::pair<std::string, std::string>> documents;
+    if (options.jsonDirectory.empty()) {
+        documents.push_back(std::make_pair("generated", makeGeneratedAnimation()));
+    } else {
+        std::error_code error;
+        std::vector<std::filesystem::path> paths;
+        for (const auto &entry : std::filesystem::directory_iterator(options.jsonDirectory, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                paths.push_back(entry.path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        for (const auto &path : paths) {
+            std::string contents;
+            if (readFile(path, contents)) {
+                documents.push_back(std::make_pair(path.filename().string(), std::move(contents)));
+            }
+        }
+    }
+
+    lottiejson11::Json::object result;
+    for (const auto &document : documents) {
+        std::string const &contents = document.second;
+        lottiejson11::Json::object entry;
+        entry.insert(std::make_pair("bytes", (double)contents.size()));
+
+        std::string error;
+        lottiejson11::Json json = lottiejson11::Json::parse(contents, error);
+        if (!error.empty()) {
+            entry.insert(std::make_pair("error", error));
+            result.insert(std::make_pair(document.first, entry));
+            continue;
+        }
+        lottiejson11::JsonDocument arenaDocument = lottiejson11::JsonDocument::parse(contents.data(), contents.size(), error);
+        bool roundTripMatches = error.empty() && arenaDocument.root().to_json() == json;
+        roundTripsMatch = roundTripsMatch && roundTripMatches;
+
+        double jsonTime = INFINITY;
+        double documentTime = INFINITY;
+        size_t jsonAllocations = 0;
+        size_t documentAllocations = 0;
+        for (int iteration = 0; iteration < options.iterations; iteration++) {
+            {
+                size_t allocationsBefore = heapAllocationCount;
+                Stopwatch stopwatch;
+                lottiejson11::Json parsed = lottiejson11::Json::parse(contents, error);
+                jsonTime = std::min(jsonTime, stopwatch.elapsedNanoseconds());
+                jsonAllocations = heapAllocationCount - allocationsBefore;
+                benchmarkSink = (float)parsed.object_items().size();
+            }
+            {
+                size_t allocationsBefore = heapAllocationCount;
+                Stopwatch stopwatch;
+                lottiejson11::JsonDocument parsed = lottiejson11::JsonDocument::parse(contents.data(), contents.size(), error);
+                documentTime = std::min(documentTime, stopwatch.elapsedNanoseconds());
+                documentAllocations = heapAllocationCount - allocationsBefore;
+                benchmarkSink = (float)parsed.root().size();
+            }
+        }
+
+        lottiejson11::JsonArena const *arena = arenaDocument.arena();
+        entry.insert(std::make_pair("Json::parse", jsonTime));
+        entry.insert(std::make_pair("JsonDocument::parse", documentTime));
+        entry.insert(std::make_pair("Json::parseAllocations", (double)jsonAllocations));
+        entry.insert(std::make_pair("JsonDocument::parseAllocations", (double)documentAllocations));
+        entry.insert(std::make_pair("arenaBytesAllocated", (double)(arena ? arena->bytes_allocated() : 0)));
+        entry.insert(std::make_pair("arenaBytesReserved", (double)(arena ? arena->bytes_reserved() : 0)));
+        entry.insert(std::make_pair("arenaChunks", (double)(arena ? arena->chunk_count() : 0)));
+        entry.insert(std::make_pair("roundTripMatches", roundTripMatches));
+        result.insert(std::make_pair(document.first, entry));
+    }
+    return lottiejson11::Json(result);
+}
+
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    lottiejson11::Json::object benchmarks;
+    benchmarks.insert(std::make_pair("easing", benchmarkEasing(options)));
+    benchmarks.insert(std::make_pair("keyframeSeek", benchmarkKeyframeSeek(options)));
+    benchmarks.insert(std::make_pair("channelBatchLinear", benchmarkChannelBatch(options, false)));
+    benchmarks.insert(std::make_pair("channelBatchEased", benchmarkChannelBatch(options, true)));
+    benchmarks.insert(std::make_pair("pathKernels", benchmarkPathKernels(options)));
+    benchmarks.insert(std::make_pair("transform", benchmarkTransform(options)));
+    benchmarks.insert(std::make_pair("trim", benchmarkTrim(options)));
+    benchmarks.insert(std::make_pair("flatten", benchmarkFlatten(options)));
+    bool roundTripsMatch = true;
+    benchmarks.insert(std::make_pair("jsonParse", benchmarkJsonParse(options, roundTripsMatch)));
+
+    lottiejson11::Json::object parameters;
+    parameters.insert(std::make_pair("iterations", options.iterations));
+
+    lottiejson11::Json::object report;
+    report.insert(std::make_pair("unit", "ns"));
+    report.insert(std::make_pair("parameters", parameters));
+    report.insert(std::make_pair("benchmarks", benchmarks));
+
+    std::cout << lottiejson11::Json(report).dump() << std::endl;
+
+    if (!roundTripsMatch) {
+        fprintf(stderr, "JsonDocument does not convert back to the tree parsed by Json::parse\n");
+        return 1;
+    }
+    return 0;
+}
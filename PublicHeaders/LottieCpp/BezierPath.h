@@ -7,6 +7,8 @@
 #include <LottieCpp/PathElement.h>
 #include <LottieCpp/ShapeAttributes.h>
 
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace lottie {
@@ -31,14 +33,43 @@ public:
     
     lottiejson11::Json toJson() const;
     
+    /// A copy with the same elements and generation but a new id.
+    std::shared_ptr<BezierPathContents> copy() const;
+    
 public:
     std::vector<PathElement> elements;
     std::optional<bool> closed;
     
+    /// Unique among all contents, never 0.
+    uint64_t const id;
+    /// Increased by every change made through `BezierPath`.
+    uint64_t generation = 0;
+    
+    /// Contents shared by several paths are never changed, but any of the paths may measure them, from any thread, so
+    /// the measured lengths are filled in under a lock. Once filled in they stay until the generation changes, which
+    /// only happens to contents that are not shared.
     float length();
     
+    /// The length of the span that ends at the element at `index`, 0 for the first element.
+    float elementLength(size_t index);
+    
+    /// The length of the path from its start to the element at `index`, 0 for the first element. This is the sum of
+    /// the span lengths up to `index`, added in order.
+    ///
+    /// The lengths of all elements are measured together with `length()` and kept until the generation changes or
+    /// `invalidateLength()` is called, so that trimming an unchanged path again locates the cut points with a binary
+    /// search instead of measuring it.
+    float lengthToElement(size_t index);
+    
 private:
+    /// Fills in the lengths unless they are valid for the current generation, `_measureMutex` must be held.
+    void measureIfNeeded();
+    
+    mutable std::mutex _measureMutex;
     std::optional<float> _length;
+    std::vector<float> _elementLengths;
+    std::vector<float> _cumulativeLengths;
+    uint64_t _measuredGeneration = 0;
     
 public:
     void moveToStartPoint(CurveVertex const &vertex);
@@ -76,6 +107,28 @@ public:
     std::vector<std::shared_ptr<BezierPathContents>> trimPathAtLengths(std::vector<BezierTrimPathPosition> const &positions);
 };
 
+/// Identifies the elements of a path at one point in time, see `BezierPath::cacheKey()`. The default value matches no path.
+struct BezierPathCacheKey {
+    uint64_t pathId = 0;
+    uint64_t generation = 0;
+    
+    bool operator==(BezierPathCacheKey const &rhs) const {
+        return pathId == rhs.pathId && generation == rhs.generation;
+    }
+    
+    bool operator!=(BezierPathCacheKey const &rhs) const {
+        return !(*this == rhs);
+    }
+};
+
+/// A path with its curves replaced by line segments, see `BezierPath::flatten`.
+struct FlattenedBezierPath {
+    std::vector<Vector2D> points;
+    bool closed = false;
+};
+
+/// A path with value semantics: copies share their contents until one of them is changed, which then copies the
+/// contents first (copy-on-write).
 class BezierPath {
 public:
     explicit BezierPath(CurveVertex const &startPoint);
@@ -115,15 +168,29 @@ public:
     std::vector<BezierPath> trim(float fromLength, float toLength, float offsetLength);
     
     std::vector<PathElement> const &elements() const;
+    /// Counts as a change of the path. The reference is only valid until the path is copied or changed again.
     std::vector<PathElement> &mutableElements();
     std::optional<bool> const &closed() const;
     void setClosed(std::optional<bool> const &closed);
     BezierPath copyUsingTransform(Transform2D const &transform) const;
     
-public:
-    BezierPath(std::shared_ptr<BezierPathContents> contents);
+    /// Replaces every curve with line segments that stay within `tolerance` of it once the path is scaled by `scale`,
+    /// so the same tolerance in pixels gives more segments to a path drawn larger. Reuses the storage of `result`.
+    void flatten(float tolerance, float scale, FlattenedBezierPath &result) const;
     
-public:
+    /// Changes whenever the elements change, and equal keys mean equal elements, so values derived from the path can
+    /// be cached under its key. Copies of a path have the same key until one of them is changed.
+    BezierPathCacheKey cacheKey() const;
+    
+private:
+    explicit BezierPath(std::shared_ptr<BezierPathContents> contents);
+    
+    /// The contents to change, copied first if another path shares them.
+    BezierPathContents &mutableContents();
+    
+private:
+    /// Only reachable through `BezierPath`, so every change goes through `mutableContents()` and bumps the generation
+    /// that `cacheKey()` relies on.
     std::shared_ptr<BezierPathContents> _contents;
 };
 
@@ -161,12 +228,19 @@ public:
     float *pointsX = nullptr;
     float *pointsY = nullptr;
     int pointsSize = 0;
+    
+    float *curveValues = nullptr;
+    int curveValuesSize = 0;
 };
 
 CGRect bezierPathsBoundingBox(std::vector<BezierPath> const &paths);
 CGRect bezierPathsBoundingBoxParallel(BezierPathsBoundingBoxContext &context, std::vector<BezierPath> const &paths);
 CGRect bezierPathsBoundingBoxParallel(BezierPathsBoundingBoxContext &context, BezierPath const &path);
 
+/// The bounding box of the curves of `path` rather than of its control points, which can be much smaller for curvy
+/// shapes. Every curve is bounded by its end points and its extrema, which are solved for in a vectorized pass.
+CGRect bezierPathsExactBoundingBox(BezierPathsBoundingBoxContext &context, BezierPath const &path);
+
 std::vector<BezierPath> trimBezierPaths(std::vector<BezierPath> &sourcePaths, float start, float end, float offset, TrimType type);
 
 }
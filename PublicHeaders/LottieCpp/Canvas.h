@@ -7,6 +7,7 @@
 #include <vector>
 #include <cassert>
 #include <functional>
+#include <optional>
 
 namespace lottie {
 
@@ -73,6 +74,11 @@ public:
     
     virtual void concatenate(Transform2D const &transform) = 0;
     
+    /// Canvases that return a tolerance receive fill and stroke paths as line segments only (`MoveTo`, `LineTo` and
+    /// `Close`). Every curve is flattened to within the tolerance in canvas pixels, and the segments are cached with the
+    /// render tree, so unchanged paths are not flattened again on the next frame.
+    virtual std::optional<float> flatteningTolerance() const { return std::nullopt; }
+    
     virtual bool pushLayer(CGRect const &rect, float alpha, std::optional<MaskMode> maskMode) { return true; };
     virtual void popLayer() {};
 };
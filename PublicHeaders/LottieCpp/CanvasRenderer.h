@@ -17,6 +17,9 @@ public:
 struct Configuration {
     bool canUseMoreMemory = false;
     bool disableGroupTransparency = false;
+    /// Sizes the layers pushed for group opacity from the extrema of the curves instead of their control points. The
+    /// layers can be much smaller for curvy shapes, at the cost of solving for the extrema once per changed path.
+    bool exactPathBounds = false;
 };
 
 public:
@@ -173,25 +173,9 @@ public:
     /// The distance from the receiver to the provided vertex.
     ///
     /// For lines (zeroed tangents) the distance between the two points is measured.
-    /// For curves the curve is iterated over by sample count and the points are measured.
-    /// This is ~99% accurate at a sample count of 30
-    float distanceTo(CurveVertex const &toVertex, int sampleCount = 25) const {
-        if (outTangentRelative().isZero() && toVertex.inTangentRelative().isZero()) {
-            /// Return a linear distance.
-            return point.distanceTo(toVertex.point);
-        }
-        
-        float distance = 0.0;
-        
-        auto previousPoint = point;
-        for (int i = 0; i < sampleCount; i++) {
-            auto pointOnCurve = splitCurve(toVertex, ((float)(i)) / ((float)(sampleCount))).trimPoint;
-            distance = distance + previousPoint.distanceTo(pointOnCurve.point);
-            previousPoint = pointOnCurve.point;
-        }
-        distance = distance + previousPoint.distanceTo(toVertex.point);
-        return distance;
-    }
+    /// For curves the arc length is integrated with adaptive Gauss-Legendre quadrature.
+    /// `sampleCount` is deprecated and ignored; it is only kept so existing callers still compile.
+    float distanceTo(CurveVertex const &toVertex, int sampleCount = 25) const;
 };
 
 }
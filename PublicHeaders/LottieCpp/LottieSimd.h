@@ -19,6 +19,18 @@
 
 #else
 
+/// Vectors are padded to four floats and matrices are stored as three such columns, the same layout as the Apple
+/// `simd` types, so that every vector and column loads as a single SSE2 or NEON register. The vector operations below
+/// perform the same float operations in the same order as the scalar fallbacks, so results do not depend on the
+/// instruction set.
+#if defined(__SSE2__) || defined(_M_X64)
+#define LOTTIE_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LOTTIE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
 #ifdef __cplusplus
 
 #ifndef MIN
@@ -29,15 +41,16 @@
 #define MAX(a,b) (a>b?a:b)
 #endif
 
-struct LottieFloat3 {
+struct alignas(16) LottieFloat3 {
     float components[3];
+    float padding = 0.0f;
     
     float operator[](int index) const {
         return components[index];
     }
 };
 
-struct LottieFloat4{
+struct alignas(16) LottieFloat4 {
     float components[4];
     
     float operator[](int index) const {
@@ -45,29 +58,58 @@ struct LottieFloat4{
     }
     
     LottieFloat4 operator*(float scalar) const {
-        LottieFloat4 result = { components[0] * scalar, components[1] * scalar, components[2] * scalar, components[3] * scalar };
+        LottieFloat4 result;
+#if LOTTIE_SIMD_SSE2
+        _mm_store_ps(result.components, _mm_mul_ps(_mm_load_ps(components), _mm_set1_ps(scalar)));
+#elif LOTTIE_SIMD_NEON
+        vst1q_f32(result.components, vmulq_n_f32(vld1q_f32(components), scalar));
+#else
+        for (int i = 0; i < 4; i++) {
+            result.components[i] = components[i] * scalar;
+        }
+#endif
         return result;
     }
     
     LottieFloat4 operator+(LottieFloat4 other) const {
-        LottieFloat4 result = { components[0] + other.components[0], components[1] + other.components[1], components[2] + other.components[2], components[3] + other.components[3] };
+        LottieFloat4 result;
+#if LOTTIE_SIMD_SSE2
+        _mm_store_ps(result.components, _mm_add_ps(_mm_load_ps(components), _mm_load_ps(other.components)));
+#elif LOTTIE_SIMD_NEON
+        vst1q_f32(result.components, vaddq_f32(vld1q_f32(components), vld1q_f32(other.components)));
+#else
+        for (int i = 0; i < 4; i++) {
+            result.components[i] = components[i] + other.components[i];
+        }
+#endif
         return result;
     }
     
     LottieFloat4 operator+(float scalar) const {
-        LottieFloat4 result = { components[0] + scalar, components[1] + scalar, components[2] + scalar, components[3] + scalar };
+        LottieFloat4 result;
+#if LOTTIE_SIMD_SSE2
+        _mm_store_ps(result.components, _mm_add_ps(_mm_load_ps(components), _mm_set1_ps(scalar)));
+#elif LOTTIE_SIMD_NEON
+        vst1q_f32(result.components, vaddq_f32(vld1q_f32(components), vdupq_n_f32(scalar)));
+#else
+        for (int i = 0; i < 4; i++) {
+            result.components[i] = components[i] + scalar;
+        }
+#endif
         return result;
     }
 };
 
 #else
 
+/// Same 16-byte alignment as the C++ definitions above, so both languages agree on the layout.
 typedef struct {
-    float components[3];
+    _Alignas(16) float components[3];
+    float padding;
 } LottieFloat3;
 
 typedef struct {
-    float components[4];
+    _Alignas(16) float components[4];
 } LottieFloat4;
 
 #endif
@@ -81,6 +123,7 @@ inline LottieFloat3 lottieSimdMakeFloat3(float a, float b, float c) {
     result.components[0] = a;
     result.components[1] = b;
     result.components[2] = c;
+    result.padding = 0.0f;
     return result;
 }
 
@@ -93,8 +136,80 @@ inline LottieFloat4 lottieSimdMakeFloat4(float a, float b, float c, float d) {
     return result;
 }
 
+#if LOTTIE_SIMD_SSE2
+
+inline __m128 lottieSimdLoadFloat3(LottieFloat3 const *value) {
+    return _mm_loadu_ps((float const *)value);
+}
+
+inline void lottieSimdStoreFloat3(LottieFloat3 *value, __m128 vector) {
+    _mm_storeu_ps((float *)value, vector);
+}
+
+/// Cross product of the first three lanes, each lane computed as `u[j + 1] * v[j + 2] - u[j + 2] * v[j + 1]`.
+inline __m128 lottieSimdCross(__m128 u, __m128 v) {
+    __m128 uYZX = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 uZXY = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 vYZX = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 vZXY = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2));
+    return _mm_sub_ps(_mm_mul_ps(uYZX, vZXY), _mm_mul_ps(uZXY, vYZX));
+}
+
+#elif LOTTIE_SIMD_NEON
+
+inline float32x4_t lottieSimdLoadFloat3(LottieFloat3 const *value) {
+    return vld1q_f32((float const *)value);
+}
+
+inline void lottieSimdStoreFloat3(LottieFloat3 *value, float32x4_t vector) {
+    vst1q_f32((float *)value, vector);
+}
+
+/// Cross product of the first three lanes, each lane computed as `u[j + 1] * v[j + 2] - u[j + 2] * v[j + 1]`.
+inline float32x4_t lottieSimdCross(float32x4_t u, float32x4_t v) {
+    /// `vextq_f32(x, x, 1)` rotates the lanes to y, z, w, x; the padding lane is then replaced to get y, z, x.
+    float32x4_t uYZX = vsetq_lane_f32(vgetq_lane_f32(u, 0), vextq_f32(u, u, 1), 2);
+    float32x4_t vYZX = vsetq_lane_f32(vgetq_lane_f32(v, 0), vextq_f32(v, v, 1), 2);
+    float32x4_t uZXY = vsetq_lane_f32(vgetq_lane_f32(u, 1), vextq_f32(u, u, 2), 1);
+    uZXY = vsetq_lane_f32(vgetq_lane_f32(u, 2), uZXY, 0);
+    float32x4_t vZXY = vsetq_lane_f32(vgetq_lane_f32(v, 1), vextq_f32(v, v, 2), 1);
+    vZXY = vsetq_lane_f32(vgetq_lane_f32(v, 2), vZXY, 0);
+    return vsubq_f32(vmulq_f32(uYZX, vZXY), vmulq_f32(uZXY, vYZX));
+}
+
+#endif
+
 inline LottieFloat3x3 lottieSimdMul(LottieFloat3x3 a, LottieFloat3x3 b) {
     LottieFloat3x3 result;
+#if LOTTIE_SIMD_SSE2
+    __m128 a0 = lottieSimdLoadFloat3(&a.columns[0]);
+    __m128 a1 = lottieSimdLoadFloat3(&a.columns[1]);
+    __m128 a2 = lottieSimdLoadFloat3(&a.columns[2]);
+    for (int i = 0; i < 3; ++i) {
+        __m128 column = _mm_add_ps(
+            _mm_add_ps(
+                _mm_mul_ps(a0, _mm_set1_ps(b.columns[i].components[0])),
+                _mm_mul_ps(a1, _mm_set1_ps(b.columns[i].components[1]))
+            ),
+            _mm_mul_ps(a2, _mm_set1_ps(b.columns[i].components[2]))
+        );
+        lottieSimdStoreFloat3(&result.columns[i], column);
+    }
+#elif LOTTIE_SIMD_NEON
+    float32x4_t a0 = lottieSimdLoadFloat3(&a.columns[0]);
+    float32x4_t a1 = lottieSimdLoadFloat3(&a.columns[1]);
+    float32x4_t a2 = lottieSimdLoadFloat3(&a.columns[2]);
+    for (int i = 0; i < 3; ++i) {
+        float32x4_t column = vaddq_f32(
+            vaddq_f32(
+                vmulq_n_f32(a0, b.columns[i].components[0]),
+                vmulq_n_f32(a1, b.columns[i].components[1])
+            ),
+            vmulq_n_f32(a2, b.columns[i].components[2])
+        );
+        lottieSimdStoreFloat3(&result.columns[i], column);
+    }
+#else
     for (int i = 0; i < 3; ++i) {
         for (int j = 0; j < 3; ++j) {
             result.columns[i].components[j] =
@@ -102,7 +217,9 @@ inline LottieFloat3x3 lottieSimdMul(LottieFloat3x3 a, LottieFloat3x3 b) {
             a.columns[1].components[j] * b.columns[i].components[1] +
             a.columns[2].components[j] * b.columns[i].components[2];
         }
+        result.columns[i].padding = 0.0f;
     }
+#endif
     
     return result;
 }
@@ -142,6 +259,44 @@ inline float lottieSimdDeterminant(LottieFloat3x3 m) {
 inline LottieFloat3x3 lottieSimdInverse(LottieFloat3x3 m) {
     LottieFloat3x3 result;
     
+    float det = lottieSimdDeterminant(m);
+    if (det == 0) {
+        LottieFloat3x3 identity = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+        return identity;
+    }
+    
+    float invDet = 1.0f / det;
+    
+#if LOTTIE_SIMD_SSE2
+    /// The rows of the adjugate are the cross products of the columns.
+    __m128 column0 = lottieSimdLoadFloat3(&m.columns[0]);
+    __m128 column1 = lottieSimdLoadFloat3(&m.columns[1]);
+    __m128 column2 = lottieSimdLoadFloat3(&m.columns[2]);
+    __m128 factor = _mm_set1_ps(invDet);
+    __m128 row0 = _mm_mul_ps(lottieSimdCross(column1, column2), factor);
+    __m128 row1 = _mm_mul_ps(lottieSimdCross(column2, column0), factor);
+    __m128 row2 = _mm_mul_ps(lottieSimdCross(column0, column1), factor);
+    __m128 row3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    lottieSimdStoreFloat3(&result.columns[0], row0);
+    lottieSimdStoreFloat3(&result.columns[1], row1);
+    lottieSimdStoreFloat3(&result.columns[2], row2);
+#elif LOTTIE_SIMD_NEON
+    /// The rows of the adjugate are the cross products of the columns.
+    LottieFloat3x3 rows;
+    float32x4_t column0 = lottieSimdLoadFloat3(&m.columns[0]);
+    float32x4_t column1 = lottieSimdLoadFloat3(&m.columns[1]);
+    float32x4_t column2 = lottieSimdLoadFloat3(&m.columns[2]);
+    lottieSimdStoreFloat3(&rows.columns[0], vmulq_n_f32(lottieSimdCross(column1, column2), invDet));
+    lottieSimdStoreFloat3(&rows.columns[1], vmulq_n_f32(lottieSimdCross(column2, column0), invDet));
+    lottieSimdStoreFloat3(&rows.columns[2], vmulq_n_f32(lottieSimdCross(column0, column1), invDet));
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            result.columns[i].components[j] = rows.columns[j].components[i];
+        }
+        result.columns[i].padding = 0.0f;
+    }
+#else
     float a = m.columns[0].components[0];
     float b = m.columns[1].components[0];
     float c = m.columns[2].components[0];
@@ -152,14 +307,6 @@ inline LottieFloat3x3 lottieSimdInverse(LottieFloat3x3 m) {
     float h = m.columns[1].components[2];
     float i = m.columns[2].components[2];
     
-    float det = lottieSimdDeterminant(m);
-    if (det == 0) {
-        LottieFloat3x3 identity = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
-        return identity;
-    }
-    
-    float invDet = 1.0f / det;
-    
     result.columns[0].components[0] = (e * i - f * h) * invDet;
     result.columns[1].components[0] = (c * h - b * i) * invDet;
     result.columns[2].components[0] = (b * f - c * e) * invDet;
@@ -172,10 +319,26 @@ inline LottieFloat3x3 lottieSimdInverse(LottieFloat3x3 m) {
     result.columns[1].components[2] = (b * g - a * h) * invDet;
     result.columns[2].components[2] = (a * e - b * d) * invDet;
     
+    result.columns[0].padding = 0.0f;
+    result.columns[1].padding = 0.0f;
+    result.columns[2].padding = 0.0f;
+#endif
+    
     return result;
 }
 
 inline bool lottieSimdEqual(LottieFloat3x3 a, LottieFloat3x3 b) {
+#if LOTTIE_SIMD_SSE2
+    __m128 equal = _mm_and_ps(
+        _mm_and_ps(
+            _mm_cmpeq_ps(lottieSimdLoadFloat3(&a.columns[0]), lottieSimdLoadFloat3(&b.columns[0])),
+            _mm_cmpeq_ps(lottieSimdLoadFloat3(&a.columns[1]), lottieSimdLoadFloat3(&b.columns[1]))
+        ),
+        _mm_cmpeq_ps(lottieSimdLoadFloat3(&a.columns[2]), lottieSimdLoadFloat3(&b.columns[2]))
+    );
+    /// The padding lane is ignored.
+    return (_mm_movemask_ps(equal) & 0x7) == 0x7;
+#else
     for (int i = 0; i < 3; ++i) {
         for (int j = 0; j < 3; ++j) {
             if (a.columns[i].components[j] != b.columns[i].components[j]) {
@@ -184,6 +347,7 @@ inline bool lottieSimdEqual(LottieFloat3x3 a, LottieFloat3x3 b) {
         }
     }
     return true;
+#endif
 }
 
 #endif
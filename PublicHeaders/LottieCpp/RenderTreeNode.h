@@ -9,6 +9,7 @@
 #include <LottieCpp/BezierPath.h>
 
 #include <optional>
+#include <vector>
 
 namespace lottie {
 
@@ -30,8 +31,25 @@ public:
     }
     
     BezierPath path;
+    
+    /// Values derived from `path`, each valid while its key equals `path.cacheKey()`.
     CGRect bounds = CGRect(0.0, 0.0, 0.0, 0.0);
-    bool needsBoundsRecalculation = true;
+    BezierPathCacheKey boundsKey;
+    /// Bounds of the curves rather than of the control points, used with `CanvasRenderer::Configuration::exactPathBounds`.
+    CGRect exactBounds = CGRect(0.0, 0.0, 0.0, 0.0);
+    BezierPathCacheKey exactBoundsKey;
+    
+    /// Line segments for canvases with a `Canvas::flatteningTolerance()`, flattened for `scale`.
+    struct Flattening {
+        FlattenedBezierPath path;
+        float tolerance = 0.0f;
+        float scale = 0.0f;
+        BezierPathCacheKey pathKey;
+    };
+    /// One entry per scale the path is drawn at, so that a path drawn at several scales in one frame, or by several
+    /// canvases, keeps all of them. Holds at most `maxFlatteningCount` entries, most recently used first.
+    std::vector<Flattening> flattenings;
+    static constexpr size_t maxFlatteningCount = 4;
 };
 
 class RenderTreeNodeContentItem {
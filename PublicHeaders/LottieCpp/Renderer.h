@@ -6,18 +6,120 @@
 #include <LottieCpp/Vectors.h>
 #include <LottieCpp/RenderTreeNode.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace lottie {
 
+class Animation;
+
+/// An animation that is parsed once and then shared by any number of `Renderer`s. It is immutable after loading,
+/// so the same instance can be used to create renderers on several threads at once. Renderers reference its
+/// keyframe data instead of copying it, and keep it alive for as long as they exist.
+class ParsedAnimation {
+public:
+    /// Runs `task` once, on any thread. Loading hands it independent pieces of work and never depends on the
+    /// executor making progress: work that has not been started when loading needs it runs on the loading thread.
+    typedef std::function<void(std::function<void()> task)> Executor;
+    
+public:
+    ~ParsedAnimation() = default;
+    
+    static std::shared_ptr<ParsedAnimation> make(std::string const &jsonString);
+    
+    /// `data` is only read during the call and does not need to be NUL-terminated.
+    static std::shared_ptr<ParsedAnimation> make(const char *data, size_t size);
+    
+    /// Same as `make(data, size)`, with layers and precomp layers built concurrently on `executor` while the rest of
+    /// the document is read. The result, including layer order, is identical to the serial path.
+    static std::shared_ptr<ParsedAnimation> make(const char *data, size_t size, Executor const &executor);
+    
+    /// Loads an animation from a snapshot produced by `Renderer::makeSnapshot`. The model keeps copies of everything it
+    /// reads, so `data` can be released as soon as the call returns.
+    static std::shared_ptr<ParsedAnimation> makeFromSnapshot(const void *data, size_t size);
+    
+public:
+    int frameCount() const;
+    int framesPerSecond() const;
+    Vector2D size() const;
+    
+private:
+    friend class Renderer;
+    
+    explicit ParsedAnimation(std::shared_ptr<Animation const> animation);
+    
+private:
+    std::shared_ptr<Animation const> _animation;
+};
+
 class Renderer {
 class Impl;
 
+public:
+    struct LoadStatistics {
+        /// Size of the input in bytes.
+        size_t byteCount = 0;
+        
+        /// Layers, including the layers of precomp assets.
+        int layerCount = 0;
+        /// Shape items, including the ones nested in groups.
+        int shapeItemCount = 0;
+        /// Keyframes of animated properties.
+        int keyframeCount = 0;
+        
+        /// Durations in seconds. JSON parsing and model building are interleaved, so they are accounted separately
+        /// rather than measured as consecutive phases.
+        double jsonParseDuration = 0.0;
+        double modelBuildDuration = 0.0;
+        double layerConstructionDuration = 0.0;
+    };
+    
+    struct LoadResult {
+        /// nullptr if the animation could not be loaded.
+        std::shared_ptr<Renderer> renderer;
+        
+        /// Empty on success.
+        std::string error;
+        /// Byte offset into the input where reading stopped, with the matching 1-based line and column.
+        /// For JSON syntax errors this is where the error was found, for unsupported or invalid animation data it
+        /// is the end of the value that was rejected.
+        size_t errorOffset = 0;
+        int errorLine = 0;
+        int errorColumn = 0;
+        
+        /// Filled in for as much of the input as was loaded, including on failure.
+        LoadStatistics statistics;
+    };
+    
 public:
     ~Renderer() = default;
     
     static std::shared_ptr<Renderer> make(std::string const &jsonString);
     
+    /// Creates a renderer with its own playback state for an already parsed animation. This only builds the layer
+    /// tree; the keyframe data stays shared with `animation` and every other renderer created from it.
+    static std::shared_ptr<Renderer> make(std::shared_ptr<ParsedAnimation> const &animation);
+    
+    /// Loads an animation straight from `data`, which is only read during the call and does not need to be
+    /// NUL-terminated, so it can point into a memory-mapped file.
+    static LoadResult make(const char *data, size_t size);
+    
+    /// Loads an animation from a snapshot produced by `makeSnapshot`. No JSON is involved: the model is read back
+    /// directly from the packed float arrays of keyframe, path and gradient data. The input is copied: keyframes, path
+    /// elements and gradient stops are built from `data` into the model, which does not reference `data` afterwards, so
+    /// `data` can point into a memory-mapped file that is unmapped once the call returns. `data` should be 4-byte
+    /// aligned; an unaligned snapshot is copied once more into aligned storage while it is read. Returns nullptr for
+    /// malformed or incompatible snapshots.
+    static std::shared_ptr<Renderer> makeFromSnapshot(const void *data, size_t size);
+    
+    /// Parses the animation in `jsonString` and serializes the resulting model into the versioned binary snapshot format.
+    /// Returns an empty vector if the animation cannot be parsed.
+    static std::vector<uint8_t> makeSnapshot(std::string const &jsonString);
+    
 public:
     int frameCount();
     int framesPerSecond();
@@ -25,6 +127,12 @@ public:
     
     void setFrame(float index);
     std::shared_ptr<RenderTreeNode> renderNode();
+    
+    /// Returns true if the frames at `index` and `otherIndex` are known to render identically, so a host that has
+    /// drawn one of them can skip drawing the other, for example when `index` follows `otherIndex` during playback.
+    /// This is computed when the renderer is created from keyframe times, hold keyframes and layer time ranges.
+    /// False means that the frames may differ; frames that are not whole always report false.
+    bool framesRenderIdentically(float index, float otherIndex);
 
 private:
     explicit Renderer(std::shared_ptr<Impl> impl);
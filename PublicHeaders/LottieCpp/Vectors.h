@@ -5,6 +5,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <optional>
 
 #include <LottieCpp/lottiejson11.hpp>
 #include <LottieCpp/LottieSimd.h>
@@ -133,6 +134,14 @@ struct Vector3D {
     float x = 0.0;
     float y = 0.0;
     float z = 0.0;
+    
+    bool operator==(Vector3D const &rhs) const {
+        return x == rhs.x && y == rhs.y && z == rhs.z;
+    }
+    
+    bool operator!=(Vector3D const &rhs) const {
+        return !(*this == rhs);
+    }
 };
 
 Vector3D interpolate(
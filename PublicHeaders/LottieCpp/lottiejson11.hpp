@@ -52,6 +52,7 @@
 
 #ifdef __cplusplus
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -176,6 +177,11 @@ public:
             return nullptr;
         }
     }
+    // Parse exactly `size` bytes starting at `in`; the buffer does not need to be NUL-terminated.
+    static Json parse(const char * in,
+                      size_t size,
+                      std::string & err,
+                      JsonParse strategy = JsonParse::STANDARD);
     // Parse multiple objects, concatenated or separated by whitespace
     static std::vector<Json> parse_multi(
         const std::string & in,
@@ -210,6 +216,190 @@ private:
     std::shared_ptr<JsonValue> m_ptr;
 };
 
+/* JsonArena
+ *
+ * Bump allocator backing a JsonDocument. Allocations are carved out of large chunks and never
+ * freed individually; all chunks are released together when the arena is destroyed.
+ */
+class JsonArena final {
+public:
+    explicit JsonArena(size_t chunk_size = 64 * 1024);
+    ~JsonArena();
+
+    JsonArena(const JsonArena &) = delete;
+    JsonArena & operator=(const JsonArena &) = delete;
+
+    void * allocate(size_t size, size_t alignment);
+
+    // Bytes handed out so far, bytes reserved from the heap to serve them, and the number of
+    // heap allocations that reserved them.
+    size_t bytes_allocated() const { return m_bytes_allocated; }
+    size_t bytes_reserved() const { return m_bytes_reserved; }
+    size_t chunk_count() const { return m_chunks.size(); }
+
+private:
+    size_t m_chunk_size;
+    char * m_cursor = nullptr;
+    char * m_end = nullptr;
+    size_t m_bytes_allocated = 0;
+    size_t m_bytes_reserved = 0;
+    std::vector<char *> m_chunks;
+};
+
+namespace detail {
+struct JsonArenaBuilder;
+}
+
+/* JsonNode
+ *
+ * Read-only JSON value stored in the arena of a JsonDocument. Strings, arrays and objects are
+ * contiguous blocks in the arena; object members are sorted by key and every key is interned,
+ * so each distinct key is stored once per document. A JsonNode is only valid while its
+ * document is alive.
+ *
+ * Accessors follow Json: asking for the wrong type yields 0, false, "", an empty container or
+ * a null node.
+ */
+class JsonNode final {
+public:
+    struct Member;
+
+    JsonNode() noexcept : m_type(Json::NUL), m_is_int(false), m_size(0), m_number(0.0) {}
+
+    Json::Type type() const { return m_type; }
+
+    bool is_null()   const { return m_type == Json::NUL; }
+    bool is_number() const { return m_type == Json::NUMBER; }
+    bool is_bool()   const { return m_type == Json::BOOL; }
+    bool is_string() const { return m_type == Json::STRING; }
+    bool is_array()  const { return m_type == Json::ARRAY; }
+    bool is_object() const { return m_type == Json::OBJECT; }
+
+    double number_value() const;
+    int int_value() const;
+    bool bool_value() const;
+
+    // NUL-terminated contents and byte length of a string.
+    const char * string_data() const;
+    size_t string_size() const;
+    std::string string_value() const { return std::string(string_data(), string_size()); }
+
+    // Number of elements of an array or members of an object, 0 otherwise.
+    size_t size() const;
+    // Elements of an array, in document order.
+    const JsonNode * array_begin() const;
+    const JsonNode * array_end() const;
+    // Members of an object, sorted by key.
+    const Member * object_begin() const;
+    const Member * object_end() const;
+
+    // Return arr[i] if this is an array and i is in range, a null node otherwise.
+    const JsonNode & operator[](size_t i) const;
+    // Return obj[key] if this is an object with that key, a null node otherwise.
+    const JsonNode & operator[](const std::string &key) const;
+    // Return the value of `key` if this is an object with that key, nullptr otherwise.
+    const JsonNode * find(const char * key, size_t key_size) const;
+
+    // Deep-copy into a heap-backed Json tree that outlives the document.
+    Json to_json() const;
+
+private:
+    friend struct detail::JsonArenaBuilder;
+
+    Json::Type m_type;
+    bool m_is_int;
+    uint32_t m_size;
+    union {
+        double m_number;
+        bool m_bool;
+        const char * m_string;
+        const JsonNode * m_items;
+        const Member * m_members;
+    };
+};
+
+struct JsonNode::Member {
+    // Interned: equal keys within one document share the same pointer.
+    const char * key;
+    uint32_t key_size;
+    JsonNode value;
+};
+
+/* JsonDocument
+ *
+ * Owner of a JSON tree parsed into a JsonArena. This is an opt-in alternative to Json::parse
+ * for parse-inspect-drop workloads: a parse costs a handful of chunk allocations instead of
+ * one or more per value, and the whole tree is released at once with the document.
+ */
+class JsonDocument final {
+public:
+    JsonDocument() noexcept;
+    ~JsonDocument();
+
+    JsonDocument(JsonDocument &&other) noexcept;
+    JsonDocument & operator=(JsonDocument &&other) noexcept;
+
+    // Parse exactly `size` bytes starting at `in`. If parse fails, return an empty document
+    // (whose root is null) and assign an error message to err.
+    static JsonDocument parse(const char * in,
+                              size_t size,
+                              std::string & err,
+                              JsonParse strategy = JsonParse::STANDARD,
+                              size_t chunk_size = 64 * 1024);
+
+    const JsonNode & root() const;
+
+    // The arena holding the tree, or nullptr for an empty document.
+    const JsonArena * arena() const { return m_arena.get(); }
+
+private:
+    std::unique_ptr<JsonArena> m_arena;
+    const JsonNode * m_root;
+};
+
+/* JsonReader
+ *
+ * Pull-style reader over an in-memory document. The caller walks objects key by key and
+ * arrays element by element, and only the values it asks for with read_value() are
+ * materialized as Json trees. This lets a large document be consumed one subtree at a time
+ * instead of holding the whole tree in memory at once.
+ *
+ * Every method returns false (or Json()) once the reader has failed; error() then describes
+ * the first problem and offset() points at the byte where it was detected.
+ */
+class JsonReader final {
+public:
+    // `data` must outlive the reader; it does not need to be NUL-terminated.
+    JsonReader(const char * data, size_t size, JsonParse strategy = JsonParse::STANDARD);
+    ~JsonReader();
+
+    JsonReader(const JsonReader &) = delete;
+    JsonReader & operator=(const JsonReader &) = delete;
+
+    // Consume the opening brace/bracket of the next value.
+    bool begin_object();
+    bool begin_array();
+
+    // Advance to the next key of the innermost object. Returns false after consuming its '}'.
+    bool next_key(std::string & key);
+    // Advance to the next element of the innermost array. Returns false after consuming its ']'.
+    bool next_element();
+
+    // Parse the next value (after next_key()/next_element()) into a Json tree.
+    Json read_value();
+
+    // Check that every container was closed and nothing but whitespace follows.
+    bool finish();
+
+    bool failed() const;
+    const std::string & error() const;
+    size_t offset() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> m_state;
+};
+
 // Internal class hierarchy - JsonValue objects are not exposed to users of this API.
 class JsonValue {
 protected:
@@ -1,5 +1,6 @@
 #include <LottieCpp/CanvasRenderer.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace lottie {
@@ -12,6 +13,9 @@ static constexpr float minVisibleAlpha = 0.5f / 255.0f;
 // Sometimes calculating path bounds is slower than just allocating the whole canvas
 static constexpr float minGlobalRectCalculationSize = 200.0f;
 
+// Paths drawn smaller than this are flattened as if drawn at this scale
+static constexpr float minFlatteningScale = 1.0f / 64.0f;
+
 struct TransformedPath {
     BezierPath path;
     Transform2D transform;
@@ -22,7 +26,24 @@ struct TransformedPath {
     }
 };
 
-static CGRect collectPathBoundingBoxes(std::shared_ptr<RenderTreeNodeContentItem> item, size_t subItemLimit, Transform2D const &parentTransform, bool skipApplyTransform, BezierPathsBoundingBoxContext &bezierPathsBoundingBoxContext) {
+static CGRect pathBoundingBox(RenderTreeNodeContentPath &path, BezierPathsBoundingBoxContext &bezierPathsBoundingBoxContext, CanvasRenderer::Configuration const &configuration) {
+    BezierPathCacheKey pathKey = path.path.cacheKey();
+    if (configuration.exactPathBounds) {
+        if (path.exactBoundsKey != pathKey) {
+            path.exactBounds = bezierPathsExactBoundingBox(bezierPathsBoundingBoxContext, path.path);
+            path.exactBoundsKey = pathKey;
+        }
+        return path.exactBounds;
+    }
+    
+    if (path.boundsKey != pathKey) {
+        path.bounds = bezierPathsBoundingBoxParallel(bezierPathsBoundingBoxContext, path.path);
+        path.boundsKey = pathKey;
+    }
+    return path.bounds;
+}
+
+static CGRect collectPathBoundingBoxes(std::shared_ptr<RenderTreeNodeContentItem> item, size_t subItemLimit, Transform2D const &parentTransform, bool skipApplyTransform, BezierPathsBoundingBoxContext &bezierPathsBoundingBoxContext, CanvasRenderer::Configuration const &configuration) {
     //TODO:remove skipApplyTransform
     Transform2D effectiveTransform = parentTransform;
     if (!skipApplyTransform && item->isGroup) {
@@ -34,11 +55,7 @@ static CGRect collectPathBoundingBoxes(std::shared_ptr<RenderTreeNodeContentItem
     CGRect boundingBox(0.0, 0.0, 0.0, 0.0);
     if (item->trimmedPaths) {
         for (const auto &path : item->trimmedPaths.value()) {
-            if (path->needsBoundsRecalculation) {
-                path->bounds = bezierPathsBoundingBoxParallel(bezierPathsBoundingBoxContext, path->path);
-                path->needsBoundsRecalculation = false;
-            }
-            CGRect subpathBoundingBox = path->bounds.applyingTransform(effectiveTransform);
+            CGRect subpathBoundingBox = pathBoundingBox(*path, bezierPathsBoundingBoxContext, configuration).applyingTransform(effectiveTransform);
             if (boundingBox.empty()) {
                 boundingBox = subpathBoundingBox;
             } else {
@@ -47,17 +64,13 @@ static CGRect collectPathBoundingBoxes(std::shared_ptr<RenderTreeNodeContentItem
         }
     } else {
         if (item->path) {
-            if (item->path->needsBoundsRecalculation) {
-                item->path->bounds = bezierPathsBoundingBoxParallel(bezierPathsBoundingBoxContext, item->path->path);
-                item->path->needsBoundsRecalculation = false;
-            }
-            boundingBox = item->path->bounds.applyingTransform(effectiveTransform);
+            boundingBox = pathBoundingBox(*item->path, bezierPathsBoundingBoxContext, configuration).applyingTransform(effectiveTransform);
         }
         
         for (size_t i = 0; i < maxSubitem; i++) {
             auto &subItem = item->subItems[i];
             
-            CGRect subItemBoundingBox = collectPathBoundingBoxes(subItem, INT32_MAX, effectiveTransform, false, bezierPathsBoundingBoxContext);
+            CGRect subItemBoundingBox = collectPathBoundingBoxes(subItem, INT32_MAX, effectiveTransform, false, bezierPathsBoundingBoxContext, configuration);
             
             if (boundingBox.empty()) {
                 boundingBox = subItemBoundingBox;
@@ -70,7 +83,7 @@ static CGRect collectPathBoundingBoxes(std::shared_ptr<RenderTreeNodeContentItem
     return boundingBox;
 }
 
-static void enumeratePaths(std::shared_ptr<RenderTreeNodeContentItem> item, size_t subItemLimit, Transform2D const &parentTransform, bool skipApplyTransform, std::function<void(BezierPath const &path, Transform2D const &transform)> const &onPath) {
+static void enumeratePaths(std::shared_ptr<RenderTreeNodeContentItem> item, size_t subItemLimit, Transform2D const &parentTransform, bool skipApplyTransform, std::function<void(RenderTreeNodeContentPath &path, Transform2D const &transform)> const &onPath) {
     //TODO:remove skipApplyTransform
     Transform2D effectiveTransform = parentTransform;
     if (!skipApplyTransform && item->isGroup) {
@@ -81,14 +94,14 @@ static void enumeratePaths(std::shared_ptr<RenderTreeNodeContentItem> item, size
     
     if (item->trimmedPaths) {
         for (const auto &path : item->trimmedPaths.value()) {
-            onPath(path->path, effectiveTransform);
+            onPath(*path, effectiveTransform);
         }
         
         return;
     }
     
     if (item->path) {
-        onPath(item->path->path, effectiveTransform);
+        onPath(*item->path, effectiveTransform);
     }
     
     for (size_t i = 0; i < maxSubitem; i++) {
@@ -100,10 +113,52 @@ static void enumeratePaths(std::shared_ptr<RenderTreeNodeContentItem> item, size
 
 }
 
-static std::optional<CGRect> getRenderContentItemLocalRect(std::shared_ptr<RenderTreeNodeContentItem> const &contentItem, BezierPathsBoundingBoxContext &bezierPathsBoundingBoxContext) {
+/// The largest factor by which `transform` stretches a vector, the largest singular value of its linear part.
+static float transformScale(Transform2D const &transform) {
+    auto const &columns = transform.rows().columns;
+    float a = columns[0][0];
+    float b = columns[0][1];
+    float c = columns[1][0];
+    float d = columns[1][1];
+    float sumOfSquares = a * a + b * b + c * c + d * d;
+    float difference = a * a + b * b - c * c - d * d;
+    float dot = a * c + b * d;
+    return sqrtf(0.5f * (sumOfSquares + sqrtf(difference * difference + 4.0f * dot * dot)));
+}
+
+/// Paths are flattened for the power of two at or above the scale they are drawn at. That keeps the tolerance for every
+/// scale up to it, so an animated scale only flattens the path again when it crosses a power of two.
+static FlattenedBezierPath const &flattenedPath(RenderTreeNodeContentPath &path, float tolerance, float scale) {
+    float flattenedScale = exp2f(ceilf(log2f(std::max(scale, minFlatteningScale))));
+    BezierPathCacheKey pathKey = path.path.cacheKey();
+    
+    auto &flattenings = path.flattenings;
+    size_t index = 0;
+    while (index < flattenings.size() && !(flattenings[index].tolerance == tolerance && flattenings[index].scale == flattenedScale)) {
+        index++;
+    }
+    if (index == flattenings.size()) {
+        if (flattenings.size() < RenderTreeNodeContentPath::maxFlatteningCount) {
+            flattenings.emplace_back();
+        } else {
+            index--;
+        }
+    }
+    auto &flattening = flattenings[index];
+    if (flattening.pathKey != pathKey || flattening.tolerance != tolerance || flattening.scale != flattenedScale) {
+        path.path.flatten(tolerance, flattenedScale, flattening.path);
+        flattening.tolerance = tolerance;
+        flattening.scale = flattenedScale;
+        flattening.pathKey = pathKey;
+    }
+    std::rotate(flattenings.begin(), flattenings.begin() + index, flattenings.begin() + index + 1);
+    return flattenings[0].path;
+}
+
+static std::optional<CGRect> getRenderContentItemLocalRect(std::shared_ptr<RenderTreeNodeContentItem> const &contentItem, BezierPathsBoundingBoxContext &bezierPathsBoundingBoxContext, CanvasRenderer::Configuration const &configuration) {
     std::optional<CGRect> localRect;
     for (const auto &shadingVariant : contentItem->shadings) {
-        CGRect shapeBounds = collectPathBoundingBoxes(contentItem, shadingVariant->subItemLimit, Transform2D::identity(), true, bezierPathsBoundingBoxContext);
+        CGRect shapeBounds = collectPathBoundingBoxes(contentItem, shadingVariant->subItemLimit, Transform2D::identity(), true, bezierPathsBoundingBoxContext, configuration);
         
         if (shadingVariant->stroke) {
             shapeBounds = shapeBounds.insetBy(-shadingVariant->stroke->lineWidth / 2.0, -shadingVariant->stroke->lineWidth / 2.0);
@@ -121,7 +176,7 @@ static std::optional<CGRect> getRenderContentItemLocalRect(std::shared_ptr<Rende
     }
     
     for (const auto &subItem : contentItem->subItems) {
-        auto subLocalRect = getRenderContentItemLocalRect(subItem, bezierPathsBoundingBoxContext);
+        auto subLocalRect = getRenderContentItemLocalRect(subItem, bezierPathsBoundingBoxContext, configuration);
         if (subLocalRect) {
             CGRect transformedSubLocalRect = subLocalRect->applyingTransform(subItem->transform);
             if (localRect) {
@@ -135,14 +190,14 @@ static std::optional<CGRect> getRenderContentItemLocalRect(std::shared_ptr<Rende
     return localRect;
 }
 
-static std::optional<CGRect> getRenderNodeLocalRect(std::shared_ptr<RenderTreeNode> const &node, bool isInvertedMatte, BezierPathsBoundingBoxContext &bezierPathsBoundingBoxContext) {
+static std::optional<CGRect> getRenderNodeLocalRect(std::shared_ptr<RenderTreeNode> const &node, bool isInvertedMatte, BezierPathsBoundingBoxContext &bezierPathsBoundingBoxContext, CanvasRenderer::Configuration const &configuration) {
     if (node->isHidden() || node->alpha() < minVisibleAlpha) {
         return std::nullopt;
     }
     
     std::optional<CGRect> localRect;
     if (node->_contentItem) {
-        localRect = getRenderContentItemLocalRect(node->_contentItem, bezierPathsBoundingBoxContext);
+        localRect = getRenderContentItemLocalRect(node->_contentItem, bezierPathsBoundingBoxContext, configuration);
     }
     
     if (isInvertedMatte) {
@@ -155,7 +210,7 @@ static std::optional<CGRect> getRenderNodeLocalRect(std::shared_ptr<RenderTreeNo
     }
     
     for (const auto &subNode : node->subnodes()) {
-        auto subLocalRect = getRenderNodeLocalRect(subNode, false, bezierPathsBoundingBoxContext);
+        auto subLocalRect = getRenderNodeLocalRect(subNode, false, bezierPathsBoundingBoxContext, configuration);
         if (subLocalRect) {
             auto transformedSubLocalRect = subLocalRect->applyingTransform(subNode->transform());
             if (localRect) {
@@ -196,7 +251,7 @@ static void drawLottieContentItem(std::shared_ptr<Canvas> const &canvas, std::sh
         if (configuration.canUseMoreMemory && globalSize.x <= minGlobalRectCalculationSize && globalSize.y <= minGlobalRectCalculationSize) {
             localRect = CGRect::veryLarge();
         } else {
-            localRect = getRenderContentItemLocalRect(item, bezierPathsBoundingBoxContext);
+            localRect = getRenderContentItemLocalRect(item, bezierPathsBoundingBoxContext, configuration);
         }
         
         if (!localRect) {
@@ -216,11 +271,30 @@ static void drawLottieContentItem(std::shared_ptr<Canvas> const &canvas, std::sh
         renderAlpha = layerAlpha;
     }
     
+    std::optional<float> flatteningTolerance = canvas->flatteningTolerance();
+    
     for (const auto &shading : item->shadings) {
         CanvasPathEnumerator iteratePaths;
         iteratePaths = [&](std::function<void(PathCommand const &)> &&iterate) {
-            enumeratePaths(item, shading->subItemLimit, Transform2D::identity(), true, [&](BezierPath const &sourcePath, Transform2D const &transform) {
-                auto path = sourcePath.copyUsingTransform(transform);
+            enumeratePaths(item, shading->subItemLimit, Transform2D::identity(), true, [&](RenderTreeNodeContentPath &sourcePath, Transform2D const &transform) {
+                if (flatteningTolerance) {
+                    FlattenedBezierPath const &flattened = flattenedPath(sourcePath, flatteningTolerance.value(), transformScale(transform * currentTransform));
+                    bool applyTransform = transform != Transform2D::identity();
+                    
+                    PathCommand pathCommand;
+                    for (size_t i = 0; i < flattened.points.size(); i++) {
+                        pathCommand.type = i == 0 ? PathCommandType::MoveTo : PathCommandType::LineTo;
+                        pathCommand.points[0] = applyTransform ? transformVector(flattened.points[i], transform) : flattened.points[i];
+                        iterate(pathCommand);
+                    }
+                    if (flattened.closed) {
+                        pathCommand.type = PathCommandType::Close;
+                        iterate(pathCommand);
+                    }
+                    return;
+                }
+                
+                auto path = sourcePath.path.copyUsingTransform(transform);
                 
                 PathCommand pathCommand;
                 std::optional<PathElement> previousElement;
@@ -386,8 +460,8 @@ static bool clipToMaskItemIfPossible(std::shared_ptr<Canvas> const &canvas, std:
     for (const auto &shading : item->shadings) {
         CanvasPathEnumerator iteratePaths;
         iteratePaths = [&](std::function<void(PathCommand const &)> &&iterate) {
-            enumeratePaths(item, shading->subItemLimit, Transform2D::identity(), true, [&](BezierPath const &sourcePath, Transform2D const &transform) {
-                auto path = sourcePath.copyUsingTransform(transform);
+            enumeratePaths(item, shading->subItemLimit, Transform2D::identity(), true, [&](RenderTreeNodeContentPath &sourcePath, Transform2D const &transform) {
+                auto path = sourcePath.path.copyUsingTransform(transform);
                 
                 PathCommand pathCommand;
                 std::optional<PathElement> previousElement;
@@ -534,7 +608,7 @@ static void renderLottieRenderNode(std::shared_ptr<RenderTreeNode> node, std::sh
         if (configuration.canUseMoreMemory && globalSize.x <= minGlobalRectCalculationSize && globalSize.y <= minGlobalRectCalculationSize) {
             localRect = CGRect::veryLarge();
         } else {
-            localRect = getRenderNodeLocalRect(node, false, bezierPathsBoundingBoxContext);
+            localRect = getRenderNodeLocalRect(node, false, bezierPathsBoundingBoxContext, configuration);
         }
         if (!localRect) {
             canvas->restoreState();
@@ -32,7 +32,8 @@ std::shared_ptr<InvertedMatteLayer> makeInvertedMatteLayer(std::shared_ptr<Compo
 /// The base class for a child layer of CompositionContainer
 class CompositionLayer: public CALayer, public KeypathSearchable {
 public:
-    CompositionLayer(std::shared_ptr<LayerModel> const &layer, Vector2D size) {
+    CompositionLayer(std::shared_ptr<LayerModel> const &layer, Vector2D size) :
+    _model(layer.get()) {
         _contentsLayer = std::make_shared<CALayer>();
         
         _transformNode = std::make_shared<LayerTransformNode>(layer->transform);
@@ -156,6 +157,11 @@ public:
         return _timeStretch;
     }
     
+    /// The model this layer was built from. Borrowed from the animation, which outlives its layers.
+    LayerModel const *model() const {
+        return _model;
+    }
+    
     virtual std::shared_ptr<RenderTreeNode> renderTreeNode(BezierPathsBoundingBoxContext &boundingBoxContext) {
         return nullptr;
     }
@@ -170,6 +176,8 @@ protected:
     std::optional<MatteType> _matteType;
     
 private:
+    LayerModel const *_model = nullptr;
+    
     std::shared_ptr<LayerTransformNode> _transformNode;
     
     std::shared_ptr<MaskContainerLayer> _maskLayer;
@@ -33,9 +33,9 @@ public:
     MaskNodeProperties(std::shared_ptr<Mask> const &mask) :
     _mode(mask->mode()),
     _inverted(mask->inverted) {
-        _opacity = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(mask->opacity->keyframes));
-        _shape = std::make_shared<NodeProperty<BezierPath>>(std::make_shared<KeyframeInterpolator<BezierPath>>(mask->shape.keyframes));
-        _expansion = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(mask->expansion->keyframes));
+        _opacity = makeKeyframeNodeProperty(*mask->opacity);
+        _shape = makeKeyframeNodeProperty(mask->shape);
+        _expansion = makeKeyframeNodeProperty(*mask->expansion);
         
         _propertyMap.insert(std::make_pair("Opacity", _opacity));
         _propertyMap.insert(std::make_pair("Shape", _shape));
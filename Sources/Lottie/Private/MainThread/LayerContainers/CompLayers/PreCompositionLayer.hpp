@@ -14,33 +14,82 @@
 
 namespace lottie {
 
-class PreCompositionLayer: public CompositionLayer {
+/// Runtime layers of one precomposition layer. The layers are built on first display, or when a keypath search asks
+/// for them, so instances that never become visible cost nothing beyond this object. Every instance owns its contents:
+/// only the asset model is shared between instances, render nodes and their caches are not.
+class PreCompositionContents {
 public:
-    PreCompositionLayer(
-        std::shared_ptr<PreCompLayerModel> const &precomp,
+    PreCompositionContents(
         PrecompAsset const &asset,
+        Vector2D size,
+        std::shared_ptr<CALayer> const &contentsLayer,
+        std::vector<std::shared_ptr<KeypathSearchable>> const &childKeypaths,
         std::shared_ptr<LayerImageProvider> const &layerImageProvider,
         std::shared_ptr<AnimationTextProvider> const &textProvider,
         std::shared_ptr<AnimationFontProvider> const &fontProvider,
         std::shared_ptr<AssetLibrary> const &assetLibrary,
-        float frameRate
-    ) : CompositionLayer(precomp, Vector2D(precomp->width, precomp->height)) {
-        if (precomp->timeRemapping) {
-            _remappingNode = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(precomp->timeRemapping->keyframes));
+        float frameRate,
+        std::shared_ptr<CompositionLayersState> const &state
+    ) :
+    _asset(asset),
+    _size(size),
+    _contentsLayer(contentsLayer),
+    _childKeypaths(childKeypaths),
+    _layerImageProvider(layerImageProvider),
+    _textProvider(textProvider),
+    _fontProvider(fontProvider),
+    _assetLibrary(assetLibrary),
+    _frameRate(frameRate),
+    _state(state) {
+        _renderTreeNode = std::make_shared<RenderTreeNode>(
+            Vector2D(0.0, 0.0),
+            Transform2D::identity(),
+            1.0,
+            false,
+            false,
+            std::vector<std::shared_ptr<RenderTreeNode>>(),
+            nullptr,
+            false
+        );
+    }
+    
+    /// The keypaths of the owning layer followed by its precomposition layers, which are built if needed.
+    std::vector<std::shared_ptr<KeypathSearchable>> const &childKeypaths() {
+        loadLayers();
+        return _childKeypaths;
+    }
+    
+    /// Holds the render nodes of the layers; empty until the contents are first displayed.
+    std::shared_ptr<RenderTreeNode> const &renderTreeNode() const {
+        return _renderTreeNode;
+    }
+    
+    void displayWithFrame(float localFrame, bool forceUpdates, BezierPathsBoundingBoxContext &boundingBoxContext) {
+        loadLayers();
+        if (!_hasRenderTreeSubnodes) {
+            addRenderTreeSubnodes(boundingBoxContext);
         }
-        _frameRate = frameRate;
         
-        setSize(Vector2D(precomp->width, precomp->height));
-        contentsLayer()->setMasksToBounds(true);
-        contentsLayer()->setSize(size());
+        for (const auto &animationLayer : _animationLayers) {
+            animationLayer->displayWithFrame(localFrame, forceUpdates, boundingBoxContext);
+        }
+    }
+    
+private:
+    void loadLayers() {
+        if (_isLoaded) {
+            return;
+        }
+        _isLoaded = true;
         
         auto layers = initializeCompositionLayers(
-            asset.layers,
-            assetLibrary,
-            layerImageProvider,
-            textProvider,
-            fontProvider,
-            frameRate
+            _asset.layers,
+            _assetLibrary,
+            _layerImageProvider,
+            _textProvider,
+            _fontProvider,
+            _frameRate,
+            _state
         );
         
         std::vector<std::shared_ptr<ImageCompositionLayer>> imageLayers;
@@ -49,7 +98,7 @@ public:
         
         for (auto layerIt = layers.rbegin(); layerIt != layers.rend(); layerIt++) {
             std::shared_ptr<CompositionLayer> layer = *layerIt;
-            layer->setSize(size());
+            layer->setSize(_size);
             _animationLayers.push_back(layer);
             
             if (layer->isImageCompositionLayer()) {
@@ -65,14 +114,93 @@ public:
                 /// We have a layer that requires a matte.
                 mattedLayer = layer;
             }
-            contentsLayer()->addSublayer(layer);
+            _contentsLayer->addSublayer(layer);
         }
         
         for (const auto &layer : layers) {
             _childKeypaths.push_back(layer);
         }
         
-        layerImageProvider->addImageLayers(imageLayers);
+        _layerImageProvider->addImageLayers(imageLayers);
+        _layerImageProvider->reloadImages(imageLayers);
+    }
+    
+    /// The render tree of the owning layer may already exist, so the nodes are attached below it and the owner of the
+    /// animation is told to recompute the `drawContentCount` values.
+    void addRenderTreeSubnodes(BezierPathsBoundingBoxContext &boundingBoxContext) {
+        _hasRenderTreeSubnodes = true;
+        
+        for (const auto &animationLayer : _animationLayers) {
+            bool found = false;
+            for (const auto &sublayer : _contentsLayer->sublayers()) {
+                if (animationLayer == sublayer) {
+                    found = true;
+                    break;
+                }
+            }
+            if (found) {
+                auto node = animationLayer->renderTreeNode(boundingBoxContext);
+                if (node) {
+                    _renderTreeNode->_subnodes.push_back(node);
+                    _renderTreeNode->drawContentCount += node->drawContentCount;
+                }
+            }
+        }
+        
+        _state->renderTreeChanged = true;
+    }
+    
+private:
+    PrecompAsset const &_asset;
+    Vector2D _size;
+    std::shared_ptr<CALayer> _contentsLayer;
+    std::vector<std::shared_ptr<KeypathSearchable>> _childKeypaths;
+    std::shared_ptr<LayerImageProvider> _layerImageProvider;
+    std::shared_ptr<AnimationTextProvider> _textProvider;
+    std::shared_ptr<AnimationFontProvider> _fontProvider;
+    std::shared_ptr<AssetLibrary> _assetLibrary;
+    float _frameRate = 0.0;
+    std::shared_ptr<CompositionLayersState> _state;
+    
+    bool _isLoaded = false;
+    bool _hasRenderTreeSubnodes = false;
+    std::vector<std::shared_ptr<CompositionLayer>> _animationLayers;
+    std::shared_ptr<RenderTreeNode> _renderTreeNode;
+};
+
+class PreCompositionLayer: public CompositionLayer {
+public:
+    PreCompositionLayer(
+        std::shared_ptr<PreCompLayerModel> const &precomp,
+        PrecompAsset const &asset,
+        std::shared_ptr<LayerImageProvider> const &layerImageProvider,
+        std::shared_ptr<AnimationTextProvider> const &textProvider,
+        std::shared_ptr<AnimationFontProvider> const &fontProvider,
+        std::shared_ptr<AssetLibrary> const &assetLibrary,
+        float frameRate,
+        std::shared_ptr<CompositionLayersState> const &state
+    ) : CompositionLayer(precomp, Vector2D(precomp->width, precomp->height)) {
+        if (precomp->timeRemapping) {
+            _remappingNode = makeKeyframeNodeProperty(*precomp->timeRemapping);
+        }
+        _frameRate = frameRate;
+        
+        setSize(Vector2D(precomp->width, precomp->height));
+        contentsLayer()->setMasksToBounds(true);
+        contentsLayer()->setSize(size());
+        
+        _contents = std::make_shared<PreCompositionContents>(
+            asset,
+            size(),
+            contentsLayer(),
+            _childKeypaths,
+            layerImageProvider,
+            textProvider,
+            fontProvider,
+            assetLibrary,
+            frameRate,
+            state
+        );
     }
     
     virtual std::map<std::string, std::shared_ptr<AnyNodeProperty>> keypathProperties() const override {
@@ -95,44 +223,17 @@ public:
             localFrame = (frame - startFrame()) / timeStretch();
         }
         
-        for (const auto &animationLayer : _animationLayers) {
-            animationLayer->displayWithFrame(localFrame, forceUpdates, boundingBoxContext);
-        }
+        _contents->displayWithFrame(localFrame, forceUpdates, boundingBoxContext);
     }
     
+    virtual std::vector<std::shared_ptr<KeypathSearchable>> const &childKeypaths() const override {
+        return _contents->childKeypaths();
+    }
+
     virtual std::shared_ptr<RenderTreeNode> renderTreeNode(BezierPathsBoundingBoxContext &boundingBoxContext) override {
         if (!_renderTreeNode) {
-            std::vector<std::shared_ptr<RenderTreeNode>> renderTreeSubnodes;
-            for (const auto &animationLayer : _animationLayers) {
-                bool found = false;
-                for (const auto &sublayer : contentsLayer()->sublayers()) {
-                    if (animationLayer == sublayer) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (found) {
-                    auto node = animationLayer->renderTreeNode(boundingBoxContext);
-                    if (node) {
-                        renderTreeSubnodes.push_back(node);
-                    }
-                }
-            }
-            
             std::vector<std::shared_ptr<RenderTreeNode>> renderTreeValue;
-            auto renderTreeContentItem = std::make_shared<RenderTreeNode>(
-                Vector2D(0.0, 0.0),
-                Transform2D::identity(),
-                1.0,
-                false,
-                false,
-                renderTreeSubnodes,
-                nullptr,
-                false
-            );
-            if (renderTreeContentItem) {
-                renderTreeValue.push_back(renderTreeContentItem);
-            }
+            renderTreeValue.push_back(_contents->renderTreeNode());
             
             _contentsTreeNode = std::make_shared<RenderTreeNode>(
                 Vector2D(0.0, 0.0),
@@ -191,7 +292,7 @@ private:
     float _frameRate = 0.0;
     std::shared_ptr<NodeProperty<Vector1D>> _remappingNode;
     
-    std::vector<std::shared_ptr<CompositionLayer>> _animationLayers;
+    std::shared_ptr<PreCompositionContents> _contents;
     
     std::shared_ptr<RenderTreeNode> _renderTreeNode;
     std::shared_ptr<RenderTreeNode> _contentsTreeNode;
@@ -11,6 +11,7 @@
 #include "Lottie/Private/MainThread/NodeRenderSystem/RenderLayers/GetGradientParameters.hpp"
 #include "Lottie/Private/MainThread/NodeRenderSystem/Nodes/RenderNodes/StrokeNode.hpp"
 #include "Lottie/Private/MainThread/NodeRenderSystem/NodeProperties/ValueProviders/DashPatternInterpolator.hpp"
+#include "Lottie/Private/MainThread/NodeRenderSystem/NodeProperties/ValueProviders/KeyframeChannelBatch.hpp"
 #include "Lottie/Private/MainThread/LayerContainers/CompLayers/ShapeUtils/BezierPathUtils.hpp"
 #include "Lottie/Private/Model/ShapeItems/ShapeTransform.hpp"
 
@@ -26,14 +27,18 @@ public:
         
         virtual bool update(AnimationFrameTime frameTime) = 0;
         virtual std::shared_ptr<RenderTreeNodeContentItem::Fill> fill() = 0;
+        
+        /// Returns true if none of the values is animated, so the fill does not change after the first update.
+        virtual bool isStatic() const = 0;
     };
     
     class SolidFillOutput : public FillOutput {
     public:
-        explicit SolidFillOutput(Fill const &fill) :
+        explicit SolidFillOutput(Fill const &fill, KeyframeChannelBatch &channels_) :
+        channels(channels_),
         rule(fill.fillRule.value_or(FillRule::NonZeroWinding)),
-        color(fill.color.keyframes),
-        opacity(fill.opacity.keyframes) {
+        color(channels_.addChannel(fill.color)),
+        opacity(channels_.addChannel(fill.opacity)) {
             auto solid = std::make_shared<RenderTreeNodeContentItem::SolidShading>(Color(0.0, 0.0, 0.0, 0.0), 0.0);
             _fill = std::make_shared<RenderTreeNodeContentItem::Fill>(
                 solid,
@@ -46,14 +51,14 @@ public:
         virtual bool update(AnimationFrameTime frameTime) override {
             bool hasUpdates = false;
             
-            if (color.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(color)) {
                 hasUpdates = true;
-                colorValue = color.value(frameTime);
+                colorValue = channels.colorValue(color);
             }
             
-            if (opacity.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(opacity)) {
                 hasUpdates = true;
-                opacityValue = opacity.value(frameTime).value;
+                opacityValue = channels.vector1DValue(opacity);
             }
             
             if (hasUpdates) {
@@ -69,13 +74,19 @@ public:
             return _fill;
         }
         
+        virtual bool isStatic() const override {
+            return channels.isConstant(color) && channels.isConstant(opacity);
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         FillRule rule;
         
-        KeyframeInterpolator<Color> color;
+        int color = 0;
         Color colorValue = Color(0.0, 0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector1D> opacity;
+        int opacity = 0;
         float opacityValue = 0.0;
         
         std::shared_ptr<RenderTreeNodeContentItem::Fill> _fill;
@@ -83,14 +94,15 @@ public:
     
     class GradientFillOutput : public FillOutput {
     public:
-        explicit GradientFillOutput(GradientFill const &gradientFill) :
+        explicit GradientFillOutput(GradientFill const &gradientFill, KeyframeChannelBatch &channels_) :
+        channels(channels_),
         rule(FillRule::NonZeroWinding),
-        numberOfColors(gradientFill.numberOfColors),
         gradientType(gradientFill.gradientType),
-        colors(gradientFill.colors.keyframes),
-        startPoint(gradientFill.startPoint.keyframes),
-        endPoint(gradientFill.endPoint.keyframes),
-        opacity(gradientFill.opacity.keyframes) {
+        colors(gradientFill.colors),
+        gradientParameters(gradientFill.numberOfColors, gradientFill.colors.keyframes),
+        startPoint(channels_.addChannel(gradientFill.startPoint)),
+        endPoint(channels_.addChannel(gradientFill.endPoint)),
+        opacity(channels_.addChannel(gradientFill.opacity)) {
             auto gradient = std::make_shared<RenderTreeNodeContentItem::GradientShading>(
                 0.0,
                 gradientType,
@@ -110,35 +122,35 @@ public:
         virtual bool update(AnimationFrameTime frameTime) override {
             bool hasUpdates = false;
             
+            bool hasColorUpdates = false;
             if (colors.hasUpdate(frameTime)) {
                 hasUpdates = true;
-                colorsValue = colors.value(frameTime);
+                hasColorUpdates = true;
+                colors.update(frameTime, colorsValue);
             }
             
-            if (startPoint.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(startPoint)) {
                 hasUpdates = true;
-                startPointValue = startPoint.value(frameTime);
+                startPointValue = channels.vector3DValue(startPoint);
             }
             
-            if (endPoint.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(endPoint)) {
                 hasUpdates = true;
-                endPointValue = endPoint.value(frameTime);
+                endPointValue = channels.vector3DValue(endPoint);
             }
             
-            if (opacity.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(opacity)) {
                 hasUpdates = true;
-                opacityValue = opacity.value(frameTime).value;
+                opacityValue = channels.vector1DValue(opacity);
             }
             
             if (hasUpdates) {
-                std::vector<Color> colors;
-                std::vector<float> locations;
-                getGradientParameters(numberOfColors, colorsValue, colors, locations);
-                
                 RenderTreeNodeContentItem::GradientShading *gradient = ((RenderTreeNodeContentItem::GradientShading *)_fill->shading.get());
                 gradient->opacity = opacityValue * 0.01;
-                gradient->colors = colors;
-                gradient->locations = locations;
+                if (hasColorUpdates) {
+                    int keyframeIndex = colors.leadingIndex() >= 0 ? colors.leadingIndex() : colors.trailingIndex();
+                    gradientParameters.evaluate(colorsValue, keyframeIndex, gradient->colors, gradient->locations);
+                }
                 gradient->start = Vector2D(startPointValue.x, startPointValue.y);
                 gradient->end = Vector2D(endPointValue.x, endPointValue.y);
             }
@@ -150,21 +162,27 @@ public:
             return _fill;
         }
         
+        virtual bool isStatic() const override {
+            return colors.isConstant() && channels.isConstant(startPoint) && channels.isConstant(endPoint) && channels.isConstant(opacity);
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         FillRule rule;
-        int numberOfColors = 0;
         GradientType gradientType;
         
-        KeyframeInterpolator<GradientColorSet> colors;
+        KeyframeSpanInterpolator<GradientColorSet> colors;
         GradientColorSet colorsValue;
+        GradientParametersEvaluator gradientParameters;
         
-        KeyframeInterpolator<Vector3D> startPoint;
+        int startPoint = 0;
         Vector3D startPointValue = Vector3D(0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector3D> endPoint;
+        int endPoint = 0;
         Vector3D endPointValue = Vector3D(0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector1D> opacity;
+        int opacity = 0;
         float opacityValue = 0.0;
         
         std::shared_ptr<RenderTreeNodeContentItem::Fill> _fill;
@@ -178,23 +196,27 @@ public:
         
         virtual bool update(AnimationFrameTime frameTime) = 0;
         virtual std::shared_ptr<RenderTreeNodeContentItem::Stroke> stroke() = 0;
+        
+        /// Returns true if none of the values is animated, so the stroke does not change after the first update.
+        virtual bool isStatic() const = 0;
     };
     
     class SolidStrokeOutput : public StrokeOutput {
     public:
-        SolidStrokeOutput(Stroke const &stroke) :
+        SolidStrokeOutput(Stroke const &stroke, KeyframeChannelBatch &channels_) :
+        channels(channels_),
         lineJoin(stroke.lineJoin),
         lineCap(stroke.lineCap),
         miterLimit(stroke.miterLimit.value_or(4.0)),
-        color(stroke.color.keyframes),
-        opacity(stroke.opacity.keyframes),
-        width(stroke.width.keyframes) {
+        color(channels_.addChannel(stroke.color)),
+        opacity(channels_.addChannel(stroke.opacity)),
+        width(channels_.addChannel(stroke.width)) {
             if (stroke.dashPattern.has_value()) {
                 StrokeShapeDashConfiguration dashConfiguration(stroke.dashPattern.value());
                 dashPattern = std::make_unique<DashPatternInterpolator>(dashConfiguration.dashPatterns);
                 
-                if (!dashConfiguration.dashPhase.empty()) {
-                    dashPhase = std::make_unique<KeyframeInterpolator<Vector1D>>(dashConfiguration.dashPhase);
+                if (dashConfiguration.dashPhase && !dashConfiguration.dashPhase->keyframes.empty()) {
+                    dashPhase = channels_.addChannel(*dashConfiguration.dashPhase);
                 }
             }
             
@@ -215,32 +237,32 @@ public:
         virtual bool update(AnimationFrameTime frameTime) override {
             bool hasUpdates = false;
             
-            if (color.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(color)) {
                 hasUpdates = true;
-                colorValue = color.value(frameTime);
+                colorValue = channels.colorValue(color);
             }
             
-            if (opacity.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(opacity)) {
                 hasUpdates = true;
-                opacityValue = opacity.value(frameTime).value;
+                opacityValue = channels.vector1DValue(opacity);
             }
             
-            if (width.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(width)) {
                 hasUpdates = true;
-                widthValue = width.value(frameTime).value;
+                widthValue = channels.vector1DValue(width);
             }
             
             if (dashPattern) {
                 if (dashPattern->hasUpdate(frameTime)) {
                     hasUpdates = true;
-                    dashPatternValue = dashPattern->value(frameTime);
+                    dashPattern->update(frameTime, dashPatternValue);
                 }
             }
             
-            if (dashPhase) {
-                if (dashPhase->hasUpdate(frameTime)) {
+            if (dashPhase >= 0) {
+                if (channels.hasUpdate(dashPhase)) {
                     hasUpdates = true;
-                    dashPhaseValue = dashPhase->value(frameTime).value;
+                    dashPhaseValue = channels.vector1DValue(dashPhase);
                 }
             }
             
@@ -261,7 +283,11 @@ public:
                 
                 _stroke->lineWidth = widthValue;
                 _stroke->dashPhase = hasNonZeroDashes ? dashPhaseValue : 0.0;
-                _stroke->dashPattern = hasNonZeroDashes ? dashPatternValue.values : std::vector<float>();
+                if (hasNonZeroDashes) {
+                    _stroke->dashPattern.assign(dashPatternValue.values.begin(), dashPatternValue.values.end());
+                } else {
+                    _stroke->dashPattern.clear();
+                }
             }
             
             return hasUpdates;
@@ -271,24 +297,39 @@ public:
             return _stroke;
         }
         
+        virtual bool isStatic() const override {
+            if (!channels.isConstant(color) || !channels.isConstant(opacity) || !channels.isConstant(width)) {
+                return false;
+            }
+            if (dashPattern && !dashPattern->isConstant()) {
+                return false;
+            }
+            if (dashPhase >= 0 && !channels.isConstant(dashPhase)) {
+                return false;
+            }
+            return true;
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         LineJoin lineJoin;
         LineCap lineCap;
         float miterLimit = 4.0;
         
-        KeyframeInterpolator<Color> color;
+        int color = 0;
         Color colorValue = Color(0.0, 0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector1D> opacity;
+        int opacity = 0;
         float opacityValue = 0.0;
         
-        KeyframeInterpolator<Vector1D> width;
+        int width = 0;
         float widthValue = 0.0;
         
         std::unique_ptr<DashPatternInterpolator> dashPattern;
         DashPattern dashPatternValue = DashPattern({});
         
-        std::unique_ptr<KeyframeInterpolator<Vector1D>> dashPhase;
+        int dashPhase = -1;
         float dashPhaseValue = 0.0;
         
         std::shared_ptr<RenderTreeNodeContentItem::Stroke> _stroke;
@@ -296,23 +337,24 @@ public:
     
     class GradientStrokeOutput : public StrokeOutput {
     public:
-        GradientStrokeOutput(GradientStroke const &gradientStroke) :
+        GradientStrokeOutput(GradientStroke const &gradientStroke, KeyframeChannelBatch &channels_) :
+        channels(channels_),
         lineJoin(gradientStroke.lineJoin),
         lineCap(gradientStroke.lineCap),
         miterLimit(gradientStroke.miterLimit.value_or(4.0)),
-        numberOfColors(gradientStroke.numberOfColors),
         gradientType(gradientStroke.gradientType),
-        colors(gradientStroke.colors.keyframes),
-        startPoint(gradientStroke.startPoint.keyframes),
-        endPoint(gradientStroke.endPoint.keyframes),
-        opacity(gradientStroke.opacity.keyframes),
-        width(gradientStroke.width.keyframes) {
+        colors(gradientStroke.colors),
+        gradientParameters(gradientStroke.numberOfColors, gradientStroke.colors.keyframes),
+        startPoint(channels_.addChannel(gradientStroke.startPoint)),
+        endPoint(channels_.addChannel(gradientStroke.endPoint)),
+        opacity(channels_.addChannel(gradientStroke.opacity)),
+        width(channels_.addChannel(gradientStroke.width)) {
             if (gradientStroke.dashPattern.has_value()) {
                 StrokeShapeDashConfiguration dashConfiguration(gradientStroke.dashPattern.value());
                 dashPattern = std::make_unique<DashPatternInterpolator>(dashConfiguration.dashPatterns);
                 
-                if (!dashConfiguration.dashPhase.empty()) {
-                    dashPhase = std::make_unique<KeyframeInterpolator<Vector1D>>(dashConfiguration.dashPhase);
+                if (dashConfiguration.dashPhase && !dashConfiguration.dashPhase->keyframes.empty()) {
+                    dashPhase = channels_.addChannel(*dashConfiguration.dashPhase);
                 }
             }
             
@@ -340,42 +382,44 @@ public:
         virtual bool update(AnimationFrameTime frameTime) override {
             bool hasUpdates = false;
             
+            bool hasColorUpdates = false;
             if (colors.hasUpdate(frameTime)) {
                 hasUpdates = true;
-                colorsValue = colors.value(frameTime);
+                hasColorUpdates = true;
+                colors.update(frameTime, colorsValue);
             }
             
-            if (startPoint.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(startPoint)) {
                 hasUpdates = true;
-                startPointValue = startPoint.value(frameTime);
+                startPointValue = channels.vector3DValue(startPoint);
             }
             
-            if (endPoint.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(endPoint)) {
                 hasUpdates = true;
-                endPointValue = endPoint.value(frameTime);
+                endPointValue = channels.vector3DValue(endPoint);
             }
             
-            if (opacity.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(opacity)) {
                 hasUpdates = true;
-                opacityValue = opacity.value(frameTime).value;
+                opacityValue = channels.vector1DValue(opacity);
             }
             
-            if (width.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(width)) {
                 hasUpdates = true;
-                widthValue = width.value(frameTime).value;
+                widthValue = channels.vector1DValue(width);
             }
             
             if (dashPattern) {
                 if (dashPattern->hasUpdate(frameTime)) {
                     hasUpdates = true;
-                    dashPatternValue = dashPattern->value(frameTime);
+                    dashPattern->update(frameTime, dashPatternValue);
                 }
             }
             
-            if (dashPhase) {
-                if (dashPhase->hasUpdate(frameTime)) {
+            if (dashPhase >= 0) {
+                if (channels.hasUpdate(dashPhase)) {
                     hasUpdates = true;
-                    dashPhaseValue = dashPhase->value(frameTime).value;
+                    dashPhaseValue = channels.vector1DValue(dashPhase);
                 }
             }
             
@@ -390,20 +434,22 @@ public:
                     }
                 }
                 
-                std::vector<Color> colors;
-                std::vector<float> locations;
-                getGradientParameters(numberOfColors, colorsValue, colors, locations);
-                
                 RenderTreeNodeContentItem::GradientShading *gradient = ((RenderTreeNodeContentItem::GradientShading *)_stroke->shading.get());
                 gradient->opacity = opacityValue * 0.01;
-                gradient->colors = colors;
-                gradient->locations = locations;
+                if (hasColorUpdates) {
+                    int keyframeIndex = colors.leadingIndex() >= 0 ? colors.leadingIndex() : colors.trailingIndex();
+                    gradientParameters.evaluate(colorsValue, keyframeIndex, gradient->colors, gradient->locations);
+                }
                 gradient->start = Vector2D(startPointValue.x, startPointValue.y);
                 gradient->end = Vector2D(endPointValue.x, endPointValue.y);
                 
                 _stroke->lineWidth = widthValue;
                 _stroke->dashPhase = hasNonZeroDashes ? dashPhaseValue : 0.0;
-                _stroke->dashPattern = hasNonZeroDashes ? dashPatternValue.values : std::vector<float>();
+                if (hasNonZeroDashes) {
+                    _stroke->dashPattern.assign(dashPatternValue.values.begin(), dashPatternValue.values.end());
+                } else {
+                    _stroke->dashPattern.clear();
+                }
             }
             
             return hasUpdates;
@@ -413,33 +459,51 @@ public:
             return _stroke;
         }
         
+        virtual bool isStatic() const override {
+            if (!colors.isConstant() || !channels.isConstant(startPoint) || !channels.isConstant(endPoint)) {
+                return false;
+            }
+            if (!channels.isConstant(opacity) || !channels.isConstant(width)) {
+                return false;
+            }
+            if (dashPattern && !dashPattern->isConstant()) {
+                return false;
+            }
+            if (dashPhase >= 0 && !channels.isConstant(dashPhase)) {
+                return false;
+            }
+            return true;
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         LineJoin lineJoin;
         LineCap lineCap;
         float miterLimit = 4.0;
         
-        int numberOfColors = 0;
         GradientType gradientType;
         
-        KeyframeInterpolator<GradientColorSet> colors;
+        KeyframeSpanInterpolator<GradientColorSet> colors;
         GradientColorSet colorsValue;
+        GradientParametersEvaluator gradientParameters;
         
-        KeyframeInterpolator<Vector3D> startPoint;
+        int startPoint = 0;
         Vector3D startPointValue = Vector3D(0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector3D> endPoint;
+        int endPoint = 0;
         Vector3D endPointValue = Vector3D(0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector1D> opacity;
+        int opacity = 0;
         float opacityValue = 0.0;
         
-        KeyframeInterpolator<Vector1D> width;
+        int width = 0;
         float widthValue = 0.0;
         
         std::unique_ptr<DashPatternInterpolator> dashPattern;
         DashPattern dashPatternValue = DashPattern({});
         
-        std::unique_ptr<KeyframeInterpolator<Vector1D>> dashPhase;
+        int dashPhase = -1;
         float dashPhaseValue = 0.0;
         
         std::shared_ptr<RenderTreeNodeContentItem::Stroke> _stroke;
@@ -447,29 +511,30 @@ public:
     
     class TrimParamsOutput {
     public:
-        TrimParamsOutput(Trim const &trim) :
+        TrimParamsOutput(Trim const &trim, KeyframeChannelBatch &channels_) :
+        channels(channels_),
         type(trim.trimType),
-        start(trim.start.keyframes),
-        end(trim.end.keyframes),
-        offset(trim.offset.keyframes) {
+        start(channels_.addChannel(trim.start)),
+        end(channels_.addChannel(trim.end)),
+        offset(channels_.addChannel(trim.offset)) {
         }
         
         bool update(AnimationFrameTime frameTime) {
             bool hasUpdates = false;
             
-            if (start.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(start)) {
                 hasUpdates = true;
-                startValue = start.value(frameTime).value;
+                startValue = channels.vector1DValue(start);
             }
             
-            if (end.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(end)) {
                 hasUpdates = true;
-                endValue = end.value(frameTime).value;
+                endValue = channels.vector1DValue(end);
             }
             
-            if (offset.hasUpdate(frameTime)) {
+            if (channels.hasUpdate(offset)) {
                 hasUpdates = true;
-                offsetValue = offset.value(frameTime).value;
+                offsetValue = channels.vector1DValue(offset);
             }
             
             return hasUpdates;
@@ -486,16 +551,22 @@ public:
             return TrimParams(resolvedStart, resolvedEnd, resolvedOffset, type);
         }
         
+        bool isStatic() const {
+            return channels.isConstant(start) && channels.isConstant(end) && channels.isConstant(offset);
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         TrimType type;
         
-        KeyframeInterpolator<Vector1D> start;
+        int start = 0;
         float startValue = 0.0;
         
-        KeyframeInterpolator<Vector1D> end;
+        int end = 0;
         float endValue = 0.0;
         
-        KeyframeInterpolator<Vector1D> offset;
+        int offset = 0;
         float offsetValue = 0.0;
     };
     
@@ -523,6 +594,9 @@ public:
         
         virtual bool update(AnimationFrameTime frameTime) = 0;
         virtual std::shared_ptr<RenderTreeNodeContentPath> &currentPath() = 0;
+        
+        /// Returns true if the path does not change after the first update.
+        virtual bool isStatic() const = 0;
     };
     
     class StaticPathOutput : public PathOutput {
@@ -539,6 +613,10 @@ public:
             return resolvedPath;
         }
         
+        virtual bool isStatic() const override {
+            return true;
+        }
+    
     private:
         std::shared_ptr<RenderTreeNodeContentPath> resolvedPath;
     };
@@ -546,7 +624,7 @@ public:
     class ShapePathOutput : public PathOutput {
     public:
         explicit ShapePathOutput(Shape const &shape) :
-        path(shape.path.keyframes),
+        path(shape.path),
         resolvedPath(std::make_shared<RenderTreeNodeContentPath>(BezierPath())) {
         }
         
@@ -556,7 +634,6 @@ public:
             if (!hasValidData || path.hasUpdate(frameTime)) {
                 hasUpdates = true;
                 path.update(frameTime, resolvedPath->path);
-                resolvedPath->needsBoundsRecalculation = true;
             }
             hasValidData = true;
             
@@ -567,6 +644,10 @@ public:
             return resolvedPath;
         }
         
+        virtual bool isStatic() const override {
+            return path.isConstant();
+        }
+    
     private:
         bool hasValidData = false;
         
@@ -577,33 +658,33 @@ public:
     
     class RectanglePathOutput : public PathOutput {
     public:
-        explicit RectanglePathOutput(Rectangle const &rectangle) :
+        explicit RectanglePathOutput(Rectangle const &rectangle, KeyframeChannelBatch &channels_) :
+        channels(channels_),
         direction(rectangle.direction.value_or(PathDirection::Clockwise)),
-        position(rectangle.position.keyframes),
-        size(rectangle.size.keyframes),
-        cornerRadius(rectangle.cornerRadius.keyframes),
+        position(channels_.addChannel(rectangle.position)),
+        size(channels_.addChannel(rectangle.size)),
+        cornerRadius(channels_.addChannel(rectangle.cornerRadius)),
         resolvedPath(std::make_shared<RenderTreeNodeContentPath>(BezierPath())) {
         }
         
         virtual bool update(AnimationFrameTime frameTime) override {
             bool hasUpdates = false;
             
-            if (!hasValidData || position.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(position)) {
                 hasUpdates = true;
-                positionValue = position.value(frameTime);
+                positionValue = channels.vector3DValue(position);
             }
-            if (!hasValidData || size.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(size)) {
                 hasUpdates = true;
-                sizeValue = size.value(frameTime);
+                sizeValue = channels.vector3DValue(size);
             }
-            if (!hasValidData || cornerRadius.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(cornerRadius)) {
                 hasUpdates = true;
-                cornerRadiusValue = cornerRadius.value(frameTime).value;
+                cornerRadiusValue = channels.vector1DValue(cornerRadius);
             }
             
             if (hasUpdates) {
                 ValueInterpolator<BezierPath>::setInplace(makeRectangleBezierPath(Vector2D(positionValue.x, positionValue.y), Vector2D(sizeValue.x, sizeValue.y), cornerRadiusValue, direction), resolvedPath->path);
-                resolvedPath->needsBoundsRecalculation = true;
             }
             
             hasValidData = true;
@@ -615,18 +696,24 @@ public:
             return resolvedPath;
         }
         
+        virtual bool isStatic() const override {
+            return channels.isConstant(position) && channels.isConstant(size) && channels.isConstant(cornerRadius);
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         bool hasValidData = false;
         
         PathDirection direction;
         
-        KeyframeInterpolator<Vector3D> position;
+        int position = 0;
         Vector3D positionValue = Vector3D(0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector3D> size;
+        int size = 0;
         Vector3D sizeValue = Vector3D(0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector1D> cornerRadius;
+        int cornerRadius = 0;
         float cornerRadiusValue = 0.0;
         
         std::shared_ptr<RenderTreeNodeContentPath> resolvedPath;
@@ -634,28 +721,28 @@ public:
     
     class EllipsePathOutput : public PathOutput {
     public:
-        explicit EllipsePathOutput(Ellipse const &ellipse) :
+        explicit EllipsePathOutput(Ellipse const &ellipse, KeyframeChannelBatch &channels_) :
+        channels(channels_),
         direction(ellipse.direction.value_or(PathDirection::Clockwise)),
-        position(ellipse.position.keyframes),
-        size(ellipse.size.keyframes),
+        position(channels_.addChannel(ellipse.position)),
+        size(channels_.addChannel(ellipse.size)),
         resolvedPath(std::make_shared<RenderTreeNodeContentPath>(BezierPath())) {
         }
         
         virtual bool update(AnimationFrameTime frameTime) override {
             bool hasUpdates = false;
             
-            if (!hasValidData || position.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(position)) {
                 hasUpdates = true;
-                positionValue = position.value(frameTime);
+                positionValue = channels.vector3DValue(position);
             }
-            if (!hasValidData || size.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(size)) {
                 hasUpdates = true;
-                sizeValue = size.value(frameTime);
+                sizeValue = channels.vector3DValue(size);
             }
             
             if (hasUpdates) {
                 ValueInterpolator<BezierPath>::setInplace(makeEllipseBezierPath(Vector2D(sizeValue.x, sizeValue.y), Vector2D(positionValue.x, positionValue.y), direction), resolvedPath->path);
-                resolvedPath->needsBoundsRecalculation = true;
             }
             
             hasValidData = true;
@@ -667,15 +754,21 @@ public:
             return resolvedPath;
         }
         
+        virtual bool isStatic() const override {
+            return channels.isConstant(position) && channels.isConstant(size);
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         bool hasValidData = false;
         
         PathDirection direction;
         
-        KeyframeInterpolator<Vector3D> position;
+        int position = 0;
         Vector3D positionValue = Vector3D(0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector3D> size;
+        int size = 0;
         Vector3D sizeValue = Vector3D(0.0, 0.0, 0.0);
         
         std::shared_ptr<RenderTreeNodeContentPath> resolvedPath;
@@ -683,70 +776,63 @@ public:
     
     class StarPathOutput : public PathOutput {
     public:
-        explicit StarPathOutput(Star const &star) :
+        explicit StarPathOutput(Star const &star, KeyframeChannelBatch &channels_) :
+        channels(channels_),
         direction(star.direction.value_or(PathDirection::Clockwise)),
-        position(star.position.keyframes),
-        outerRadius(star.outerRadius.keyframes),
-        outerRoundedness(star.outerRoundness.keyframes),
-        rotation(star.rotation.keyframes),
-        points(star.points.keyframes),
+        position(channels_.addChannel(star.position)),
+        outerRadius(channels_.addChannel(star.outerRadius)),
+        outerRoundedness(channels_.addChannel(star.outerRoundness)),
+        rotation(channels_.addChannel(star.rotation)),
+        points(channels_.addChannel(star.points)),
         resolvedPath(std::make_shared<RenderTreeNodeContentPath>(BezierPath())) {
             if (star.innerRadius.has_value()) {
-                innerRadius = std::make_unique<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(star.innerRadius->keyframes));
-            } else {
-                innerRadius = std::make_unique<NodeProperty<Vector1D>>(std::make_shared<SingleValueProvider<Vector1D>>(Vector1D(0.0)));
+                innerRadius = channels_.addChannel(*star.innerRadius);
             }
-            
             if (star.innerRoundness.has_value()) {
-                innerRoundedness = std::make_unique<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(star.innerRoundness->keyframes));
-            } else {
-                innerRoundedness = std::make_unique<NodeProperty<Vector1D>>(std::make_shared<SingleValueProvider<Vector1D>>(Vector1D(0.0)));
+                innerRoundedness = channels_.addChannel(*star.innerRoundness);
             }
         }
         
         virtual bool update(AnimationFrameTime frameTime) override {
             bool hasUpdates = false;
             
-            if (!hasValidData || position.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(position)) {
                 hasUpdates = true;
-                positionValue = position.value(frameTime);
+                positionValue = channels.vector3DValue(position);
             }
             
-            if (!hasValidData || outerRadius.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(outerRadius)) {
                 hasUpdates = true;
-                outerRadiusValue = outerRadius.value(frameTime).value;
+                outerRadiusValue = channels.vector1DValue(outerRadius);
             }
             
-            innerRadius->update(frameTime);
-            if (!hasValidData || innerRadiusValue != innerRadius->value().value) {
+            if (innerRadius >= 0 && (!hasValidData || channels.hasUpdate(innerRadius))) {
                 hasUpdates = true;
-                innerRadiusValue = innerRadius->value().value;
+                innerRadiusValue = channels.vector1DValue(innerRadius);
             }
             
-            if (!hasValidData || outerRoundedness.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(outerRoundedness)) {
                 hasUpdates = true;
-                outerRoundednessValue = outerRoundedness.value(frameTime).value;
+                outerRoundednessValue = channels.vector1DValue(outerRoundedness);
             }
             
-            innerRoundedness->update(frameTime);
-            if (!hasValidData || innerRoundednessValue != innerRoundedness->value().value) {
+            if (innerRoundedness >= 0 && (!hasValidData || channels.hasUpdate(innerRoundedness))) {
                 hasUpdates = true;
-                innerRoundednessValue = innerRoundedness->value().value;
+                innerRoundednessValue = channels.vector1DValue(innerRoundedness);
             }
             
-            if (!hasValidData || points.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(points)) {
                 hasUpdates = true;
-                pointsValue = points.value(frameTime).value;
+                pointsValue = channels.vector1DValue(points);
             }
             
-            if (!hasValidData || rotation.hasUpdate(frameTime)) {
+            if (!hasValidData || channels.hasUpdate(rotation)) {
                 hasUpdates = true;
-                rotationValue = rotation.value(frameTime).value;
+                rotationValue = channels.vector1DValue(rotation);
             }
             
             if (hasUpdates) {
                 ValueInterpolator<BezierPath>::setInplace(makeStarBezierPath(Vector2D(positionValue.x, positionValue.y), outerRadiusValue, innerRadiusValue, outerRoundednessValue, innerRoundednessValue, pointsValue, rotationValue, direction), resolvedPath->path);
-                resolvedPath->needsBoundsRecalculation = true;
             }
             
             hasValidData = true;
@@ -758,30 +844,46 @@ public:
             return resolvedPath;
         }
         
+        virtual bool isStatic() const override {
+            if (!channels.isConstant(position) || !channels.isConstant(outerRadius) || !channels.isConstant(outerRoundedness)) {
+                return false;
+            }
+            if (innerRadius >= 0 && !channels.isConstant(innerRadius)) {
+                return false;
+            }
+            if (innerRoundedness >= 0 && !channels.isConstant(innerRoundedness)) {
+                return false;
+            }
+            return channels.isConstant(rotation) && channels.isConstant(points);
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         bool hasValidData = false;
         
         PathDirection direction;
         
-        KeyframeInterpolator<Vector3D> position;
+        int position = 0;
         Vector3D positionValue = Vector3D(0.0, 0.0, 0.0);
         
-        KeyframeInterpolator<Vector1D> outerRadius;
+        int outerRadius = 0;
         float outerRadiusValue = 0.0;
         
-        KeyframeInterpolator<Vector1D> outerRoundedness;
+        int outerRoundedness = 0;
         float outerRoundednessValue = 0.0;
         
-        std::unique_ptr<NodeProperty<Vector1D>> innerRadius;
+        /// -1 if the star has no inner radius (a polygon), the value then stays 0.
+        int innerRadius = -1;
         float innerRadiusValue = 0.0;
         
-        std::unique_ptr<NodeProperty<Vector1D>> innerRoundedness;
+        int innerRoundedness = -1;
         float innerRoundednessValue = 0.0;
         
-        KeyframeInterpolator<Vector1D> rotation;
+        int rotation = 0;
         float rotationValue = 0.0;
         
-        KeyframeInterpolator<Vector1D> points;
+        int points = 0;
         float pointsValue = 0.0;
         
         std::shared_ptr<RenderTreeNodeContentPath> resolvedPath;
@@ -789,27 +891,28 @@ public:
     
     class TransformOutput {
     public:
-        TransformOutput(std::shared_ptr<ShapeTransform> shapeTransform) {
+        TransformOutput(std::shared_ptr<ShapeTransform> shapeTransform, KeyframeChannelBatch &channels_) :
+        channels(channels_) {
             if (shapeTransform->anchor) {
-                _anchor = std::make_unique<KeyframeInterpolator<Vector3D>>(shapeTransform->anchor->keyframes);
+                _anchor = channels_.addChannel(*shapeTransform->anchor);
             }
             if (shapeTransform->position) {
-                _position = std::make_unique<KeyframeInterpolator<Vector3D>>(shapeTransform->position->keyframes);
+                _position = channels_.addChannel(*shapeTransform->position);
             }
             if (shapeTransform->scale) {
-                _scale = std::make_unique<KeyframeInterpolator<Vector3D>>(shapeTransform->scale->keyframes);
+                _scale = channels_.addChannel(*shapeTransform->scale);
             }
             if (shapeTransform->rotation) {
-                _rotation = std::make_unique<KeyframeInterpolator<Vector1D>>(shapeTransform->rotation->keyframes);
+                _rotation = channels_.addChannel(*shapeTransform->rotation);
             }
             if (shapeTransform->skew) {
-                _skew = std::make_unique<KeyframeInterpolator<Vector1D>>(shapeTransform->skew->keyframes);
+                _skew = channels_.addChannel(*shapeTransform->skew);
             }
             if (shapeTransform->skewAxis) {
-                _skewAxis = std::make_unique<KeyframeInterpolator<Vector1D>>(shapeTransform->skewAxis->keyframes);
+                _skewAxis = channels_.addChannel(*shapeTransform->skewAxis);
             }
             if (shapeTransform->opacity) {
-                _opacity = std::make_unique<KeyframeInterpolator<Vector1D>>(shapeTransform->opacity->keyframes);
+                _opacity = channels_.addChannel(*shapeTransform->opacity);
             }
         }
         
@@ -821,31 +924,31 @@ public:
                 hasUpdates = true;
                 hasTransformUpdate = true;
             }
-            if (_anchor && _anchor->hasUpdate(frameTime)) {
+            if (_anchor >= 0 && channels.hasUpdate(_anchor)) {
                 hasUpdates = true;
                 hasTransformUpdate = true;
             }
-            if (_position && _position->hasUpdate(frameTime)) {
+            if (_position >= 0 && channels.hasUpdate(_position)) {
                 hasUpdates = true;
                 hasTransformUpdate = true;
             }
-            if (_scale && _scale->hasUpdate(frameTime)) {
+            if (_scale >= 0 && channels.hasUpdate(_scale)) {
                 hasUpdates = true;
                 hasTransformUpdate = true;
             }
-            if (_rotation && _rotation->hasUpdate(frameTime)) {
+            if (_rotation >= 0 && channels.hasUpdate(_rotation)) {
                 hasUpdates = true;
                 hasTransformUpdate = true;
             }
-            if (_skew && _skew->hasUpdate(frameTime)) {
+            if (_skew >= 0 && channels.hasUpdate(_skew)) {
                 hasUpdates = true;
                 hasTransformUpdate = true;
             }
-            if (_skewAxis && _skewAxis->hasUpdate(frameTime)) {
+            if (_skewAxis >= 0 && channels.hasUpdate(_skewAxis)) {
                 hasUpdates = true;
                 hasTransformUpdate = true;
             }
-            if (_opacity && _opacity->hasUpdate(frameTime)) {
+            if (_opacity >= 0 && channels.hasUpdate(_opacity)) {
                 hasUpdates = true;
             }
             
@@ -853,37 +956,37 @@ public:
                 //TODO:optimize by storing components
                 
                 Vector3D anchorValue(0.0, 0.0, 0.0);
-                if (_anchor) {
-                    anchorValue = _anchor->value(frameTime);
+                if (_anchor >= 0) {
+                    anchorValue = channels.vector3DValue(_anchor);
                 }
                 
                 Vector3D positionValue(0.0, 0.0, 0.0);
-                if (_position) {
-                    positionValue = _position->value(frameTime);
+                if (_position >= 0) {
+                    positionValue = channels.vector3DValue(_position);
                 }
                 
                 Vector3D scaleValue(100.0, 100.0, 100.0);
-                if (_scale) {
-                    scaleValue = _scale->value(frameTime);
+                if (_scale >= 0) {
+                    scaleValue = channels.vector3DValue(_scale);
                 }
                 
                 float rotationValue = 0.0;
-                if (_rotation) {
-                    rotationValue = _rotation->value(frameTime).value;
+                if (_rotation >= 0) {
+                    rotationValue = channels.vector1DValue(_rotation);
                 }
                 
                 float skewValue = 0.0;
-                if (_skew) {
-                    skewValue = _skew->value(frameTime).value;
+                if (_skew >= 0) {
+                    skewValue = channels.vector1DValue(_skew);
                 }
                 
                 float skewAxisValue = 0.0;
-                if (_skewAxis) {
-                    skewAxisValue = _skewAxis->value(frameTime).value;
+                if (_skewAxis >= 0) {
+                    skewAxisValue = channels.vector1DValue(_skewAxis);
                 }
                 
-                if (_opacity) {
-                    _opacityValue = _opacity->value(frameTime).value * 0.01;
+                if (_opacity >= 0) {
+                    _opacityValue = channels.vector1DValue(_opacity) * 0.01;
                 } else {
                     _opacityValue = 1.0;
                 }
@@ -906,16 +1009,27 @@ public:
             return _opacityValue;
         }
         
+        bool isStatic() const {
+            for (int channel : { _anchor, _position, _scale, _rotation, _skew, _skewAxis, _opacity }) {
+                if (channel >= 0 && !channels.isConstant(channel)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    
     private:
+        KeyframeChannelBatch &channels;
+        
         bool hasValidData = false;
         
-        std::unique_ptr<KeyframeInterpolator<Vector3D>> _anchor;
-        std::unique_ptr<KeyframeInterpolator<Vector3D>> _position;
-        std::unique_ptr<KeyframeInterpolator<Vector3D>> _scale;
-        std::unique_ptr<KeyframeInterpolator<Vector1D>> _rotation;
-        std::unique_ptr<KeyframeInterpolator<Vector1D>> _skew;
-        std::unique_ptr<KeyframeInterpolator<Vector1D>> _skewAxis;
-        std::unique_ptr<KeyframeInterpolator<Vector1D>> _opacity;
+        int _anchor = -1;
+        int _position = -1;
+        int _scale = -1;
+        int _rotation = -1;
+        int _skew = -1;
+        int _skewAxis = -1;
+        int _opacity = -1;
         
         Transform2D _transformValue = Transform2D::identity();
         float _opacityValue = 1.0;
@@ -937,8 +1051,16 @@ public:
             transform = std::move(transform_);
         }
         
+        /// True if no output of this item or of its sub items is animated. Computed by `initializeRenderChildren`;
+        /// `updateFrame` does not visit a static item again once it has been updated.
+        bool isStatic() const {
+            return _isStatic;
+        }
+    
     private:
         bool _isFrameInitialized = false;
+        bool _isStatic = false;
+        bool _hasUpdatedFrame = false;
         
         std::optional<TrimParams> _effectiveTrim;
         
@@ -1016,8 +1138,8 @@ public:
             shadings.insert(shadings.begin(), shading);
         }
         
-        void setTrim(Trim const &trim_) {
-            trim = std::make_shared<TrimParamsOutput>(trim_);
+        void setTrim(Trim const &trim_, KeyframeChannelBatch &channels) {
+            trim = std::make_shared<TrimParamsOutput>(trim_, channels);
         }
         
     public:
@@ -1068,10 +1190,44 @@ public:
                     }
                 }
             }
+            
+            _isStatic = computeIsStatic();
         }
         
+    private:
+        bool computeIsStatic() const {
+            if (path && !path->isStatic()) {
+                return false;
+            }
+            if (transform && !transform->isStatic()) {
+                return false;
+            }
+            if (trim && !trim->isStatic()) {
+                return false;
+            }
+            for (const auto &shadingVariant : shadings) {
+                if (shadingVariant.fill && !shadingVariant.fill->isStatic()) {
+                    return false;
+                }
+                if (shadingVariant.stroke && !shadingVariant.stroke->isStatic()) {
+                    return false;
+                }
+            }
+            for (const auto &subItem : subItems) {
+                if (!subItem->isStatic()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    
     public:
         bool updateFrame(AnimationFrameTime frameTime, std::optional<TrimParams> parentTrim, BezierPathsBoundingBoxContext &boundingBoxContext) {
+            if (_isStatic && _hasUpdatedFrame && _effectiveTrim == parentTrim) {
+                return false;
+            }
+            _hasUpdatedFrame = true;
+            
             bool hasPathUpdates = false;
             if (_isFrameInitialized) {
                 _isFrameInitialized = true;
@@ -1161,15 +1317,14 @@ public:
     ShapeLayerPresentationTree(std::vector<std::shared_ptr<ShapeItem>> const &items) {
         itemTree = std::make_shared<ShapeLayerPresentationTree::ContentItem>();
         itemTree->isGroup = true;
-        ShapeLayerPresentationTree::renderTreeContent(items, itemTree);
+        ShapeLayerPresentationTree::renderTreeContent(items, itemTree, _channels);
     }
     
     ShapeLayerPresentationTree(std::shared_ptr<SolidLayerModel> const &solidLayer) {
         itemTree = std::make_shared<ShapeLayerPresentationTree::ContentItem>();
         itemTree->isGroup = true;
         
-        std::vector<std::shared_ptr<ShapeItem>> items;
-        items.push_back(std::make_shared<Rectangle>(
+        _solidLayerItems.push_back(std::make_shared<Rectangle>(
             std::nullopt,
             std::nullopt,
             std::nullopt,
@@ -1183,13 +1338,24 @@ public:
             KeyframeGroup<Vector3D>(Vector3D(solidLayer->width, solidLayer->height, 0.0)),
             KeyframeGroup<Vector1D>(Vector1D(0.0))
         ));
-        ShapeLayerPresentationTree::renderTreeContent(items, itemTree);
+        ShapeLayerPresentationTree::renderTreeContent(_solidLayerItems, itemTree, _channels);
     }
     
     virtual ~ShapeLayerPresentationTree() = default;
     
+    void updateFrame(AnimationFrameTime frameTime, BezierPathsBoundingBoxContext &boundingBoxContext) {
+        if (itemTree->isStatic() && _hasUpdatedFrame) {
+            /// Nothing in the layer is animated, the contents of the first frame stay valid.
+            return;
+        }
+        _hasUpdatedFrame = true;
+        
+        _channels.evaluate(frameTime);
+        itemTree->updateFrame(frameTime, std::nullopt, boundingBoxContext);
+    }
+    
 private:
-    static void renderTreeContent(std::vector<std::shared_ptr<ShapeItem>> const &items, std::shared_ptr<ContentItem> &itemTree) {
+    static void renderTreeContent(std::vector<std::shared_ptr<ShapeItem>> const &items, std::shared_ptr<ContentItem> &itemTree, KeyframeChannelBatch &channels) {
         for (const auto &item : items) {
             if (item->hidden()) {
                 continue;
@@ -1199,28 +1365,28 @@ private:
                 case ShapeType::Fill: {
                     Fill const &fill = *((Fill *)item.get());
                     
-                    itemTree->addFill(std::make_shared<SolidFillOutput>(fill));
+                    itemTree->addFill(std::make_shared<SolidFillOutput>(fill, channels));
                     
                     break;
                 }
                 case ShapeType::GradientFill: {
                     GradientFill const &gradientFill = *((GradientFill *)item.get());
                     
-                    itemTree->addFill(std::make_shared<GradientFillOutput>(gradientFill));
+                    itemTree->addFill(std::make_shared<GradientFillOutput>(gradientFill, channels));
                     
                     break;
                 }
                 case ShapeType::Stroke: {
                     Stroke const &stroke = *((Stroke *)item.get());
                     
-                    itemTree->addStroke(std::make_shared<SolidStrokeOutput>(stroke));
+                    itemTree->addStroke(std::make_shared<SolidStrokeOutput>(stroke, channels));
                     
                     break;
                 }
                 case ShapeType::GradientStroke: {
                     GradientStroke const &gradientStroke = *((GradientStroke *)item.get());
                     
-                    itemTree->addStroke(std::make_shared<GradientStrokeOutput>(gradientStroke));
+                    itemTree->addStroke(std::make_shared<GradientStrokeOutput>(gradientStroke, channels));
                     
                     break;
                 }
@@ -1230,7 +1396,7 @@ private:
                     auto groupItem = std::make_shared<ContentItem>();
                     groupItem->isGroup = true;
                     
-                    ShapeLayerPresentationTree::renderTreeContent(group.items, groupItem);
+                    ShapeLayerPresentationTree::renderTreeContent(group.items, groupItem, channels);
                     
                     itemTree->addSubItem(groupItem);
                     
@@ -1250,7 +1416,7 @@ private:
                     
                     auto groupItem = std::make_shared<ContentItem>();
                     groupItem->isGroup = true;
-                    groupItem->setTrim(trim);
+                    groupItem->setTrim(trim, channels);
                     
                     for (const auto &subItem : itemTree->subItems) {
                         groupItem->addSubItem(subItem);
@@ -1263,7 +1429,7 @@ private:
                 case ShapeType::Transform: {
                     auto transform = std::static_pointer_cast<ShapeTransform>(item);
                     
-                    itemTree->setTransform(std::make_unique<TransformOutput>(transform));
+                    itemTree->setTransform(std::make_unique<TransformOutput>(transform, channels));
                     
                     break;
                 }
@@ -1271,7 +1437,7 @@ private:
                     Ellipse const &ellipse = *((Ellipse *)item.get());
                     
                     auto shapeItem = std::make_shared<ContentItem>();
-                    shapeItem->setPath(std::make_unique<EllipsePathOutput>(ellipse));
+                    shapeItem->setPath(std::make_unique<EllipsePathOutput>(ellipse, channels));
                     itemTree->addSubItem(shapeItem);
                     
                     break;
@@ -1284,7 +1450,7 @@ private:
                     Rectangle const &rectangle = *((Rectangle *)item.get());
                     
                     auto shapeItem = std::make_shared<ContentItem>();
-                    shapeItem->setPath(std::make_unique<RectanglePathOutput>(rectangle));
+                    shapeItem->setPath(std::make_unique<RectanglePathOutput>(rectangle, channels));
                     itemTree->addSubItem(shapeItem);
                     
                     break;
@@ -1299,7 +1465,7 @@ private:
                     Star const &star = *((Star *)item.get());
                     
                     auto shapeItem = std::make_shared<ContentItem>();
-                    shapeItem->setPath(std::make_unique<StarPathOutput>(star));
+                    shapeItem->setPath(std::make_unique<StarPathOutput>(star, channels));
                     itemTree->addSubItem(shapeItem);
                     
                     break;
@@ -1319,6 +1485,15 @@ private:
     
 public:
     std::shared_ptr<ShapeLayerPresentationTree::ContentItem> itemTree;
+    
+private:
+    /// Animated scalar, vector and color values of every output in the tree, evaluated once per frame in
+    /// `updateFrame` before the outputs read them.
+    KeyframeChannelBatch _channels;
+    bool _hasUpdatedFrame = false;
+    
+    /// Items synthesized for a solid layer. Kept alive here because the outputs borrow their keyframes.
+    std::vector<std::shared_ptr<ShapeItem>> _solidLayerItems;
 };
 
 ShapeCompositionLayer::ShapeCompositionLayer(std::shared_ptr<ShapeLayerModel> const &shapeLayer) :
@@ -1334,14 +1509,14 @@ CompositionLayer(solidLayer, Vector2D::Zero()) {
 void ShapeCompositionLayer::displayContentsWithFrame(float frame, bool forceUpdates, BezierPathsBoundingBoxContext &boundingBoxContext) {
     _frameTime = frame;
     _frameTimeInitialized = true;
-    _contentTree->itemTree->updateFrame(_frameTime, std::nullopt, boundingBoxContext);
+    _contentTree->updateFrame(_frameTime, boundingBoxContext);
 }
 
 std::shared_ptr<RenderTreeNode> ShapeCompositionLayer::renderTreeNode(BezierPathsBoundingBoxContext &boundingBoxContext) {
     if (!_frameTimeInitialized) {
         _frameTime = 0.0;
         _frameTimeInitialized = true;
-        _contentTree->itemTree->updateFrame(_frameTime, std::nullopt, boundingBoxContext);
+        _contentTree->updateFrame(_frameTime, boundingBoxContext);
     }
     
     if (!_renderTreeNode) {
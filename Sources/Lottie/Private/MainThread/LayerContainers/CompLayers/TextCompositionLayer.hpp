@@ -18,7 +18,7 @@ public:
             rootNode = std::make_shared<TextAnimatorNode>(rootNode, animator);
         }
         _rootNode = rootNode;
-        _textDocument = std::make_shared<KeyframeInterpolator<TextDocument>>(textLayer->text.keyframes);
+        _textDocument = std::make_shared<KeyframeInterpolator<TextDocument>>(textLayer->text);
         
         _textProvider = textProvider;
         _fontProvider = fontProvider;
@@ -10,6 +10,7 @@
 #include "Lottie/Private/MainThread/LayerContainers/Utility/LayerTextProvider.hpp"
 #include "Lottie/Private/MainThread/LayerContainers/Utility/CompositionLayersInitializer.hpp"
 #include "Lottie/Private/MainThread/LayerContainers/Utility/LayerFontProvider.hpp"
+#include "Lottie/Private/MainThread/LayerContainers/Utility/LayerChangeTimeline.hpp"
 #include "Lottie/Public/DynamicProperties/AnyValueProvider.hpp"
 #include "Lottie/Public/DynamicProperties/AnimationKeypath.hpp"
 
@@ -31,7 +32,8 @@ public:
         std::shared_ptr<AnimationImageProvider> const &imageProvider,
         std::shared_ptr<AnimationTextProvider> const &textProvider,
         std::shared_ptr<AnimationFontProvider> const &fontProvider
-    ) {
+    ) :
+    _changeTimeline(animation.layers, animation.assetLibrary, animation.startFrame, animation.endFrame) {
         if (animation.assetLibrary) {
             _layerImageProvider = std::make_shared<LayerImageProvider>(imageProvider, animation.assetLibrary->imageAssets);
         } else {
@@ -44,13 +46,16 @@ public:
         
         setSize(Vector2D(animation.width, animation.height));
         
+        _layersState = std::make_shared<CompositionLayersState>();
+        
         auto layers = initializeCompositionLayers(
             animation.layers,
             animation.assetLibrary,
             _layerImageProvider,
             textProvider,
             fontProvider,
-            animation.framerate
+            animation.framerate,
+            _layersState
         );
         
         std::vector<std::shared_ptr<ImageCompositionLayer>> imageLayers;
@@ -62,6 +67,7 @@ public:
             std::shared_ptr<CompositionLayer> const &layer = *layerIt;
             layer->setSize(size());
             _animationLayers.push_back(layer);
+            _animationLayerTimelineIndices.push_back(_changeTimeline.layerIndex(layer->model()));
             
             if (layer->isImageCompositionLayer()) {
                 imageLayers.push_back(std::static_pointer_cast<ImageCompositionLayer>(layer));
@@ -105,6 +111,8 @@ public:
         for (const auto &layer : _animationLayers) {
             layer->displayWithFrame(newFrame, false, _boundingBoxContext);
         }
+        _displayedFrame = newFrame;
+        updateRenderTreeIfNeeded();
     }
     
     std::vector<std::shared_ptr<CompositionLayer>> const &animationLayers() const {
@@ -120,6 +128,8 @@ public:
         for (const auto &layer : _animationLayers) {
             layer->displayWithFrame(currentFrame(), true, _boundingBoxContext);
         }
+        _displayedFrame = currentFrame();
+        updateRenderTreeIfNeeded();
     }
     
     void logHierarchyKeypaths() {
@@ -183,8 +193,19 @@ public:
         _currentFrame = currentFrame;
         
         for (size_t i = 0; i < _animationLayers.size(); i++) {
+            /// Layers that the timeline reports as unchanged since the last displayed frame are left as they are.
+            if (_displayedFrame.has_value() && !_changeTimeline.layerChanges(_animationLayerTimelineIndices[i], _displayedFrame.value(), _currentFrame)) {
+                continue;
+            }
             _animationLayers[i]->displayWithFrame(_currentFrame, false, _boundingBoxContext);
         }
+        _displayedFrame = _currentFrame;
+        updateRenderTreeIfNeeded();
+    }
+    
+    /// Which layers change on which frames, see `LayerChangeTimeline`.
+    LayerChangeTimeline const &changeTimeline() const {
+        return _changeTimeline;
     }
     
     std::shared_ptr<AnimationImageProvider> imageProvider() const {
@@ -241,8 +262,42 @@ public:
         return _renderTreeNode;
     }
     
+private:
+    /// Precompositions loaded during the last display pass attached new subnodes below nodes whose
+    /// `drawContentCount` was computed when the render tree was created.
+    void updateRenderTreeIfNeeded() {
+        if (!_layersState->renderTreeChanged) {
+            return;
+        }
+        _layersState->renderTreeChanged = false;
+        
+        if (_renderTreeNode) {
+            updateDrawContentCount(_renderTreeNode);
+        }
+    }
+    
+    static int updateDrawContentCount(std::shared_ptr<RenderTreeNode> const &node) {
+        if (node->_mask) {
+            updateDrawContentCount(node->_mask);
+        }
+        if (node->_contentItem) {
+            return node->drawContentCount;
+        }
+        
+        int drawContentCount = 0;
+        for (const auto &subnode : node->_subnodes) {
+            drawContentCount += updateDrawContentCount(subnode);
+        }
+        node->drawContentCount = drawContentCount;
+        return drawContentCount;
+    }
+    
 private:
     float _currentFrame = 0.0;
+    /// The frame all layers were last displayed at, none before the first display.
+    std::optional<float> _displayedFrame;
+    
+    LayerChangeTimeline _changeTimeline;
     
     std::shared_ptr<AnimationImageProvider> _imageProvider;
     std::shared_ptr<AnimationTextProvider> _textProvider;
@@ -251,11 +306,14 @@ private:
     bool _respectAnimationFrameRate = true;
     
     std::vector<std::shared_ptr<CompositionLayer>> _animationLayers;
+    /// Index of each of `_animationLayers` in `_changeTimeline`.
+    std::vector<int> _animationLayerTimelineIndices;
     
     std::shared_ptr<LayerImageProvider> _layerImageProvider;
     std::shared_ptr<LayerTextProvider> _layerTextProvider;
     std::shared_ptr<LayerFontProvider> _layerFontProvider;
     
+    std::shared_ptr<CompositionLayersState> _layersState;
     std::shared_ptr<RenderTreeNode> _renderTreeNode;
     
     BezierPathsBoundingBoxContext _boundingBoxContext;
@@ -14,7 +14,8 @@ std::vector<std::shared_ptr<CompositionLayer>> initializeCompositionLayers(
     std::shared_ptr<LayerImageProvider> const &layerImageProvider,
     std::shared_ptr<AnimationTextProvider> const &textProvider,
     std::shared_ptr<AnimationFontProvider> const &fontProvider,
-    float frameRate
+    float frameRate,
+    std::shared_ptr<CompositionLayersState> const &state
 ) {
     std::vector<std::shared_ptr<CompositionLayer>> compositionLayers;
     std::map<int, std::shared_ptr<CompositionLayer>> layerMap;
@@ -51,7 +52,8 @@ std::vector<std::shared_ptr<CompositionLayer>> initializeCompositionLayers(
                     textProvider,
                     fontProvider,
                     assetLibrary,
-                    frameRate
+                    frameRate,
+                    state
                 );
                 compositionLayers.push_back(precompContainer);
                 if (layer->index) {
@@ -9,13 +9,21 @@
 
 namespace lottie {
 
+/// Shared by all composition layers of one animation. Precompositions build their layers on first display, after the
+/// render tree has been created, and set `renderTreeChanged` so that the owner refreshes the `drawContentCount` values.
+class CompositionLayersState {
+public:
+    bool renderTreeChanged = false;
+};
+
 std::vector<std::shared_ptr<CompositionLayer>> initializeCompositionLayers(
     std::vector<std::shared_ptr<LayerModel>> const &layers,
     std::shared_ptr<AssetLibrary> const &assetLibrary,
     std::shared_ptr<LayerImageProvider> const &layerImageProvider,
     std::shared_ptr<AnimationTextProvider> const &textProvider,
     std::shared_ptr<AnimationFontProvider> const &fontProvider,
-    float frameRate
+    float frameRate,
+    std::shared_ptr<CompositionLayersState> const &state
 );
 
 }
@@ -0,0 +1,432 @@
+#include "LayerChangeTimeline.hpp"
+
+#include "Lottie/Private/Model/Layers/PreCompLayerModel.hpp"
+#include "Lottie/Private/Model/Layers/ShapeLayerModel.hpp"
+#include "Lottie/Private/Model/Layers/TextLayerModel.hpp"
+#include "Lottie/Private/Model/Assets/PrecompAsset.hpp"
+#include "Lottie/Private/Model/Objects/Mask.hpp"
+#include "Lottie/Private/Model/ShapeItems/Group.hpp"
+#include "Lottie/Private/Model/ShapeItems/Ellipse.hpp"
+#include "Lottie/Private/Model/ShapeItems/Fill.hpp"
+#include "Lottie/Private/Model/ShapeItems/GradientFill.hpp"
+#include "Lottie/Private/Model/ShapeItems/Rectangle.hpp"
+#include "Lottie/Private/Model/ShapeItems/Star.hpp"
+#include "Lottie/Private/Model/ShapeItems/Shape.hpp"
+#include "Lottie/Private/Model/ShapeItems/Trim.hpp"
+#include "Lottie/Private/Model/ShapeItems/Stroke.hpp"
+#include "Lottie/Private/Model/ShapeItems/GradientStroke.hpp"
+#include "Lottie/Private/Model/ShapeItems/ShapeTransform.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lottie {
+
+namespace {
+
+/// A closed range of frames in which a value can change.
+struct ChangeInterval {
+    float start = 0.0;
+    float end = 0.0;
+    
+    ChangeInterval(float start_, float end_) :
+    start(start_),
+    end(end_) {
+    }
+};
+
+typedef std::map<PrecompAsset const *, std::vector<ChangeInterval>> AssetChanges;
+
+template<typename T>
+void appendKeyframeChanges(std::vector<Keyframe<T>> const &keyframes, std::vector<ChangeInterval> &result) {
+    for (size_t i = 1; i < keyframes.size(); i++) {
+        Keyframe<T> const &leading = keyframes[i - 1];
+        Keyframe<T> const &trailing = keyframes[i];
+        if (leading.isHold) {
+            /// The value only jumps to the trailing keyframe.
+            result.emplace_back(trailing.time, trailing.time);
+        } else {
+            result.emplace_back(leading.time, trailing.time);
+        }
+    }
+}
+
+template<typename T>
+void appendKeyframeChanges(KeyframeGroup<T> const &group, std::vector<ChangeInterval> &result) {
+    appendKeyframeChanges(group.keyframes, result);
+}
+
+template<typename T>
+void appendKeyframeChanges(std::optional<KeyframeGroup<T>> const &group, std::vector<ChangeInterval> &result) {
+    if (group) {
+        appendKeyframeChanges(group->keyframes, result);
+    }
+}
+
+void appendDashPatternChanges(std::optional<std::vector<DashElement>> const &dashPattern, std::vector<ChangeInterval> &result) {
+    if (dashPattern) {
+        for (const auto &element : dashPattern.value()) {
+            appendKeyframeChanges(element.value, result);
+        }
+    }
+}
+
+/// Mirrors the items that `ShapeCompositionLayer` builds outputs for.
+void appendShapeItemChanges(std::vector<std::shared_ptr<ShapeItem>> const &items, std::vector<ChangeInterval> &result) {
+    for (const auto &item : items) {
+        if (item->hidden()) {
+            continue;
+        }
+        
+        switch (item->type) {
+            case ShapeType::Fill: {
+                Fill const &fill = *((Fill *)item.get());
+                appendKeyframeChanges(fill.color, result);
+                appendKeyframeChanges(fill.opacity, result);
+                break;
+            }
+            case ShapeType::GradientFill: {
+                GradientFill const &gradientFill = *((GradientFill *)item.get());
+                appendKeyframeChanges(gradientFill.colors, result);
+                appendKeyframeChanges(gradientFill.startPoint, result);
+                appendKeyframeChanges(gradientFill.endPoint, result);
+                appendKeyframeChanges(gradientFill.opacity, result);
+                appendKeyframeChanges(gradientFill.highlightLength, result);
+                appendKeyframeChanges(gradientFill.highlightAngle, result);
+                break;
+            }
+            case ShapeType::Stroke: {
+                Stroke const &stroke = *((Stroke *)item.get());
+                appendKeyframeChanges(stroke.color, result);
+                appendKeyframeChanges(stroke.opacity, result);
+                appendKeyframeChanges(stroke.width, result);
+                appendDashPatternChanges(stroke.dashPattern, result);
+                break;
+            }
+            case ShapeType::GradientStroke: {
+                GradientStroke const &gradientStroke = *((GradientStroke *)item.get());
+                appendKeyframeChanges(gradientStroke.colors, result);
+                appendKeyframeChanges(gradientStroke.startPoint, result);
+                appendKeyframeChanges(gradientStroke.endPoint, result);
+                appendKeyframeChanges(gradientStroke.opacity, result);
+                appendKeyframeChanges(gradientStroke.width, result);
+                appendKeyframeChanges(gradientStroke.highlightLength, result);
+                appendKeyframeChanges(gradientStroke.highlightAngle, result);
+                appendDashPatternChanges(gradientStroke.dashPattern, result);
+                break;
+            }
+            case ShapeType::Group: {
+                Group const &group = *((Group *)item.get());
+                appendShapeItemChanges(group.items, result);
+                break;
+            }
+            case ShapeType::Shape: {
+                Shape const &shape = *((Shape *)item.get());
+                appendKeyframeChanges(shape.path, result);
+                break;
+            }
+            case ShapeType::Trim: {
+                Trim const &trim = *((Trim *)item.get());
+                appendKeyframeChanges(trim.start, result);
+                appendKeyframeChanges(trim.end, result);
+                appendKeyframeChanges(trim.offset, result);
+                break;
+            }
+            case ShapeType::Transform: {
+                ShapeTransform const &transform = *((ShapeTransform *)item.get());
+                appendKeyframeChanges(transform.anchor, result);
+                appendKeyframeChanges(transform.position, result);
+                appendKeyframeChanges(transform.scale, result);
+                appendKeyframeChanges(transform.rotation, result);
+                appendKeyframeChanges(transform.opacity, result);
+                appendKeyframeChanges(transform.skew, result);
+                appendKeyframeChanges(transform.skewAxis, result);
+                break;
+            }
+            case ShapeType::Ellipse: {
+                Ellipse const &ellipse = *((Ellipse *)item.get());
+                appendKeyframeChanges(ellipse.position, result);
+                appendKeyframeChanges(ellipse.size, result);
+                break;
+            }
+            case ShapeType::Rectangle: {
+                Rectangle const &rectangle = *((Rectangle *)item.get());
+                appendKeyframeChanges(rectangle.position, result);
+                appendKeyframeChanges(rectangle.size, result);
+                appendKeyframeChanges(rectangle.cornerRadius, result);
+                break;
+            }
+            case ShapeType::Star: {
+                Star const &star = *((Star *)item.get());
+                appendKeyframeChanges(star.position, result);
+                appendKeyframeChanges(star.outerRadius, result);
+                appendKeyframeChanges(star.outerRoundness, result);
+                appendKeyframeChanges(star.innerRadius, result);
+                appendKeyframeChanges(star.innerRoundness, result);
+                appendKeyframeChanges(star.rotation, result);
+                appendKeyframeChanges(star.points, result);
+                break;
+            }
+            default: {
+                /// Merge, repeater and rounded rectangle items are not rendered.
+                break;
+            }
+        }
+    }
+}
+
+void appendTransformChanges(Transform const &transform, std::vector<ChangeInterval> &result) {
+    appendKeyframeChanges(transform.anchorPoint(), result);
+    appendKeyframeChanges(transform.position(), result);
+    appendKeyframeChanges(transform.positionX(), result);
+    appendKeyframeChanges(transform.positionY(), result);
+    appendKeyframeChanges(transform.scale(), result);
+    appendKeyframeChanges(transform.rotation(), result);
+    appendKeyframeChanges(transform.opacity(), result);
+}
+
+void appendCompositionChanges(
+    std::vector<std::shared_ptr<LayerModel>> const &layers,
+    std::shared_ptr<AssetLibrary> const &assetLibrary,
+    AssetChanges &assetChanges,
+    std::vector<std::vector<ChangeInterval>> &result
+);
+
+/// The changes of the layers of a precomp asset, in the time of the asset.
+std::vector<ChangeInterval> const &precompAssetChanges(PrecompAsset const &asset, std::shared_ptr<AssetLibrary> const &assetLibrary, AssetChanges &assetChanges) {
+    auto it = assetChanges.find(&asset);
+    if (it != assetChanges.end()) {
+        return it->second;
+    }
+    /// Inserted before the layers are visited, so that an asset that references itself terminates.
+    it = assetChanges.insert(std::make_pair(&asset, std::vector<ChangeInterval>())).first;
+    
+    std::vector<std::vector<ChangeInterval>> layerChanges;
+    appendCompositionChanges(asset.layers, assetLibrary, assetChanges, layerChanges);
+    
+    std::vector<ChangeInterval> changes;
+    for (const auto &intervals : layerChanges) {
+        changes.insert(changes.end(), intervals.begin(), intervals.end());
+    }
+    it->second = std::move(changes);
+    return it->second;
+}
+
+/// Mirrors `CompositionLayer::displayWithFrame` and the `displayContentsWithFrame` overrides.
+void appendLayerChanges(
+    LayerModel &layer,
+    std::map<int, LayerModel const *> const &layersByIndex,
+    std::shared_ptr<AssetLibrary> const &assetLibrary,
+    AssetChanges &assetChanges,
+    std::vector<ChangeInterval> &result
+) {
+    std::vector<ChangeInterval> changes;
+    
+    /// The global transform depends on every parent.
+    LayerModel const *transformLayer = &layer;
+    for (size_t depth = 0; transformLayer && depth <= layersByIndex.size(); depth++) {
+        appendTransformChanges(*transformLayer->transform, changes);
+        
+        if (!transformLayer->parent) {
+            break;
+        }
+        auto parentIt = layersByIndex.find(transformLayer->parent.value());
+        transformLayer = parentIt != layersByIndex.end() ? parentIt->second : nullptr;
+    }
+    
+    if (layer.masks) {
+        for (const auto &mask : layer.masks.value()) {
+            appendKeyframeChanges(mask->opacity, changes);
+            appendKeyframeChanges(mask->shape, changes);
+            appendKeyframeChanges(mask->expansion, changes);
+        }
+    }
+    
+    if (!layer.hidden.value_or(false)) {
+        switch (layer.type) {
+            case LayerType::Shape: {
+                appendShapeItemChanges(((ShapeLayerModel &)layer).items, changes);
+                break;
+            }
+            case LayerType::Precomp: {
+                PreCompLayerModel &precompLayer = (PreCompLayerModel &)layer;
+                if (precompLayer.timeRemapping) {
+                    /// The contents can only change while the remapped time does.
+                    appendKeyframeChanges(precompLayer.timeRemapping, changes);
+                } else if (assetLibrary) {
+                    auto assetIt = assetLibrary->precompAssets.find(precompLayer.referenceID);
+                    if (assetIt != assetLibrary->precompAssets.end()) {
+                        float startTime = precompLayer.startTime;
+                        float timeStretch = precompLayer.timeStretch();
+                        for (const auto &interval : precompAssetChanges(*assetIt->second, assetLibrary, assetChanges)) {
+                            float start = startTime + interval.start * timeStretch;
+                            float end = startTime + interval.end * timeStretch;
+                            changes.emplace_back(std::min(start, end), std::max(start, end));
+                        }
+                    }
+                }
+                break;
+            }
+            case LayerType::Text: {
+                TextLayerModel &textLayer = (TextLayerModel &)layer;
+                appendKeyframeChanges(textLayer.text, changes);
+                for (const auto &animator : textLayer.animators) {
+                    appendKeyframeChanges(animator->anchor, changes);
+                    appendKeyframeChanges(animator->position, changes);
+                    appendKeyframeChanges(animator->scale, changes);
+                    appendKeyframeChanges(animator->skew, changes);
+                    appendKeyframeChanges(animator->skewAxis, changes);
+                    appendKeyframeChanges(animator->rotation, changes);
+                    appendKeyframeChanges(animator->opacity, changes);
+                    appendKeyframeChanges(animator->strokeColor, changes);
+                    appendKeyframeChanges(animator->fillColor, changes);
+                    appendKeyframeChanges(animator->strokeWidth, changes);
+                    appendKeyframeChanges(animator->tracking, changes);
+                }
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    }
+    
+    /// Nothing is displayed outside of the time range of the layer, which changes when it is entered or left.
+    for (const auto &interval : changes) {
+        float start = std::max(interval.start, layer.inFrame);
+        float end = std::min(interval.end, layer.outFrame);
+        if (start <= end) {
+            result.emplace_back(start, end);
+        }
+    }
+    result.emplace_back(layer.inFrame, layer.inFrame);
+    result.emplace_back(layer.outFrame, layer.outFrame);
+}
+
+void appendCompositionChanges(
+    std::vector<std::shared_ptr<LayerModel>> const &layers,
+    std::shared_ptr<AssetLibrary> const &assetLibrary,
+    AssetChanges &assetChanges,
+    std::vector<std::vector<ChangeInterval>> &result
+) {
+    std::map<int, LayerModel const *> layersByIndex;
+    for (const auto &layer : layers) {
+        if (layer->index) {
+            layersByIndex.insert(std::make_pair(layer->index.value(), layer.get()));
+        }
+    }
+    
+    for (const auto &layer : layers) {
+        result.emplace_back();
+        appendLayerChanges(*layer, layersByIndex, assetLibrary, assetChanges, result.back());
+    }
+}
+
+}
+
+LayerChangeTimeline::LayerChangeTimeline(
+    std::vector<std::shared_ptr<LayerModel>> const &layers,
+    std::shared_ptr<AssetLibrary> const &assetLibrary,
+    float startFrame,
+    float endFrame
+) {
+    for (size_t i = 0; i < layers.size(); i++) {
+        _layerIndices.insert(std::make_pair(layers[i].get(), (int)i));
+    }
+    
+    /// Without a bitmap every frame reports a change.
+    if (!std::isfinite(startFrame) || !std::isfinite(endFrame) || std::abs(startFrame) > kMaxFrame || std::abs(endFrame) > kMaxFrame) {
+        return;
+    }
+    int firstWholeFrame = (int)std::floor(startFrame);
+    int rowCount = (int)std::ceil(endFrame) - firstWholeFrame + 1;
+    if (rowCount <= 0 || rowCount > kMaxRowCount) {
+        return;
+    }
+    
+    AssetChanges assetChanges;
+    std::vector<std::vector<ChangeInterval>> layerChanges;
+    appendCompositionChanges(layers, assetLibrary, assetChanges, layerChanges);
+    
+    _firstFrame = firstWholeFrame;
+    _rowCount = rowCount;
+    _wordsPerRow = ((int)layers.size() + 63) / 64;
+    _layerBits.resize((size_t)_rowCount * _wordsPerRow, 0);
+    _rowChanges.resize(_rowCount, 0);
+    
+    for (size_t layerIndex = 0; layerIndex < layerChanges.size(); layerIndex++) {
+        uint64_t bit = ((uint64_t)1) << (layerIndex % 64);
+        size_t word = layerIndex / 64;
+        
+        for (const auto &interval : layerChanges[layerIndex]) {
+            /// Rows whose interval [f - 1, f] overlaps the change, clamped to the frames that have a predecessor. A
+            /// change at a time that is not a number can happen anywhere.
+            float firstFrame = (float)(_firstFrame + 1);
+            float lastFrame = (float)(_firstFrame + _rowCount - 1);
+            if (!std::isnan(interval.start) && !std::isnan(interval.end)) {
+                firstFrame = std::max(std::ceil(interval.start), firstFrame);
+                lastFrame = std::min(std::floor(interval.end) + 1.0f, lastFrame);
+            }
+            if (firstFrame > lastFrame) {
+                continue;
+            }
+            for (int frame = (int)firstFrame; frame <= (int)lastFrame; frame++) {
+                int row = frame - _firstFrame;
+                _layerBits[(size_t)row * _wordsPerRow + word] |= bit;
+                _rowChanges[row] = 1;
+            }
+        }
+    }
+}
+
+int LayerChangeTimeline::layerIndex(LayerModel const *layer) const {
+    auto it = _layerIndices.find(layer);
+    if (it == _layerIndices.end()) {
+        return -1;
+    }
+    return it->second;
+}
+
+int LayerChangeTimeline::frameRow(float frame) const {
+    if (frame != std::floor(frame)) {
+        return -1;
+    }
+    if (!(frame >= (float)_firstFrame && frame < (float)_firstFrame + (float)_rowCount)) {
+        return -1;
+    }
+    return (int)frame - _firstFrame;
+}
+
+bool LayerChangeTimeline::layerChanges(int layerIndex, float fromFrame, float toFrame) const {
+    int fromRow = frameRow(fromFrame);
+    int toRow = frameRow(toFrame);
+    if (layerIndex < 0 || fromRow < 0 || toRow < 0) {
+        return true;
+    }
+    
+    uint64_t bit = ((uint64_t)1) << (layerIndex % 64);
+    size_t word = layerIndex / 64;
+    for (int row = std::min(fromRow, toRow) + 1; row <= std::max(fromRow, toRow); row++) {
+        if (_layerBits[(size_t)row * _wordsPerRow + word] & bit) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LayerChangeTimeline::changes(float fromFrame, float toFrame) const {
+    int fromRow = frameRow(fromFrame);
+    int toRow = frameRow(toFrame);
+    if (fromRow < 0 || toRow < 0) {
+        return true;
+    }
+    
+    for (int row = std::min(fromRow, toRow) + 1; row <= std::max(fromRow, toRow); row++) {
+        if (_rowChanges[row]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,72 @@
+#ifndef LayerChangeTimeline_hpp
+#define LayerChangeTimeline_hpp
+
+#include "Lottie/Private/Model/Layers/LayerModel.hpp"
+#include "Lottie/Private/Model/Assets/AssetLibrary.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace lottie {
+
+/// Records, for every whole frame of a composition, which of its layers can change since the previous frame.
+///
+/// The timeline is computed from the model when the layers are built. A layer can change between frames `f - 1` and
+/// `f` if a span of one of its keyframe groups, of the transform of one of its parents or, for precomp layers, of a
+/// layer of the asset overlaps that interval, or if the layer enters or leaves its time range. Every span is assumed
+/// to change unless its leading keyframe is a hold, so the timeline is conservative: layers it reports as unchanged
+/// display exactly as in the previous frame, while layers it reports as changed may still look the same.
+///
+/// The bits of a frame are stored in consecutive words, one bit per layer, so that frames without changes and layers
+/// without changes are answered without visiting any interpolator. Compositions whose time range is not finite or
+/// spans more than `kMaxRowCount` frames get no bitmap and report a change on every frame.
+class LayerChangeTimeline {
+public:
+    LayerChangeTimeline(
+        std::vector<std::shared_ptr<LayerModel>> const &layers,
+        std::shared_ptr<AssetLibrary> const &assetLibrary,
+        float startFrame,
+        float endFrame
+    );
+    
+    LayerChangeTimeline(LayerChangeTimeline const &) = delete;
+    LayerChangeTimeline &operator=(LayerChangeTimeline const &) = delete;
+    
+    /// The index of `layer` in the timeline, or -1 if it is not a layer of the composition.
+    int layerIndex(LayerModel const *layer) const;
+    
+    /// Returns true if the layer at `layerIndex` can display differently at `fromFrame` and `toFrame`. Frames that are
+    /// not whole or lie outside of the composition, and layers with an index of -1, always report a change.
+    bool layerChanges(int layerIndex, float fromFrame, float toFrame) const;
+    
+    /// Returns true if any layer can display differently at `fromFrame` and `toFrame`, under the same rules as
+    /// `layerChanges`.
+    bool changes(float fromFrame, float toFrame) const;
+    
+private:
+    /// Animations longer than this many frames get no bitmap and report a change on every frame.
+    static constexpr int kMaxRowCount = 1 << 16;
+    /// Keeps every frame of the bitmap exactly representable as a float.
+    static constexpr float kMaxFrame = (float)(1 << 24);
+    
+    /// Converts `frame` into a row of the bitmap, returns -1 if the frame is not covered.
+    int frameRow(float frame) const;
+    
+private:
+    std::map<LayerModel const *, int> _layerIndices;
+    
+    int _firstFrame = 0;
+    int _rowCount = 0;
+    int _wordsPerRow = 0;
+    
+    /// Row `i` holds the changes from frame `_firstFrame + i - 1` to frame `_firstFrame + i`.
+    std::vector<uint64_t> _layerBits;
+    /// Set if any bit of the row is set.
+    std::vector<uint8_t> _rowChanges;
+};
+
+}
+
+#endif /* LayerChangeTimeline_hpp */
@@ -38,7 +38,12 @@ public:
     }
     
     void reloadImages() {
-        for (const auto &imageLayer : imageLayers()) {
+        reloadImages(imageLayers());
+    }
+    
+    /// Loads images for layers added after the initial `reloadImages()`, such as the contents of a precomposition.
+    void reloadImages(std::vector<std::shared_ptr<ImageCompositionLayer>> const &layers) {
+        for (const auto &imageLayer : layers) {
             auto it = _imageAssets.find(imageLayer->imageReferenceID());
             if (it != _imageAssets.end()) {
                 imageLayer->setImage(_imageProvider->imageForAsset(*it->second));
@@ -15,10 +15,10 @@ namespace lottie {
 class LayerTransformProperties: public KeypathSearchableNodePropertyMap {
 public:
     LayerTransformProperties(std::shared_ptr<Transform> transform) {
-        _anchor = std::make_shared<NodeProperty<Vector3D>>(std::make_shared<KeyframeInterpolator<Vector3D>>(transform->anchorPoint().keyframes));
-        _scale = std::make_shared<NodeProperty<Vector3D>>(std::make_shared<KeyframeInterpolator<Vector3D>>(transform->scale().keyframes));
-        _rotation = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(transform->rotation().keyframes));
-        _opacity = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(transform->opacity().keyframes));
+        _anchor = makeKeyframeNodeProperty(transform->anchorPoint());
+        _scale = makeKeyframeNodeProperty(transform->scale());
+        _rotation = makeKeyframeNodeProperty(transform->rotation());
+        _opacity = makeKeyframeNodeProperty(transform->opacity());
         
         std::map<std::string, std::shared_ptr<AnyNodeProperty>> propertyMap;
         _keypathProperties.insert(std::make_pair("Anchor Point", _anchor));
@@ -27,8 +27,8 @@ public:
         _keypathProperties.insert(std::make_pair("Opacity", _opacity));
         
         if (transform->positionX().has_value() && transform->positionY().has_value()) {
-            auto xPosition = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(transform->positionX()->keyframes));
-            auto yPosition = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(transform->positionY()->keyframes));
+            auto xPosition = makeKeyframeNodeProperty(*transform->positionX());
+            auto yPosition = makeKeyframeNodeProperty(*transform->positionY());
             _keypathProperties.insert(std::make_pair("X Position", xPosition));
             _keypathProperties.insert(std::make_pair("Y Position", yPosition));
             
@@ -36,7 +36,7 @@ public:
             _positionY = yPosition;
             _position = nullptr;
         } else if (transform->position().has_value()) {
-            auto position = std::make_shared<NodeProperty<Vector3D>>(std::make_shared<KeyframeInterpolator<Vector3D>>(transform->position()->keyframes));
+            auto position = makeKeyframeNodeProperty(*transform->position());
             _keypathProperties.insert(std::make_pair("Position", position));
             
             _position = position;
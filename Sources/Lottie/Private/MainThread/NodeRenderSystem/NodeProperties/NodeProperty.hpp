@@ -5,10 +5,13 @@
 #include "Lottie/Private/MainThread/NodeRenderSystem/NodeProperties/Protocols/AnyNodeProperty.hpp"
 #include "Lottie/Public/DynamicProperties/AnyValueProvider.hpp"
 #include "Lottie/Private/MainThread/NodeRenderSystem/NodeProperties/ValueContainer.hpp"
+#include "Lottie/Private/MainThread/NodeRenderSystem/NodeProperties/ValueProviders/KeyframeInterpolator.hpp"
 
 namespace lottie {
 
 /// A node property that holds a reference to a T ValueProvider and a T ValueContainer.
+///
+/// A property created from a plain value has no provider. It is updated once and then never reports a pending update.
 template<typename T>
 class NodeProperty: public AnyNodeProperty {
 public:
@@ -18,6 +21,11 @@ public:
         _typedContainer.setNeedsUpdate();
     }
     
+    explicit NodeProperty(T const &value) :
+    _typedContainer(value) {
+        _typedContainer.setNeedsUpdate();
+    }
+    
 public:
     virtual AnyValue::Type valueType() const override {
         return AnyValueType<T>::type();
@@ -28,7 +36,7 @@ public:
     }
     
     virtual bool needsUpdate(float frame) const override {
-        return _typedContainer.needsUpdate() || _valueProvider->hasUpdate(frame);
+        return _typedContainer.needsUpdate() || (_valueProvider && _valueProvider->hasUpdate(frame));
     }
     
     virtual void setProvider(std::shared_ptr<AnyValueProvider> provider) override {
@@ -40,7 +48,11 @@ public:
     }
     
     virtual void update(float frame) override {
-        _typedContainer.setValue(_valueProvider->value(frame), frame);
+        if (_valueProvider) {
+            _typedContainer.setValue(_valueProvider->value(frame), frame);
+        } else {
+            _typedContainer.markUpdated(frame);
+        }
     }
     
 private:
@@ -49,6 +61,16 @@ private:
     //std::shared_ptr<AnyValueProvider> _originalValueProvider;
 };
 
+/// Creates the node property of a keyframe group. A group with a single keyframe is folded into a constant at load
+/// time instead of being evaluated by an interpolator on every frame.
+template<typename T>
+std::shared_ptr<NodeProperty<T>> makeKeyframeNodeProperty(KeyframeGroup<T> const &keyframeGroup) {
+    if (keyframeGroup.keyframes.size() == 1) {
+        return std::make_shared<NodeProperty<T>>(keyframeGroup.keyframes[0].value);
+    }
+    return std::make_shared<NodeProperty<T>>(std::make_shared<KeyframeInterpolator<T>>(keyframeGroup));
+}
+
 }
 
 #endif /* NodeProperty_hpp */
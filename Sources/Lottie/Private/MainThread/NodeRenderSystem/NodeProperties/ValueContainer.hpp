@@ -40,6 +40,12 @@ public:
         _needsUpdate = false;
     }
     
+    /// Marks the current value as up to date for `forFrame` without changing it.
+    void markUpdated(float forFrame) {
+        _needsUpdate = false;
+        _lastUpdateFrame = forFrame;
+    }
+    
     void setValue(AnyValue value, float forFrame) {
         if (value.type() == AnyValueType<T>::type()) {
             _needsUpdate = false;
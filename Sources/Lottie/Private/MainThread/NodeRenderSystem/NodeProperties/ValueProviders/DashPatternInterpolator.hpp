@@ -9,10 +9,10 @@ namespace lottie {
 /// A value provider that produces an array of values from an array of Keyframe Interpolators
 class DashPatternInterpolator: public ValueProvider<DashPattern>, public std::enable_shared_from_this<DashPatternInterpolator> {
 public:
-    /// Initialize with an array of array of keyframes.
-    DashPatternInterpolator(std::vector<std::vector<Keyframe<Vector1D>>> const &keyframeGroups) {
+    /// Initialize with an array of keyframe groups.
+    DashPatternInterpolator(std::vector<KeyframeGroup<Vector1D> const *> const &keyframeGroups) {
         for (const auto &keyframeGroup : keyframeGroups) {
-            _keyframeInterpolators.push_back(std::make_shared<KeyframeInterpolator<Vector1D>>(keyframeGroup));
+            _keyframeInterpolators.push_back(std::make_shared<KeyframeInterpolator<Vector1D>>(*keyframeGroup));
         }
     }
     
@@ -30,6 +30,14 @@ public:
         return DashPattern(std::move(values));
     }
     
+    /// Writes the values at `frame` into `result`, reusing its storage.
+    void update(AnimationFrameTime frame, DashPattern &result) {
+        result.values.resize(_keyframeInterpolators.size());
+        for (size_t i = 0; i < _keyframeInterpolators.size(); i++) {
+            result.values[i] = _keyframeInterpolators[i]->value(frame).value;
+        }
+    }
+    
     virtual bool hasUpdate(float frame) const override {
         for (const auto &interpolator : _keyframeInterpolators) {
             if (interpolator->hasUpdate(frame)) {
@@ -39,6 +47,16 @@ public:
         return false;
     }
     
+    /// Returns true if none of the values is animated.
+    bool isConstant() const {
+        for (const auto &interpolator : _keyframeInterpolators) {
+            if (!interpolator->isConstant()) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
 private:
     std::vector<std::shared_ptr<KeyframeInterpolator<Vector1D>>> _keyframeInterpolators;
 };
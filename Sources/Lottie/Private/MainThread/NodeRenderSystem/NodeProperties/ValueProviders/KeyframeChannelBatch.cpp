@@ -0,0 +1,239 @@
+#include "KeyframeChannelBatch.hpp"
+
+#include "Lottie/Public/Keyframes/Interpolatable.hpp"
+
+#include <limits>
+
+namespace lottie {
+
+namespace {
+
+void setComponents(Vector1D const &value, float *components) {
+    components[0] = value.value;
+}
+
+void setComponents(Vector3D const &value, float *components) {
+    components[0] = value.x;
+    components[1] = value.y;
+    components[2] = value.z;
+}
+
+void setComponents(Color const &value, float *components) {
+    components[0] = value.r;
+    components[1] = value.g;
+    components[2] = value.b;
+    components[3] = value.a;
+}
+
+}
+
+KeyframeChannelBatch::KeyframeChannelBatch() {
+}
+
+int KeyframeChannelBatch::addChannel(KeyframeGroup<Vector1D> const &keyframeGroup) {
+    if (keyframeGroup.keyframes.size() == 1) {
+        return addConstantChannel(ChannelType::Vector1D, keyframeGroup.keyframes[0].value, 1);
+    }
+    _vector1DInterpolators.push_back(std::make_unique<KeyframeSpanInterpolator<Vector1D>>(keyframeGroup));
+    return addChannel(ChannelType::Vector1D, (int)_vector1DInterpolators.size() - 1, 1);
+}
+
+int KeyframeChannelBatch::addChannel(KeyframeGroup<Vector3D> const &keyframeGroup) {
+    if (keyframeGroup.keyframes.size() == 1) {
+        return addConstantChannel(ChannelType::Vector3D, keyframeGroup.keyframes[0].value, 3);
+    }
+    _vector3DInterpolators.push_back(std::make_unique<KeyframeSpanInterpolator<Vector3D>>(keyframeGroup));
+    int channel = addChannel(ChannelType::Vector3D, (int)_vector3DInterpolators.size() - 1, 3);
+    
+    if (!_vector3DInterpolators.back()->spanSpatialPaths.empty()) {
+        SpatialChannel spatialChannel;
+        spatialChannel.channel = channel;
+        _spatialIndices[channel] = (int)_spatialChannels.size();
+        _spatialChannels.push_back(spatialChannel);
+    }
+    
+    return channel;
+}
+
+int KeyframeChannelBatch::addChannel(KeyframeGroup<Color> const &keyframeGroup) {
+    if (keyframeGroup.keyframes.size() == 1) {
+        return addConstantChannel(ChannelType::Color, keyframeGroup.keyframes[0].value, 4);
+    }
+    _colorInterpolators.push_back(std::make_unique<KeyframeSpanInterpolator<Color>>(keyframeGroup));
+    return addChannel(ChannelType::Color, (int)_colorInterpolators.size() - 1, 4);
+}
+
+int KeyframeChannelBatch::addChannel(ChannelType type, int interpolatorIndex, int componentCount) {
+    int channel = (int)_types.size();
+    
+    _types.push_back(type);
+    _interpolatorIndices.push_back(interpolatorIndex);
+    _componentOffsets.push_back((int)_values.size());
+    _componentCounts.push_back(componentCount);
+    /// An empty span, so that the first evaluation goes through `updateSpan`.
+    _spanStartTimes.push_back(std::numeric_limits<float>::infinity());
+    _spanEndTimes.push_back(-std::numeric_limits<float>::infinity());
+    _spanEasings.push_back(nullptr);
+    _hasUpdate.push_back(0);
+    _spatialIndices.push_back(-1);
+    
+    _fromComponents.resize(_fromComponents.size() + componentCount, 0.0f);
+    _toComponents.resize(_toComponents.size() + componentCount, 0.0f);
+    _componentProgress.resize(_componentProgress.size() + componentCount, 0.0f);
+    _values.resize(_values.size() + componentCount, 0.0f);
+    
+    if (interpolatorIndex >= 0) {
+        _animatedChannels.push_back(channel);
+    }
+    
+    return channel;
+}
+
+template<typename T>
+int KeyframeChannelBatch::addConstantChannel(ChannelType type, T const &value, int componentCount) {
+    int channel = addChannel(type, -1, componentCount);
+    
+    /// Equal components with zero progress, so the component loop of `evaluate` reproduces the value.
+    int offset = _componentOffsets[channel];
+    setComponents(value, &_fromComponents[offset]);
+    setComponents(value, &_toComponents[offset]);
+    setComponents(value, &_values[offset]);
+    
+    _hasUpdate[channel] = 1;
+    _pendingConstantChannels.push_back(channel);
+    
+    return channel;
+}
+
+void KeyframeChannelBatch::evaluate(AnimationFrameTime frame) {
+    if (_hasEvaluated) {
+        for (int channel : _pendingConstantChannels) {
+            _hasUpdate[channel] = 0;
+        }
+        _pendingConstantChannels.clear();
+    }
+    _hasEvaluated = true;
+    
+    for (int channel : _animatedChannels) {
+        float startTime = _spanStartTimes[channel];
+        float endTime = _spanEndTimes[channel];
+        
+        if (startTime <= frame && frame < endTime) {
+            /// Still within the current span, same as `Keyframe::interpolatedProgress` for a span that is not a hold.
+            float progress = 0.0f;
+            if (startTime < frame) {
+                progress = remapFloat(frame, startTime, endTime, 0.0f, 1.0f);
+                if (CubicBezierEasing const *easing = _spanEasings[channel]) {
+                    progress = easing->value(progress);
+                }
+            }
+            
+            int offset = _componentOffsets[channel];
+            int componentCount = _componentCounts[channel];
+            for (int i = 0; i < componentCount; i++) {
+                _componentProgress[offset + i] = progress;
+            }
+            _hasUpdate[channel] = 1;
+        } else {
+            _hasUpdate[channel] = updateSpan(channel, frame) ? 1 : 0;
+        }
+    }
+    
+    /// Channels without an update keep their components and progress, so interpolating them again yields the same
+    /// value. Doing so keeps this loop free of branches.
+    size_t componentCount = _values.size();
+    float const *fromComponents = _fromComponents.data();
+    float const *toComponents = _toComponents.data();
+    float const *componentProgress = _componentProgress.data();
+    float *values = _values.data();
+    for (size_t i = 0; i < componentCount; i++) {
+        /// Same as `ValueInterpolator<float>::interpolate`.
+        values[i] = fromComponents[i] + ((toComponents[i] - fromComponents[i]) * componentProgress[i]);
+    }
+    
+    for (auto &spatialChannel : _spatialChannels) {
+        if (!spatialChannel.path) {
+            continue;
+        }
+        int offset = _componentOffsets[spatialChannel.channel];
+        if (_hasUpdate[spatialChannel.channel]) {
+            spatialChannel.point = spatialChannel.path->point(_componentProgress[offset]);
+        }
+        _values[offset] = spatialChannel.point.x;
+        _values[offset + 1] = spatialChannel.point.y;
+    }
+}
+
+bool KeyframeChannelBatch::updateSpan(int channel, AnimationFrameTime frame) {
+    int interpolatorIndex = _interpolatorIndices[channel];
+    switch (_types[channel]) {
+        case ChannelType::Vector1D: {
+            return updateSpan(channel, *_vector1DInterpolators[interpolatorIndex], frame);
+        }
+        case ChannelType::Vector3D: {
+            return updateSpan(channel, *_vector3DInterpolators[interpolatorIndex], frame);
+        }
+        case ChannelType::Color: {
+            return updateSpan(channel, *_colorInterpolators[interpolatorIndex], frame);
+        }
+    }
+    return false;
+}
+
+template<typename T>
+bool KeyframeChannelBatch::updateSpan(int channel, KeyframeSpanInterpolator<T> &interpolator, AnimationFrameTime frame) {
+    if (!interpolator.hasUpdate(frame)) {
+        return false;
+    }
+    interpolator.seek(frame);
+    
+    auto const &keyframes = interpolator.keyframes;
+    int leadingIndex = interpolator.leadingIndex();
+    int trailingIndex = interpolator.trailingIndex();
+    
+    int offset = _componentOffsets[channel];
+    int componentCount = _componentCounts[channel];
+    
+    _spanStartTimes[channel] = std::numeric_limits<float>::infinity();
+    _spanEndTimes[channel] = -std::numeric_limits<float>::infinity();
+    _spanEasings[channel] = nullptr;
+    
+    float progress = 0.0f;
+    SpatialInterpolationPath const *spatialPath = nullptr;
+    
+    if (leadingIndex >= 0 && trailingIndex >= 0) {
+        Keyframe<T> const &leading = keyframes[leadingIndex];
+        Keyframe<T> const &trailing = keyframes[trailingIndex];
+        auto const &easing = interpolator.spanEasings[leadingIndex];
+        
+        progress = leading.interpolatedProgress(trailing, frame, easing);
+        setComponents(leading.value, &_fromComponents[offset]);
+        setComponents(trailing.value, &_toComponents[offset]);
+        
+        if (!leading.isHold) {
+            _spanStartTimes[channel] = leading.time;
+            _spanEndTimes[channel] = trailing.time;
+            _spanEasings[channel] = easing ? &easing.value() : nullptr;
+        }
+        if (!interpolator.spanSpatialPaths.empty()) {
+            if (auto const &path = interpolator.spanSpatialPaths[leadingIndex]) {
+                spatialPath = &path.value();
+            }
+        }
+    } else {
+        T const &value = leadingIndex >= 0 ? keyframes[leadingIndex].value : keyframes[trailingIndex].value;
+        setComponents(value, &_fromComponents[offset]);
+        setComponents(value, &_toComponents[offset]);
+    }
+    
+    for (int i = 0; i < componentCount; i++) {
+        _componentProgress[offset + i] = progress;
+    }
+    if (_spatialIndices[channel] >= 0) {
+        _spatialChannels[_spatialIndices[channel]].path = spatialPath;
+    }
+    
+    return true;
+}
+
+}
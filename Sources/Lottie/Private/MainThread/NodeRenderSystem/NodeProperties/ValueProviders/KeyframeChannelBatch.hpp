@@ -0,0 +1,123 @@
+#ifndef KeyframeChannelBatch_hpp
+#define KeyframeChannelBatch_hpp
+
+#include "Lottie/Private/MainThread/NodeRenderSystem/NodeProperties/ValueProviders/KeyframeInterpolator.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lottie {
+
+/// Evaluates many `Vector1D`, `Vector3D` and `Color` keyframe groups together, once per frame.
+///
+/// Channels are added while the owner is built and are identified by the returned index. The state of the current
+/// span of every channel is kept in parallel arrays (structure of arrays), and the values are stored as one flat array
+/// of float components. `evaluate` first computes the progress of every channel whose frame is still within its span,
+/// which is the common case during playback; only channels that leave their span go through the keyframe search of
+/// `KeyframeSpanInterpolator`. It then interpolates all components in a single loop the compiler can vectorize.
+///
+/// `hasUpdate` and the values follow the same rules as `KeyframeInterpolator::hasUpdate` and
+/// `KeyframeInterpolator::value` for the frame passed to the last `evaluate`. Groups with a single keyframe are folded
+/// into constant channels when they are added: they have no interpolator, are skipped by `evaluate` and only report an
+/// update for the first evaluation.
+class KeyframeChannelBatch {
+public:
+    KeyframeChannelBatch();
+    
+    KeyframeChannelBatch(KeyframeChannelBatch const &) = delete;
+    KeyframeChannelBatch &operator=(KeyframeChannelBatch const &) = delete;
+    
+    /// The keyframe groups are borrowed and must outlive the batch.
+    int addChannel(KeyframeGroup<Vector1D> const &keyframeGroup);
+    int addChannel(KeyframeGroup<Vector3D> const &keyframeGroup);
+    int addChannel(KeyframeGroup<Color> const &keyframeGroup);
+    
+    void evaluate(AnimationFrameTime frame);
+    
+    bool hasUpdate(int channel) const {
+        return _hasUpdate[channel] != 0;
+    }
+    
+    /// Returns true if the value of the channel never changes.
+    bool isConstant(int channel) const {
+        return _interpolatorIndices[channel] < 0;
+    }
+    
+    float vector1DValue(int channel) const {
+        return _values[_componentOffsets[channel]];
+    }
+    
+    Vector3D vector3DValue(int channel) const {
+        float const *components = &_values[_componentOffsets[channel]];
+        return Vector3D(components[0], components[1], components[2]);
+    }
+    
+    Color colorValue(int channel) const {
+        float const *components = &_values[_componentOffsets[channel]];
+        return Color(components[0], components[1], components[2], components[3]);
+    }
+    
+private:
+    enum class ChannelType: uint8_t {
+        Vector1D,
+        Vector3D,
+        Color
+    };
+    
+    /// `interpolatorIndex` is -1 for a constant channel.
+    int addChannel(ChannelType type, int interpolatorIndex, int componentCount);
+    
+    template<typename T>
+    int addConstantChannel(ChannelType type, T const &value, int componentCount);
+    
+    /// Moves a channel whose frame left the current span, returns false if its value does not change.
+    bool updateSpan(int channel, AnimationFrameTime frame);
+    
+    template<typename T>
+    bool updateSpan(int channel, KeyframeSpanInterpolator<T> &interpolator, AnimationFrameTime frame);
+    
+private:
+    std::vector<std::unique_ptr<KeyframeSpanInterpolator<Vector1D>>> _vector1DInterpolators;
+    std::vector<std::unique_ptr<KeyframeSpanInterpolator<Vector3D>>> _vector3DInterpolators;
+    std::vector<std::unique_ptr<KeyframeSpanInterpolator<Color>>> _colorInterpolators;
+    
+    /// Channels with an interpolator, the only ones `evaluate` has to visit.
+    std::vector<int> _animatedChannels;
+    /// Constant channels that still report their update of the first evaluation.
+    std::vector<int> _pendingConstantChannels;
+    bool _hasEvaluated = false;
+    
+    // Per channel.
+    std::vector<ChannelType> _types;
+    std::vector<int> _interpolatorIndices;
+    std::vector<int> _componentOffsets;
+    std::vector<int> _componentCounts;
+    /// Bounds of the current span while it interpolates (and is not a hold), empty otherwise. Frames inside the bounds
+    /// are evaluated without consulting the interpolator.
+    std::vector<float> _spanStartTimes;
+    std::vector<float> _spanEndTimes;
+    std::vector<CubicBezierEasing const *> _spanEasings;
+    std::vector<uint8_t> _hasUpdate;
+    /// Index into `_spatialChannels`, or -1 for channels without a motion path.
+    std::vector<int> _spatialIndices;
+    
+    // Per component.
+    std::vector<float> _fromComponents;
+    std::vector<float> _toComponents;
+    std::vector<float> _componentProgress;
+    std::vector<float> _values;
+    
+    /// Position channels with a motion path in at least one span. `path` belongs to the current span, if any, and
+    /// `point` caches its position for the last evaluated progress.
+    struct SpatialChannel {
+        int channel = 0;
+        SpatialInterpolationPath const *path = nullptr;
+        Vector2D point = Vector2D(0.0, 0.0);
+    };
+    std::vector<SpatialChannel> _spatialChannels;
+};
+
+}
+
+#endif /* KeyframeChannelBatch_hpp */
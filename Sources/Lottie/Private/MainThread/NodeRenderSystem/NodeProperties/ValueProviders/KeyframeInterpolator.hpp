@@ -3,254 +3,100 @@
 
 #include "Lottie/Public/DynamicProperties/AnyValueProvider.hpp"
 
+#include <algorithm>
+#include <memory>
+
 namespace lottie {
 
-/// A value provider that produces a value at Time from a group of keyframes
+/// Returns the index of the last keyframe in [begin, end) whose time is not after `frame`, or `begin - 1` if there is
+/// none. Keyframes are sorted by time.
 template<typename T>
-class KeyframeInterpolator: public ValueProvider<T>, public std::enable_shared_from_this<KeyframeInterpolator<T>> {
+int lastKeyframeIndexAtOrBefore(std::vector<Keyframe<T>> const &keyframes, int begin, int end, float frame) {
+    auto it = std::upper_bound(keyframes.begin() + begin, keyframes.begin() + end, frame, [](float value, Keyframe<T> const &keyframe) {
+        return value < keyframe.time;
+    });
+    return (int)(it - keyframes.begin()) - 1;
+}
+
+/// Evaluates a group of keyframes at a frame. This is the engine shared by every keyframe interpolator.
+///
+/// The keyframes are borrowed and the current span is tracked by index only, so moving between spans never copies a
+/// keyframe. The span tables are shared with every other interpolator of the same keyframe group, so instantiating a
+/// precomposition again only allocates the per-instance span state. `update(frame, result)` writes into storage owned
+/// by the caller (see `InplaceValueInterpolator`), which keeps steady-state playback free of heap allocations for every
+/// value type.
+template<typename T>
+class KeyframeSpanInterpolator {
 public:
-    KeyframeInterpolator(std::vector<Keyframe<T>> const &keyframes_) :
-    keyframes(keyframes_) {
+    KeyframeSpanInterpolator(KeyframeGroup<T> const &keyframeGroup) :
+    keyframes(keyframeGroup.keyframes),
+    spanTables(keyframeGroup.spanTables()),
+    spanEasings(spanTables->spanEasings),
+    spanSpatialPaths(spanTables->spanSpatialPaths) {
         assert(!keyframes.empty());
     }
     
-    virtual ~KeyframeInterpolator() {
-    }
-    
 public:
-    std::vector<Keyframe<T>> keyframes;
+    /// Borrowed from the model, which is immutable and outlives every interpolator created from it.
+    std::vector<Keyframe<T>> const &keyframes;
+    /// Shared with the keyframe group, see `KeyframeGroup::spanTables`; keeps the two tables below alive.
+    std::shared_ptr<KeyframeSpanTables<T> const> const spanTables;
+    /// Timing curves of the spans between `keyframes`, preprocessed once instead of solved on every frame.
+    std::vector<std::optional<CubicBezierEasing>> const &spanEasings;
+    /// Motion paths of the spatial spans, sampled once; empty unless `T` is `Vector3D` with spatial tangents.
+    std::vector<std::optional<SpatialInterpolationPath>> const &spanSpatialPaths;
     
-    virtual AnyValue::Type valueType() const override {
-        return AnyValueType<T>::type();
+    /// Returns true if there is a single keyframe, whose value is used at every frame.
+    bool isConstant() const {
+        return keyframes.size() == 1;
     }
     
-    virtual T value(AnimationFrameTime frame) override {
+    /// Returns the value at `frame`.
+    T value(AnimationFrameTime frame) {
         // First set the keyframe span for the frame.
         updateSpanIndices(frame);
-        lastUpdatedFrame = frame;
-        // If only one keyframe return its value
+        _hasUpdatedFrame = true;
         
-        if (leadingKeyframe.has_value() &&
-            trailingKeyframe.has_value())
-        {
+        if (_leadingIndex >= 0 && _trailingIndex >= 0) {
             /// We have leading and trailing keyframe.
-            auto progress = leadingKeyframe->interpolatedProgress(trailingKeyframe.value(), frame);
-            return leadingKeyframe->interpolate(trailingKeyframe.value(), progress);
-        } else if (leadingKeyframe.has_value()) {
-            return leadingKeyframe->value;
-        } else if (trailingKeyframe.has_value()) {
-            return trailingKeyframe->value;
-        } else {
-            /// Satisfy the compiler.
-            return keyframes[0].value;
-        }
-    }
-    
-    /// Returns true to trigger a frame update for this interpolator.
-    ///
-    /// An interpolator will be asked if it needs to update every frame.
-    /// If the interpolator needs updating it will be asked to compute its value for
-    /// the given frame.
-    ///
-    /// Cases a keyframe should not be updated:
-    /// - If time is in span and leading keyframe is hold
-    /// - If time is after the last keyframe.
-    /// - If time is before the first keyframe
-    ///
-    /// Cases for updating a keyframe:
-    /// - If time is in the span, and is not a hold
-    /// - If time is outside of the span, and there are more keyframes
-    /// - If a value delegate is set
-    /// - If leading and trailing are both nil.
-    virtual bool hasUpdate(float frame) const override {
-        if (!lastUpdatedFrame.has_value()) {
-            return true;
-        }
-            
-        if (leadingKeyframe.has_value() &&
-            !trailingKeyframe.has_value() &&
-            leadingKeyframe->time < frame)
-        {
-            /// Frame is after bounds of keyframes
-            return false;
-        }
-        if (trailingKeyframe.has_value() &&
-            !leadingKeyframe.has_value() &&
-            frame < trailingKeyframe->time)
-        {
-            /// Frame is before bounds of keyframes
-            return false;
-        }
-        if (leadingKeyframe.has_value() &&
-            trailingKeyframe.has_value() &&
-            leadingKeyframe->isHold &&
-            leadingKeyframe->time < frame &&
-            frame < trailingKeyframe->time)
-        {
-            return false;
-        }
-        return true;
-    }
-    
-    // MARK: Fileprivate
-    
-    std::optional<float> lastUpdatedFrame;
-    
-    std::optional<int> leadingIndex;
-    std::optional<int> trailingIndex;
-    std::optional<Keyframe<T>> leadingKeyframe;
-    std::optional<Keyframe<T>> trailingKeyframe;
-    
-    /// Finds the appropriate Leading and Trailing keyframe index for the given time.
-    void updateSpanIndices(float frame) {
-        if (keyframes.empty()) {
-            leadingIndex = std::nullopt;
-            trailingIndex = std::nullopt;
-            leadingKeyframe = std::nullopt;
-            trailingKeyframe = std::nullopt;
-            return;
-        }
-        
-        // This function searches through the array to find the span of two keyframes
-        // that contain the current time.
-        //
-        // We could use Array.first(where:) but that would search through the entire array
-        // each frame.
-        // Instead we track the last used index and search either forwards or
-        // backwards from there. This reduces the iterations and complexity from
-        //
-        // O(n), where n is the length of the sequence to
-        // O(n), where n is the number of items after or before the last used index.
-        //
-        
-        if (keyframes.size() == 1) {
-            /// Only one keyframe. Set it as first and move on.
-            leadingIndex = 0;
-            trailingIndex = std::nullopt;
-            leadingKeyframe = keyframes[0];
-            trailingKeyframe = std::nullopt;
-            return;
-        }
-        
-        /// Sets the initial keyframes. This is often only needed for the first check.
-        if
-            (!leadingIndex.has_value() &&
-            !trailingIndex.has_value())
-        {
-            if (frame < keyframes[0].time) {
-                /// Time is before the first keyframe. Set it as the trailing.
-                trailingIndex = 0;
-            } else {
-                /// Time is after the first keyframe. Set the keyframe and the trailing.
-                leadingIndex = 0;
-                trailingIndex = 1;
-            }
-        }
-        
-        if
-            (trailingIndex.has_value() &&
-            keyframes[trailingIndex.value()].time <= frame)
-        {
-            /// Time is after the current span. Iterate forward.
-            auto newLeading = trailingIndex.value();
-            bool keyframeFound = false;
-            while (!keyframeFound) {
-                leadingIndex = newLeading;
-                if (newLeading + 1 >= 0 && newLeading + 1 < keyframes.size()) {
-                    trailingIndex = newLeading + 1;
-                } else {
-                    trailingIndex = std::nullopt;
-                }
-                
-                if (!trailingIndex.has_value()) {
-                    /// We have reached the end of our keyframes. Time is after the last keyframe.
-                    keyframeFound = true;
-                    continue;
-                }
-                
-                if (frame < keyframes[trailingIndex.value()].time) {
-                    /// Keyframe in current span.
-                    keyframeFound = true;
-                    continue;
-                }
-                /// Advance the array.
-                newLeading = trailingIndex.value();
-            }
-            
-        } else if
-            (leadingIndex.has_value() &&
-            frame < keyframes[leadingIndex.value()].time)
-        {
-            
-            /// Time is before the current span. Iterate backwards
-            auto newTrailing = leadingIndex.value();
-            
-            bool keyframeFound = false;
-            while (!keyframeFound) {
-                if (newTrailing - 1 >= 0 && newTrailing - 1 < keyframes.size()) {
-                    leadingIndex = newTrailing - 1;
-                } else {
-                    leadingIndex = std::nullopt;
-                }
-                trailingIndex = newTrailing;
-                
-                if (!leadingIndex.has_value()) {
-                    /// We have reached the end of our keyframes. Time is after the last keyframe.
-                    keyframeFound = true;
-                    continue;
-                }
-                if (keyframes[leadingIndex.value()].time <= frame) {
-                    /// Keyframe in current span.
-                    keyframeFound = true;
-                    continue;
+            Keyframe<T> const &leading = keyframes[_leadingIndex];
+            Keyframe<T> const &trailing = keyframes[_trailingIndex];
+            auto progress = leading.interpolatedProgress(trailing, frame, spanEasings[_leadingIndex]);
+            if constexpr (std::is_same<T, Vector3D>::value) {
+                if (const auto spatialPath = this->spatialPath()) {
+                    return ValueInterpolator<Vector3D>::interpolate(leading.value, trailing.value, progress, *spatialPath);
                 }
-                /// Step back
-                newTrailing = leadingIndex.value();
             }
-        }
-        if (const auto keyFrame = leadingIndex) {
-            leadingKeyframe = keyframes[keyFrame.value()];
-        } else {
-            leadingKeyframe = std::nullopt;
-        }
-        
-        if (const auto keyFrame = trailingIndex) {
-            trailingKeyframe = keyframes[keyFrame.value()];
+            return leading.interpolate(trailing, progress);
+        } else if (_leadingIndex >= 0) {
+            return keyframes[_leadingIndex].value;
         } else {
-            trailingKeyframe = std::nullopt;
+            return keyframes[_trailingIndex].value;
         }
     }
-};
-
-class BezierPathKeyframeInterpolator {
-public:
-    BezierPathKeyframeInterpolator(std::vector<Keyframe<BezierPath>> const &keyframes_) :
-    keyframes(keyframes_) {
-        assert(!keyframes.empty());
-    }
     
-public:
-    std::vector<Keyframe<BezierPath>> keyframes;
-    
-    void update(AnimationFrameTime frame, BezierPath &outPath) {
+    /// Writes the value at `frame` into `result`, reusing its storage.
+    void update(AnimationFrameTime frame, T &result) {
         // First set the keyframe span for the frame.
         updateSpanIndices(frame);
-        lastUpdatedFrame = frame;
-        // If only one keyframe return its value
+        _hasUpdatedFrame = true;
         
-        if (leadingKeyframe.has_value() &&
-            trailingKeyframe.has_value())
-        {
+        if (_leadingIndex >= 0 && _trailingIndex >= 0) {
             /// We have leading and trailing keyframe.
-            auto progress = leadingKeyframe->interpolatedProgress(trailingKeyframe.value(), frame);
-            interpolateInplace(leadingKeyframe.value(), trailingKeyframe.value(), progress, outPath);
-        } else if (leadingKeyframe.has_value()) {
-            setInplace(leadingKeyframe.value(), outPath);
-        } else if (trailingKeyframe.has_value()) {
-            setInplace(trailingKeyframe.value(), outPath);
+            Keyframe<T> const &leading = keyframes[_leadingIndex];
+            Keyframe<T> const &trailing = keyframes[_trailingIndex];
+            auto progress = leading.interpolatedProgress(trailing, frame, spanEasings[_leadingIndex]);
+            if constexpr (std::is_same<T, Vector3D>::value) {
+                if (const auto spatialPath = this->spatialPath()) {
+                    result = ValueInterpolator<Vector3D>::interpolate(leading.value, trailing.value, progress, *spatialPath);
+                    return;
+                }
+            }
+            leading.interpolateInplace(trailing, progress, result);
+        } else if (_leadingIndex >= 0) {
+            InplaceValueInterpolator<T>::setInplace(keyframes[_leadingIndex].value, result);
         } else {
-            /// Satisfy the compiler.
-            setInplace(keyframes[0], outPath);
+            InplaceValueInterpolator<T>::setInplace(keyframes[_trailingIndex].value, result);
         }
     }
     
@@ -271,182 +117,164 @@ public:
     /// - If a value delegate is set
     /// - If leading and trailing are both nil.
     bool hasUpdate(float frame) const {
-        if (!lastUpdatedFrame.has_value()) {
+        if (!_hasUpdatedFrame) {
             return true;
         }
-            
-        if (leadingKeyframe.has_value() &&
-            !trailingKeyframe.has_value() &&
-            leadingKeyframe->time < frame)
+        
+        if (_leadingIndex >= 0 &&
+            _trailingIndex < 0 &&
+            keyframes[_leadingIndex].time < frame)
         {
             /// Frame is after bounds of keyframes
             return false;
         }
-        if (trailingKeyframe.has_value() &&
-            !leadingKeyframe.has_value() &&
-            frame < trailingKeyframe->time)
+        if (_trailingIndex >= 0 &&
+            _leadingIndex < 0 &&
+            frame < keyframes[_trailingIndex].time)
         {
             /// Frame is before bounds of keyframes
             return false;
         }
-        if (leadingKeyframe.has_value() &&
-            trailingKeyframe.has_value() &&
-            leadingKeyframe->isHold &&
-            leadingKeyframe->time < frame &&
-            frame < trailingKeyframe->time)
+        if (_leadingIndex >= 0 &&
+            _trailingIndex >= 0 &&
+            keyframes[_leadingIndex].isHold &&
+            keyframes[_leadingIndex].time < frame &&
+            frame < keyframes[_trailingIndex].time)
         {
             return false;
         }
         return true;
     }
     
-    // MARK: Fileprivate
+    /// Moves to the span that contains `frame` without evaluating it. Used by `KeyframeChannelBatch`, which evaluates
+    /// the span itself.
+    void seek(AnimationFrameTime frame) {
+        updateSpanIndices(frame);
+        _hasUpdatedFrame = true;
+    }
     
-    std::optional<float> lastUpdatedFrame;
+    /// Index of the keyframe that starts the current span, or -1 before the first keyframe.
+    int leadingIndex() const {
+        return _leadingIndex;
+    }
     
-    std::optional<int> leadingIndex;
-    std::optional<int> trailingIndex;
-    std::optional<Keyframe<BezierPath>> leadingKeyframe;
-    std::optional<Keyframe<BezierPath>> trailingKeyframe;
+    /// Index of the keyframe that ends the current span, or -1 after the last keyframe.
+    int trailingIndex() const {
+        return _trailingIndex;
+    }
+    
+private:
+    SpatialInterpolationPath const *spatialPath() const {
+        if (spanSpatialPaths.empty()) {
+            return nullptr;
+        }
+        const auto &spatialPath = spanSpatialPaths[_leadingIndex];
+        return spatialPath ? &spatialPath.value() : nullptr;
+    }
     
     /// Finds the appropriate Leading and Trailing keyframe index for the given time.
     void updateSpanIndices(float frame) {
-        if (keyframes.empty()) {
-            leadingIndex = std::nullopt;
-            trailingIndex = std::nullopt;
-            leadingKeyframe = std::nullopt;
-            trailingKeyframe = std::nullopt;
-            return;
-        }
-        
         // This function searches through the array to find the span of two keyframes
         // that contain the current time.
         //
-        // We could use Array.first(where:) but that would search through the entire array
-        // each frame.
-        // Instead we track the last used index and search either forwards or
-        // backwards from there. This reduces the iterations and complexity from
-        //
-        // O(n), where n is the length of the sequence to
-        // O(n), where n is the number of items after or before the last used index.
+        // We track the last used index. Sequential playback only ever moves to the
+        // neighbouring span, which is checked first in O(1). Seeking further away
+        // falls back to a binary search of the keyframes after or before the last
+        // used span, so random access costs O(log n) instead of O(n).
         //
         
         if (keyframes.size() == 1) {
             /// Only one keyframe. Set it as first and move on.
-            leadingIndex = 0;
-            trailingIndex = std::nullopt;
-            leadingKeyframe = keyframes[0];
-            trailingKeyframe = std::nullopt;
+            _leadingIndex = 0;
+            _trailingIndex = -1;
             return;
         }
         
         /// Sets the initial keyframes. This is often only needed for the first check.
-        if
-            (!leadingIndex.has_value() &&
-            !trailingIndex.has_value())
-        {
+        if (_leadingIndex < 0 && _trailingIndex < 0) {
             if (frame < keyframes[0].time) {
                 /// Time is before the first keyframe. Set it as the trailing.
-                trailingIndex = 0;
+                _trailingIndex = 0;
             } else {
                 /// Time is after the first keyframe. Set the keyframe and the trailing.
-                leadingIndex = 0;
-                trailingIndex = 1;
+                _leadingIndex = 0;
+                _trailingIndex = 1;
             }
         }
         
-        if
-            (trailingIndex.has_value() &&
-            keyframes[trailingIndex.value()].time <= frame)
-        {
-            /// Time is after the current span. Iterate forward.
-            auto newLeading = trailingIndex.value();
-            bool keyframeFound = false;
-            while (!keyframeFound) {
-                leadingIndex = newLeading;
-                if (newLeading + 1 >= 0 && newLeading + 1 < keyframes.size()) {
-                    trailingIndex = newLeading + 1;
-                } else {
-                    trailingIndex = std::nullopt;
-                }
-                
-                if (!trailingIndex.has_value()) {
-                    /// We have reached the end of our keyframes. Time is after the last keyframe.
-                    keyframeFound = true;
-                    continue;
-                }
-                
-                if (frame < keyframes[trailingIndex.value()].time) {
-                    /// Keyframe in current span.
-                    keyframeFound = true;
-                    continue;
-                }
-                /// Advance the array.
-                newLeading = trailingIndex.value();
+        if (_trailingIndex >= 0 && keyframes[_trailingIndex].time <= frame) {
+            /// Time is after the current span. Step forward, or search the remaining keyframes if it is further away.
+            int newLeading = _trailingIndex;
+            if (newLeading + 1 < (int)keyframes.size() && keyframes[newLeading + 1].time <= frame) {
+                newLeading = lastKeyframeIndexAtOrBefore(keyframes, newLeading + 1, (int)keyframes.size(), frame);
             }
-            
-        } else if
-            (leadingIndex.has_value() &&
-            frame < keyframes[leadingIndex.value()].time)
-        {
-            
-            /// Time is before the current span. Iterate backwards
-            auto newTrailing = leadingIndex.value();
-            
-            bool keyframeFound = false;
-            while (!keyframeFound) {
-                if (newTrailing - 1 >= 0 && newTrailing - 1 < keyframes.size()) {
-                    leadingIndex = newTrailing - 1;
-                } else {
-                    leadingIndex = std::nullopt;
-                }
-                trailingIndex = newTrailing;
-                
-                if (!leadingIndex.has_value()) {
-                    /// We have reached the end of our keyframes. Time is after the last keyframe.
-                    keyframeFound = true;
-                    continue;
-                }
-                if (keyframes[leadingIndex.value()].time <= frame) {
-                    /// Keyframe in current span.
-                    keyframeFound = true;
-                    continue;
-                }
-                /// Step back
-                newTrailing = leadingIndex.value();
+            _leadingIndex = newLeading;
+            if (newLeading + 1 < (int)keyframes.size()) {
+                _trailingIndex = newLeading + 1;
+            } else {
+                /// Time is after the last keyframe.
+                _trailingIndex = -1;
             }
-        }
-        if (const auto keyFrame = leadingIndex) {
-            leadingKeyframe = keyframes[keyFrame.value()];
-        } else {
-            leadingKeyframe = std::nullopt;
-        }
-        
-        if (const auto keyFrame = trailingIndex) {
-            trailingKeyframe = keyframes[keyFrame.value()];
-        } else {
-            trailingKeyframe = std::nullopt;
+        } else if (_leadingIndex >= 0 && frame < keyframes[_leadingIndex].time) {
+            /// Time is before the current span. Step back, or search the preceding keyframes if it is further away.
+            int newTrailing = _leadingIndex;
+            int newLeading = newTrailing - 1;
+            if (newLeading >= 0 && frame < keyframes[newLeading].time) {
+                newLeading = lastKeyframeIndexAtOrBefore(keyframes, 0, newLeading, frame);
+                newTrailing = newLeading + 1;
+            }
+            /// Becomes -1 if time is before the first keyframe.
+            _leadingIndex = newLeading;
+            _trailingIndex = newTrailing;
         }
     }
     
 private:
-    void setInplace(Keyframe<BezierPath> const &from, BezierPath &outPath) {
-        ValueInterpolator<BezierPath>::setInplace(from.value, outPath);
+    bool _hasUpdatedFrame = false;
+    int _leadingIndex = -1;
+    int _trailingIndex = -1;
+};
+
+/// A value provider that produces a value at Time from a group of keyframes
+template<typename T>
+class KeyframeInterpolator: public ValueProvider<T>, public std::enable_shared_from_this<KeyframeInterpolator<T>> {
+public:
+    KeyframeInterpolator(KeyframeGroup<T> const &keyframeGroup) :
+    _interpolator(keyframeGroup) {
     }
     
-    void interpolateInplace(Keyframe<BezierPath> const &from, Keyframe<BezierPath> const &to, float progress, BezierPath &outPath) {
-        std::optional<Vector2D> spatialOutTangent2d;
-        if (from.spatialOutTangent) {
-            spatialOutTangent2d = Vector2D(from.spatialOutTangent->x, from.spatialOutTangent->y);
-        }
-        std::optional<Vector2D> spatialInTangent2d;
-        if (to.spatialInTangent) {
-            spatialInTangent2d = Vector2D(to.spatialInTangent->x, to.spatialInTangent->y);
-        }
-        ValueInterpolator<BezierPath>::interpolateInplace(from.value, to.value, progress, spatialOutTangent2d, spatialInTangent2d, outPath);
+    virtual ~KeyframeInterpolator() {
+    }
+    
+public:
+    virtual AnyValue::Type valueType() const override {
+        return AnyValueType<T>::type();
     }
+    
+    virtual T value(AnimationFrameTime frame) override {
+        return _interpolator.value(frame);
+    }
+    
+    /// Writes the value at `frame` into `result`; prefer this over `value` for types that own heap storage.
+    void update(AnimationFrameTime frame, T &result) {
+        _interpolator.update(frame, result);
+    }
+    
+    virtual bool hasUpdate(float frame) const override {
+        return _interpolator.hasUpdate(frame);
+    }
+    
+    bool isConstant() const {
+        return _interpolator.isConstant();
+    }
+    
+private:
+    KeyframeSpanInterpolator<T> _interpolator;
 };
 
+/// Shape paths are only ever updated in place.
+typedef KeyframeSpanInterpolator<BezierPath> BezierPathKeyframeInterpolator;
+
 }
 
 #endif /* KeyframeInterpolator_hpp */
@@ -16,16 +16,17 @@ public:
     StrokeShapeDashConfiguration(std::vector<DashElement> const &elements) {
         for (const auto &dash : elements) {
             if (dash.type == DashElementType::Offset) {
-                dashPhase = dash.value.keyframes;
+                dashPhase = &dash.value;
             } else {
-                dashPatterns.push_back(dash.value.keyframes);
+                dashPatterns.push_back(&dash.value);
             }
         }
     }
     
 public:
-    std::vector<std::vector<Keyframe<Vector1D>>> dashPatterns;
-    std::vector<Keyframe<Vector1D>> dashPhase;
+    /// Point into `elements`, which must outlive the configuration and the interpolators created from it.
+    std::vector<KeyframeGroup<Vector1D> const *> dashPatterns;
+    KeyframeGroup<Vector1D> const *dashPhase = nullptr;
 };
 
 }
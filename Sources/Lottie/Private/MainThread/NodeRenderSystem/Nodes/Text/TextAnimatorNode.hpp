@@ -16,57 +16,57 @@ public:
         _keypathName = textAnimator->name.value_or("");
         
         if (textAnimator->anchor) {
-            _anchor = std::make_shared<NodeProperty<Vector3D>>(std::make_shared<KeyframeInterpolator<Vector3D>>(textAnimator->anchor->keyframes));
+            _anchor = makeKeyframeNodeProperty(*textAnimator->anchor);
             _keypathProperties.insert(std::make_pair("Anchor", _anchor));
         }
         
         if (textAnimator->position) {
-            _position = std::make_shared<NodeProperty<Vector3D>>(std::make_shared<KeyframeInterpolator<Vector3D>>(textAnimator->position->keyframes));
+            _position = makeKeyframeNodeProperty(*textAnimator->position);
             _keypathProperties.insert(std::make_pair("Position", _position));
         }
         
         if (textAnimator->scale) {
-            _scale = std::make_shared<NodeProperty<Vector3D>>(std::make_shared<KeyframeInterpolator<Vector3D>>(textAnimator->scale->keyframes));
+            _scale = makeKeyframeNodeProperty(*textAnimator->scale);
             _keypathProperties.insert(std::make_pair("Scale", _scale));
         }
         
         if (textAnimator->skew) {
-            _skew = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(textAnimator->skew->keyframes));
+            _skew = makeKeyframeNodeProperty(*textAnimator->skew);
             _keypathProperties.insert(std::make_pair("Skew", _skew));
         }
         
         if (textAnimator->skewAxis) {
-            _skewAxis = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(textAnimator->skewAxis->keyframes));
+            _skewAxis = makeKeyframeNodeProperty(*textAnimator->skewAxis);
             _keypathProperties.insert(std::make_pair("Skew Axis", _skewAxis));
         }
         
         if (textAnimator->rotation) {
-            _rotation = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(textAnimator->rotation->keyframes));
+            _rotation = makeKeyframeNodeProperty(*textAnimator->rotation);
             _keypathProperties.insert(std::make_pair("Rotation", _rotation));
         }
         
         if (textAnimator->rotation) {
-            _opacity = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(textAnimator->opacity->keyframes));
+            _opacity = makeKeyframeNodeProperty(*textAnimator->opacity);
             _keypathProperties.insert(std::make_pair("Opacity", _opacity));
         }
         
         if (textAnimator->strokeColor) {
-            _strokeColor = std::make_shared<NodeProperty<Color>>(std::make_shared<KeyframeInterpolator<Color>>(textAnimator->strokeColor->keyframes));
+            _strokeColor = makeKeyframeNodeProperty(*textAnimator->strokeColor);
             _keypathProperties.insert(std::make_pair("Stroke Color", _strokeColor));
         }
         
         if (textAnimator->fillColor) {
-            _fillColor = std::make_shared<NodeProperty<Color>>(std::make_shared<KeyframeInterpolator<Color>>(textAnimator->fillColor->keyframes));
+            _fillColor = makeKeyframeNodeProperty(*textAnimator->fillColor);
             _keypathProperties.insert(std::make_pair("Fill Color", _fillColor));
         }
         
         if (textAnimator->strokeWidth) {
-            _strokeWidth = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(textAnimator->strokeWidth->keyframes));
+            _strokeWidth = makeKeyframeNodeProperty(*textAnimator->strokeWidth);
             _keypathProperties.insert(std::make_pair("Stroke Width", _strokeWidth));
         }
         
         if (textAnimator->tracking) {
-            _tracking = std::make_shared<NodeProperty<Vector1D>>(std::make_shared<KeyframeInterpolator<Vector1D>>(textAnimator->tracking->keyframes));
+            _tracking = makeKeyframeNodeProperty(*textAnimator->tracking);
             _keypathProperties.insert(std::make_pair("Tracking", _tracking));
         }
         
@@ -4,6 +4,8 @@
 #include "Lottie/Public/Keyframes/Interpolatable.hpp"
 #include "Lottie/Public/Keyframes/ValueInterpolators.hpp"
 
+#include <algorithm>
+
 namespace lottie {
 
 void getGradientParameters(int numberOfColors, GradientColorSet const &colors, std::vector<Color> &outColors, std::vector<float> &outLocations) {
@@ -100,4 +102,164 @@ void getGradientParameters(int numberOfColors, GradientColorSet const &colors, s
     outLocations = colorLocations;
 }
 
+GradientParametersEvaluator::GradientParametersEvaluator(int numberOfColors, std::vector<Keyframe<GradientColorSet>> const &keyframes) :
+_numberOfColors(numberOfColors) {
+    _mergeOrders.resize(keyframes.size());
+    
+    for (size_t k = 0; k < keyframes.size(); k++) {
+        GradientColorSet const &colors = keyframes[k].value;
+        MergeOrder &mergeOrder = _mergeOrders[k];
+        
+        int colorCount = 0;
+        int alphaCount = 0;
+        if (!countStops(colors, colorCount, alphaCount)) {
+            continue;
+        }
+        mergeOrder.colorCount = colorCount;
+        mergeOrder.alphaCount = alphaCount;
+        
+        int stopCount = 0;
+        float locations[maxInlineStopCount * 2];
+        for (int i = 0; i < colorCount; i++) {
+            mergeOrder.stops[stopCount] = (uint8_t)i;
+            locations[i] = colors.colors[i * 4];
+            stopCount++;
+        }
+        for (int i = 0; i < alphaCount; i++) {
+            mergeOrder.stops[stopCount] = (uint8_t)(maxInlineStopCount + i);
+            locations[stopCount] = colors.colors[_numberOfColors * 4 + i * 2];
+            stopCount++;
+        }
+        std::stable_sort(mergeOrder.stops, mergeOrder.stops + stopCount, [&](uint8_t lhs, uint8_t rhs) {
+            int lhsIndex = lhs < maxInlineStopCount ? lhs : (colorCount + lhs - maxInlineStopCount);
+            int rhsIndex = rhs < maxInlineStopCount ? rhs : (colorCount + rhs - maxInlineStopCount);
+            return locations[lhsIndex] < locations[rhsIndex];
+        });
+    }
+}
+
+bool GradientParametersEvaluator::countStops(GradientColorSet const &colors, int &colorCount, int &alphaCount) const {
+    int valueCount = (int)colors.colors.size();
+    
+    colorCount = std::max(0, std::min(_numberOfColors, valueCount / 4));
+    alphaCount = std::max(0, (valueCount - _numberOfColors * 4) / 2);
+    
+    return colorCount <= maxInlineStopCount && alphaCount <= maxInlineStopCount;
+}
+
+void GradientParametersEvaluator::evaluate(GradientColorSet const &colors, int keyframeIndex, std::vector<Color> &outColors, std::vector<float> &outLocations) const {
+    int colorCount = 0;
+    int alphaCount = 0;
+    if (!countStops(colors, colorCount, alphaCount)) {
+        getGradientParameters(_numberOfColors, colors, outColors, outLocations);
+        return;
+    }
+    
+    float const *colorValues = colors.colors.data();
+    float const *alphaValues = colorValues + _numberOfColors * 4;
+    
+    bool drawMask = false;
+    for (int i = 0; i < alphaCount; i++) {
+        if (alphaValues[i * 2 + 1] < 1.0) {
+            drawMask = true;
+            break;
+        }
+    }
+    
+    if (!drawMask || colorCount == 0) {
+        /// Clearing keeps the capacity of the previous frame.
+        outColors.clear();
+        outLocations.clear();
+        for (int i = 0; i < colorCount; i++) {
+            outColors.push_back(Color(colorValues[i * 4 + 1], colorValues[i * 4 + 2], colorValues[i * 4 + 3], 1));
+            outLocations.push_back(colorValues[i * 4]);
+        }
+        return;
+    }
+    
+    /// The union of the stop locations, plus 0 and 1.
+    float locations[maxInlineStopCount * 2 + 2];
+    int locationCount = 0;
+    
+    MergeOrder const *mergeOrder = nullptr;
+    if (keyframeIndex >= 0 && keyframeIndex < (int)_mergeOrders.size()) {
+        MergeOrder const &keyframeMergeOrder = _mergeOrders[keyframeIndex];
+        if (keyframeMergeOrder.colorCount == colorCount && keyframeMergeOrder.alphaCount == alphaCount) {
+            mergeOrder = &keyframeMergeOrder;
+        }
+    }
+    if (mergeOrder) {
+        for (int i = 0; i < colorCount + alphaCount; i++) {
+            int stop = mergeOrder->stops[i];
+            locations[locationCount++] = stop < maxInlineStopCount ? colorValues[stop * 4] : alphaValues[(stop - maxInlineStopCount) * 2];
+        }
+    } else {
+        for (int i = 0; i < colorCount; i++) {
+            locations[locationCount++] = colorValues[i * 4];
+        }
+        for (int i = 0; i < alphaCount; i++) {
+            locations[locationCount++] = alphaValues[i * 2];
+        }
+    }
+    
+    /// Only stops that crossed since the keyframe (or values without a merge order) need sorting.
+    if (!std::is_sorted(locations, locations + locationCount)) {
+        std::sort(locations, locations + locationCount);
+    }
+    locationCount = (int)(std::unique(locations, locations + locationCount) - locations);
+    
+    if (locations[0] != 0.0) {
+        std::copy_backward(locations, locations + locationCount, locations + locationCount + 1);
+        locations[0] = 0.0;
+        locationCount++;
+    }
+    if (locations[locationCount - 1] != 1.0) {
+        locations[locationCount++] = 1.0;
+    }
+    
+    outColors.clear();
+    outLocations.assign(locations, locations + locationCount);
+    
+    for (int j = 0; j < locationCount; j++) {
+        float location = locations[j];
+        
+        Color color(colorValues[1], colorValues[2], colorValues[3], 1);
+        for (int i = 0; i < colorCount - 1; i++) {
+            float fromLocation = colorValues[i * 4];
+            float toLocation = colorValues[(i + 1) * 4];
+            if (location >= fromLocation && location <= toLocation) {
+                float localLocation = 0.0;
+                if (fromLocation != toLocation) {
+                    localLocation = remapFloat(location, fromLocation, toLocation, 0.0, 1.0);
+                }
+                color = ValueInterpolator<Color>::interpolate(
+                    Color(colorValues[i * 4 + 1], colorValues[i * 4 + 2], colorValues[i * 4 + 3], 1),
+                    Color(colorValues[(i + 1) * 4 + 1], colorValues[(i + 1) * 4 + 2], colorValues[(i + 1) * 4 + 3], 1),
+                    localLocation,
+                    std::nullopt,
+                    std::nullopt
+                );
+                break;
+            }
+        }
+        
+        float alpha = 1.0;
+        for (int i = 0; i < alphaCount - 1; i++) {
+            float fromLocation = alphaValues[i * 2];
+            float toLocation = alphaValues[(i + 1) * 2];
+            if (location >= fromLocation && location <= toLocation) {
+                float localLocation = 0.0;
+                if (fromLocation != toLocation) {
+                    localLocation = remapFloat(location, fromLocation, toLocation, 0.0, 1.0);
+                }
+                alpha = ValueInterpolator<float>::interpolate(alphaValues[i * 2 + 1], alphaValues[(i + 1) * 2 + 1], localLocation, std::nullopt, std::nullopt);
+                break;
+            }
+        }
+        
+        color.a = alpha;
+        outColors.push_back(color);
+    }
+}
+
 }
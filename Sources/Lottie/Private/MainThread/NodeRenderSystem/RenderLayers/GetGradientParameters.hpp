@@ -4,11 +4,52 @@
 #include <LottieCpp/Color.h>
 #include "Lottie/Private/MainThread/NodeRenderSystem/Protocols/NodeOutput.hpp"
 #include "Lottie/Public/Primitives/GradientColorSet.hpp"
+#include "Lottie/Public/Keyframes/Keyframe.hpp"
+
+#include <cstdint>
+#include <vector>
 
 namespace lottie {
 
 void getGradientParameters(int numberOfColors, GradientColorSet const &colors, std::vector<Color> &outColors, std::vector<float> &outLocations);
 
+/// Evaluates `getGradientParameters` for the values of a gradient keyframe group without touching the heap.
+///
+/// Gradients with alpha stops are drawn at the sorted union of their color and alpha stop locations. The order in which
+/// the stops of each keyframe merge is computed once, when the evaluator is created. A value interpolated from a
+/// keyframe starts from the order of that keyframe and is only sorted again if its stops crossed in between. Stops are
+/// collected in fixed-capacity inline arrays and the results are written into the storage of the output vectors, which
+/// keeps their capacity from the previous frame. Gradients with more stops than fit inline use `getGradientParameters`.
+class GradientParametersEvaluator {
+public:
+    /// Maximum number of color stops, and of alpha stops, that are evaluated inline.
+    static constexpr int maxInlineStopCount = 16;
+    
+    /// The keyframes are only read while the evaluator is created.
+    GradientParametersEvaluator(int numberOfColors, std::vector<Keyframe<GradientColorSet>> const &keyframes);
+    
+    /// Same as `getGradientParameters(numberOfColors, colors, outColors, outLocations)`. `keyframeIndex` is the keyframe
+    /// `colors` was interpolated from, usually the leading keyframe of the current span, or -1 if there is none.
+    void evaluate(GradientColorSet const &colors, int keyframeIndex, std::vector<Color> &outColors, std::vector<float> &outLocations) const;
+    
+private:
+    /// Color and alpha stops sorted by location. Entries below `maxInlineStopCount` are color stops, the others are
+    /// alpha stops offset by `maxInlineStopCount`.
+    struct MergeOrder {
+        int colorCount = -1;
+        int alphaCount = -1;
+        uint8_t stops[maxInlineStopCount * 2];
+    };
+    
+    /// Counts the stops of `colors`, returns false if they do not fit inline.
+    bool countStops(GradientColorSet const &colors, int &colorCount, int &alphaCount) const;
+    
+private:
+    int _numberOfColors = 0;
+    /// Per keyframe, `colorCount` is -1 for keyframes whose stops do not fit inline.
+    std::vector<MergeOrder> _mergeOrders;
+};
+
 }
 
 #endif /* ShapeRenderLayer_hpp */
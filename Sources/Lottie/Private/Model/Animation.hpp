@@ -12,6 +12,7 @@
 
 #include <LottieCpp/lottiejson11.hpp>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 #include "Lottie/Private/Model/Layers/LayerModelSerialization.hpp"
 
 #include <string>
@@ -76,6 +77,119 @@ public:
     Animation& operator=(Animation&) = delete;
     
     static std::shared_ptr<Animation> fromJson(lottiejson11::Json::object const &json) noexcept(false) {
+        auto layers = parseLayerModels(getObjectArray(json, "layers"));
+        
+        std::shared_ptr<AssetLibrary> assetLibrary;
+        if (const auto assetLibraryData = getOptionalAny(json, "assets")) {
+            assetLibrary = std::make_shared<AssetLibrary>(assetLibraryData.value());
+        }
+        
+        return fromJson(json, std::move(layers), assetLibrary);
+    }
+    
+    /// Builds the animation straight from the document bytes without materializing the whole JSON tree:
+    /// layers and precomp layers are parsed one at a time and their JSON is released as soon as the model is built.
+    static std::shared_ptr<Animation> fromData(const char *data, size_t size) noexcept(false) {
+        lottiejson11::JsonReader reader(data, size);
+        return fromReader(reader);
+    }
+    
+    /// Same as `fromData`, with the reader owned by the caller so it can inspect where reading stopped on failure.
+    ///
+    /// With `tasks`, each layer and precomp layer model is built on its executor as soon as its JSON has been read,
+    /// while the rest of the document is read. The result is identical to the serial path, layers keep their document
+    /// order.
+    static std::shared_ptr<Animation> fromReader(lottiejson11::JsonReader &reader, ModelBuildTasks *tasks = nullptr) noexcept(false) {
+        std::optional<std::vector<std::shared_ptr<LayerModel>>> layers;
+        std::optional<PendingLayerModels> pendingLayers;
+        std::shared_ptr<AssetLibrary> assetLibrary;
+        lottiejson11::Json::object json = readObject(reader, [&](std::string const &key) {
+            if (key == "layers") {
+                if (tasks) {
+                    pendingLayers = parseLayerModels(reader, *tasks);
+                } else {
+                    layers = parseLayerModels(reader);
+                }
+                return true;
+            } else if (key == "assets") {
+                assetLibrary = std::make_shared<AssetLibrary>(reader, tasks);
+                return true;
+            }
+            return false;
+        });
+        if (!reader.finish()) {
+            throw LottieParsingException();
+        }
+        if (!layers && !pendingLayers) {
+            throw LottieParsingException();
+        }
+        if (tasks) {
+            tasks->wait();
+            layers = pendingLayers->collect();
+            if (assetLibrary) {
+                assetLibrary->collectPendingLayers();
+            }
+        }
+        
+        return fromJson(json, std::move(layers.value()), assetLibrary);
+    }
+    
+    /// Builds the animation from a snapshot written by `writeSnapshot`. Keyframe and path data is read in place and
+    /// copied into the models, so `data` is only read during the call.
+    static std::shared_ptr<Animation> fromSnapshot(const void *data, size_t size) noexcept(false) {
+        SnapshotReader reader(data, size);
+        
+        AnimationFrameTime startFrame = reader.readFloat();
+        AnimationFrameTime endFrame = reader.readFloat();
+        float framerate = reader.readFloat();
+        auto name = reader.readOptional<std::string>();
+        auto version = reader.readString();
+        auto tgs = reader.readOptional<int>();
+        auto type = reader.readOptionalEnum(CoordinateSpace::Type2d, CoordinateSpace::Type3d);
+        int width = reader.readInt();
+        int height = reader.readInt();
+        auto layers = readLayerModels(reader);
+        auto glyphs = reader.readOptional<std::vector<std::shared_ptr<Glyph>>>();
+        auto fonts = reader.readOptional<std::shared_ptr<FontList>>();
+        std::shared_ptr<AssetLibrary> assetLibrary;
+        if (reader.readBool()) {
+            assetLibrary = std::make_shared<AssetLibrary>(reader);
+        }
+        auto markers = reader.readOptional<std::vector<Marker>>();
+        auto fitzModifiers = reader.readOptional<std::vector<FitzModifier>>();
+        auto meta = reader.readOptional<lottiejson11::Json>();
+        auto comps = reader.readOptional<lottiejson11::Json>();
+        
+        reader.finish();
+        
+        return std::make_shared<Animation>(
+            name,
+            tgs,
+            startFrame,
+            endFrame,
+            framerate,
+            version,
+            type,
+            width,
+            height,
+            std::move(layers),
+            std::move(glyphs),
+            std::move(fonts),
+            assetLibrary,
+            std::move(markers),
+            std::move(fitzModifiers),
+            std::move(meta),
+            std::move(comps)
+        );
+    }
+    
+private:
+    /// `json` holds the top-level fields, "layers" and "assets" have already been parsed by the caller.
+    static std::shared_ptr<Animation> fromJson(
+        lottiejson11::Json::object const &json,
+        std::vector<std::shared_ptr<LayerModel>> &&layers,
+        std::shared_ptr<AssetLibrary> assetLibrary
+    ) noexcept(false) {
         auto name = getOptionalString(json, "nm");
         auto version = getString(json, "v");
         
@@ -98,22 +212,11 @@ public:
         int width = getInt(json, "w");
         int height = getInt(json, "h");
         
-        auto layerDictionaries = getObjectArray(json, "layers");
-        std::vector<std::shared_ptr<LayerModel>> layers;
-        for (size_t i = 0; i < layerDictionaries.size(); i++) {
-            try {
-                auto layer = parseLayerModel(layerDictionaries[i]);
-                layers.push_back(layer);
-            } catch(...) {
-                throw LottieParsingException();
-            }
-        }
-        
         std::optional<std::vector<std::shared_ptr<Glyph>>> glyphs;
         if (const auto glyphDictionaries = getOptionalObjectArray(json, "chars")) {
             glyphs = std::vector<std::shared_ptr<Glyph>>();
-            for (const auto &glyphDictionary : glyphDictionaries.value()) {
-                glyphs->push_back(std::make_shared<Glyph>(glyphDictionary));
+            for (const auto &glyphDictionary : *glyphDictionaries) {
+                glyphs->push_back(std::make_shared<Glyph>(glyphDictionary.object_items()));
             }
         } else {
             glyphs = std::nullopt;
@@ -121,26 +224,21 @@ public:
         
         std::optional<std::shared_ptr<FontList>> fonts;
         if (const auto fontsDictionary = getOptionalObject(json, "fonts")) {
-            fonts = std::make_shared<FontList>(fontsDictionary.value());
-        }
-        
-        std::shared_ptr<AssetLibrary> assetLibrary;
-        if (const auto assetLibraryData = getOptionalAny(json, "assets")) {
-            assetLibrary = std::make_shared<AssetLibrary>(assetLibraryData.value());
+            fonts = std::make_shared<FontList>(*fontsDictionary);
         }
         
         std::optional<std::vector<Marker>> markers;
         if (const auto markerDictionaries = getOptionalObjectArray(json, "markers")) {
             markers = std::vector<Marker>();
-            for (const auto &markerDictionary : markerDictionaries.value()) {
-                markers->push_back(Marker(markerDictionary));
+            for (const auto &markerDictionary : *markerDictionaries) {
+                markers->push_back(Marker(markerDictionary.object_items()));
             }
         }
         std::optional<std::vector<FitzModifier>> fitzModifiers;
         if (const auto fitzModifierDictionaries = getOptionalObjectArray(json, "fitz")) {
             fitzModifiers = std::vector<FitzModifier>();
-            for (const auto &fitzModifierDictionary : fitzModifierDictionaries.value()) {
-                fitzModifiers->push_back(FitzModifier(fitzModifierDictionary));
+            for (const auto &fitzModifierDictionary : *fitzModifierDictionaries) {
+                fitzModifiers->push_back(FitzModifier(fitzModifierDictionary.object_items()));
             }
         }
         
@@ -168,6 +266,7 @@ public:
         );
     }
     
+public:
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
@@ -248,6 +347,32 @@ public:
         return result;
     }
     
+    /// Appends the snapshot of the animation to `result`, see `SnapshotWriter` for the format.
+    void writeSnapshot(std::vector<uint8_t> &result) const {
+        SnapshotWriter writer(result);
+        
+        writer.write(startFrame);
+        writer.write(endFrame);
+        writer.write(framerate);
+        writer.write(name);
+        writer.write(version);
+        writer.write(tgs);
+        writer.writeEnum(type);
+        writer.write(width);
+        writer.write(height);
+        writer.write(layers);
+        writer.write(glyphs);
+        writer.write(fonts);
+        writer.writeBool(assetLibrary != nullptr);
+        if (assetLibrary) {
+            assetLibrary->writeSnapshot(writer);
+        }
+        writer.write(markers);
+        writer.write(fitzModifiers);
+        writer.write(meta);
+        writer.write(comps);
+    }
+    
 public:
     /// The start time of the composition in frameTime.
     AnimationFrameTime startFrame;
@@ -2,6 +2,7 @@
 #define Asset_hpp
 
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <string>
 #include <sstream>
@@ -15,7 +16,7 @@ public:
     }
     
     explicit Asset(lottiejson11::Json::object const &json) noexcept(false) {
-        auto idData = getAny(json, "id");
+        auto const &idData = getAny(json, "id");
         if (idData.is_string()) {
             id = idData.string_value();
         } else if (idData.is_number()) {
@@ -27,6 +28,11 @@ public:
         objectName = getOptionalString(json, "nm");
     }
     
+    explicit Asset(SnapshotReader &reader) noexcept(false) :
+    id(reader.readString()),
+    objectName(reader.readOptional<std::string>()) {
+    }
+    
     Asset(const Asset&) = delete;
     Asset& operator=(Asset&) = delete;
     
@@ -38,6 +44,12 @@ public:
         }
     }
     
+    /// Subclasses first write whether they are a precomp, `AssetLibrary` picks the subclass from it when reading.
+    virtual void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(id);
+        writer.write(objectName);
+    }
+    
 public:
     /// The ID of the asset
     std::string id;
@@ -5,6 +5,8 @@
 #include "Lottie/Private/Model/Assets/ImageAsset.hpp"
 #include "Lottie/Private/Model/Assets/PrecompAsset.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
+#include "Lottie/Private/Parsing/ModelBuildTasks.hpp"
 
 #include <map>
 
@@ -32,15 +34,66 @@ public:
                 throw LottieParsingException();
             }
             if (item.object_items().find("layers") != item.object_items().end()) {
-                auto asset = std::make_shared<PrecompAsset>(item.object_items());
-                assets.insert(std::make_pair(asset->id, asset));
-                assetList.push_back(asset);
-                precompAssets.insert(std::make_pair(asset->id, asset));
+                addPrecompAsset(std::make_shared<PrecompAsset>(item.object_items()));
             } else {
-                auto asset = std::make_shared<ImageAsset>(item.object_items());
-                assets.insert(std::make_pair(asset->id, asset));
-                assetList.push_back(asset);
-                imageAssets.insert(std::make_pair(asset->id, asset));
+                addImageAsset(std::make_shared<ImageAsset>(item.object_items()));
+            }
+        }
+    }
+    
+    /// Parses the asset array `reader` is positioned at. Precomp layers are materialized one layer at a time.
+    /// With `tasks`, precomp layers are built on its executor and only filled in by `collectPendingLayers()`.
+    explicit AssetLibrary(lottiejson11::JsonReader &reader, ModelBuildTasks *tasks = nullptr) noexcept(false) {
+        if (!reader.begin_array()) {
+            throw LottieParsingException();
+        }
+        
+        while (reader.next_element()) {
+            std::optional<std::vector<std::shared_ptr<LayerModel>>> layers;
+            std::optional<PendingLayerModels> pendingLayers;
+            auto assetData = readObject(reader, [&](std::string const &key) {
+                if (key == "layers") {
+                    if (tasks) {
+                        pendingLayers = parseLayerModels(reader, *tasks);
+                    } else {
+                        layers = parseLayerModels(reader);
+                    }
+                    return true;
+                }
+                return false;
+            });
+            
+            if (layers) {
+                addPrecompAsset(std::make_shared<PrecompAsset>(assetData, std::move(layers.value())));
+            } else if (pendingLayers) {
+                auto asset = std::make_shared<PrecompAsset>(assetData, std::vector<std::shared_ptr<LayerModel>>());
+                addPrecompAsset(asset);
+                _pendingLayers.emplace_back(asset, std::move(pendingLayers.value()));
+            } else {
+                addImageAsset(std::make_shared<ImageAsset>(assetData));
+            }
+        }
+        if (reader.failed()) {
+            throw LottieParsingException();
+        }
+    }
+    
+    /// Fills in the layers of the precomps parsed with `tasks`. Only call it once `ModelBuildTasks::wait()` has
+    /// returned.
+    void collectPendingLayers() {
+        for (auto &it : _pendingLayers) {
+            it.first->layers = it.second.collect();
+        }
+        _pendingLayers.clear();
+    }
+    
+    explicit AssetLibrary(SnapshotReader &reader) noexcept(false) {
+        size_t count = reader.readCount();
+        for (size_t i = 0; i < count; i++) {
+            if (reader.readBool()) {
+                addPrecompAsset(std::make_shared<PrecompAsset>(reader));
+            } else {
+                addImageAsset(std::make_shared<ImageAsset>(reader));
             }
         }
     }
@@ -57,6 +110,23 @@ public:
         return result;
     }
     
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(assetList);
+    }
+    
+private:
+    void addPrecompAsset(std::shared_ptr<PrecompAsset> const &asset) {
+        assets.insert(std::make_pair(asset->id, asset));
+        assetList.push_back(asset);
+        precompAssets.insert(std::make_pair(asset->id, asset));
+    }
+    
+    void addImageAsset(std::shared_ptr<ImageAsset> const &asset) {
+        assets.insert(std::make_pair(asset->id, asset));
+        assetList.push_back(asset);
+        imageAssets.insert(std::make_pair(asset->id, asset));
+    }
+    
 public:
     /// The Assets
     std::vector<std::shared_ptr<Asset>> assetList;
@@ -64,6 +134,9 @@ public:
     
     std::map<std::string, std::shared_ptr<ImageAsset>> imageAssets;
     std::map<std::string, std::shared_ptr<PrecompAsset>> precompAssets;
+    
+private:
+    std::vector<std::pair<std::shared_ptr<PrecompAsset>, PendingLayerModels>> _pendingLayers;
 };
 
 }
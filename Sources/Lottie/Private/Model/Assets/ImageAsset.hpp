@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Model/Assets/Asset.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -40,6 +41,16 @@ public:
         _t = getOptionalString(json, "t");
     }
     
+    explicit ImageAsset(SnapshotReader &reader) noexcept(false) :
+    Asset(reader),
+    name(reader.readString()),
+    directory(reader.readString()),
+    width(reader.readFloat()),
+    height(reader.readFloat()),
+    _e(reader.readOptional<int>()),
+    _t(reader.readOptional<std::string>()) {
+    }
+    
     virtual void toJson(lottiejson11::Json::object &json) const override {
         Asset::toJson(json);
         
@@ -56,6 +67,18 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        writer.writeBool(false);
+        Asset::writeSnapshot(writer);
+        
+        writer.write(name);
+        writer.write(directory);
+        writer.write(width);
+        writer.write(height);
+        writer.write(_e);
+        writer.write(_t);
+    }
+    
 public:
     /// Image name
     std::string name;
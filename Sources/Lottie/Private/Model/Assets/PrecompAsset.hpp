@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/Layers/LayerModel.hpp"
 #include "Lottie/Private/Model/Layers/LayerModelSerialization.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <vector>
 
@@ -22,20 +23,22 @@ public:
     virtual ~PrecompAsset() = default;
     
     explicit PrecompAsset(lottiejson11::Json::object const &json) noexcept(false) :
-    Asset(json) {
+    PrecompAsset(json, parseLayerModels(getObjectArray(json, "layers"))) {
+    }
+    
+    /// `json` holds the asset's own fields, its "layers" have already been parsed into `layers_`.
+    PrecompAsset(lottiejson11::Json::object const &json, std::vector<std::shared_ptr<LayerModel>> &&layers_) noexcept(false) :
+    Asset(json),
+    layers(std::move(layers_)) {
         if (const auto frameRateValue = getOptionalDouble(json, "fr")) {
             frameRate = (float)frameRateValue.value();
         }
-        
-        auto layerDictionaries = getObjectArray(json, "layers");
-        for (size_t i = 0; i < layerDictionaries.size(); i++) {
-            try {
-                auto layer = parseLayerModel(layerDictionaries[i]);
-                layers.push_back(layer);
-            } catch(...) {
-                throw LottieParsingException();
-            }
-        }
+    }
+    
+    explicit PrecompAsset(SnapshotReader &reader) noexcept(false) :
+    Asset(reader),
+    layers(readLayerModels(reader)),
+    frameRate(reader.readOptional<float>()) {
     }
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -54,6 +57,14 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        writer.writeBool(true);
+        Asset::writeSnapshot(writer);
+        
+        writer.write(layers);
+        writer.write(frameRate);
+    }
+    
 public:
     /// Layers of the precomp
     std::vector<std::shared_ptr<LayerModel>> layers;
@@ -2,4 +2,27 @@
 
 namespace lottie {
 
+KeyframeContainerType keyframeContainerType(lottiejson11::Json const &containerData) {
+    if (!containerData.is_array()) {
+        return KeyframeContainerType::Value;
+    }
+    
+    const auto &items = containerData.array_items();
+    if (items.empty()) {
+        return KeyframeContainerType::EmptyArray;
+    }
+    if (!items[0].is_object()) {
+        return KeyframeContainerType::Value;
+    }
+    
+    // Static paths are sometimes wrapped in an array ([{ "i": ..., "o": ..., "v": ... }]),
+    // while keyframe objects always carry a time.
+    const auto &firstItem = items[0].object_items();
+    if (firstItem.find("t") == firstItem.end()) {
+        return KeyframeContainerType::Value;
+    }
+    
+    return KeyframeContainerType::Keyframes;
+}
+
 }
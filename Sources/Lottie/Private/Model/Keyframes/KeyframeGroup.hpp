@@ -3,11 +3,27 @@
 
 #include "Lottie/Public/Keyframes/Keyframe.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace lottie {
 
+/// The shape of the "k" payload of a keyframe group.
+enum class KeyframeContainerType {
+    /// A raw value: a number, a numeric array or a value object.
+    Value,
+    /// An array of keyframe objects.
+    Keyframes,
+    /// An empty array, which is a value for the types that accept one and an empty keyframe array otherwise.
+    EmptyArray
+};
+
+/// Classifies the "k" payload without decoding it, so that a valid file
+/// is decoded without relying on exceptions to pick the representation.
+KeyframeContainerType keyframeContainerType(lottiejson11::Json const &containerData);
+
 /// Used for coding/decoding a group of Keyframes by type.
 ///
 /// Keyframe data is wrapped in a dictionary { "k" : KeyframeData }.
@@ -33,14 +49,23 @@ public:
         expressionIndex = getOptionalInt(json, "ix");
         _extraL = getOptionalInt(json, "l");
         
-        auto containerData = getAny(json, "k");
+        auto const &containerData = getAny(json, "k");
         
-        try {
-            LottieParsingException::Guard expectedException;
-            T keyframeData = T(containerData);
-            keyframes.push_back(Keyframe<T>(keyframeData, std::nullopt, std::nullopt));
+        auto containerType = keyframeContainerType(containerData);
+        if (containerType == KeyframeContainerType::EmptyArray) {
+            // Decoded as before keyframeContainerType existed: a value if the type accepts an
+            // empty array (vectors and colors decode it as zeros), an empty keyframe array otherwise.
+            try {
+                LottieParsingException::Guard expectedException;
+                keyframes.push_back(Keyframe<T>(T(containerData), std::nullopt, std::nullopt));
+                isSingle = true;
+            } catch(...) {
+                isSingle = false;
+            }
+        } else if (containerType == KeyframeContainerType::Value) {
+            keyframes.push_back(Keyframe<T>(T(containerData), std::nullopt, std::nullopt));
             isSingle = true;
-        } catch(...) {
+        } else {
             // Decode and array of keyframes.
             //
             // Body Movin and Lottie deal with keyframes in different ways.
@@ -54,10 +79,6 @@ public:
             // To properly decode this we must iterate through keyframes while holding
             // reference to the previous keyframe.
             
-            if (!containerData.is_array()) {
-                throw LottieParsingException();
-            }
-            
             std::optional<KeyframeData<T>> previousKeyframeData;
             for (const auto &containerItem : containerData.array_items()) {
                 // Ensure that Time and Value are present.
@@ -98,9 +119,172 @@ public:
             }
             
             isSingle = false;
+            ParsingStatistics::reportKeyframes(keyframes.size());
         }
     }
     
+    /// Keyframe times, tangents and values are read in place from the packed float arrays, see `writeSnapshot`.
+    /// `rawKeyframeData` is not part of the snapshot, `toJson` rebuilds the keyframe JSON from `keyframes` instead.
+    explicit KeyframeGroup(SnapshotReader &reader) noexcept(false) {
+        isAnimated = reader.readOptional<int>();
+        expression = reader.readOptional<lottiejson11::Json>();
+        expressionIndex = reader.readOptional<int>();
+        _extraL = reader.readOptional<int>();
+        isSingle = reader.readBool();
+        
+        size_t count = reader.readCount();
+        
+        const float *times = reader.readFloats(count);
+        
+        std::vector<uint8_t> flags(count);
+        size_t tangentFloatCount = 0;
+        for (size_t i = 0; i < count; i++) {
+            int32_t keyframeFlags = reader.readInt();
+            if (keyframeFlags < 0 || keyframeFlags > kAllSnapshotFlags) {
+                throw LottieParsingException();
+            }
+            flags[i] = (uint8_t)keyframeFlags;
+            tangentFloatCount += snapshotTangentFloatCount(flags[i]);
+        }
+        
+        if (reader.readCount() != tangentFloatCount) {
+            throw LottieParsingException();
+        }
+        const float *tangent = reader.readFloats(tangentFloatCount);
+        
+        constexpr size_t valueFloatCount = SnapshotPackedValue<T>::floatCount;
+        const float *values = nullptr;
+        if constexpr (valueFloatCount != 0) {
+            values = reader.readFloats(count * valueFloatCount);
+        }
+        
+        keyframes.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            std::optional<Vector2D> inTangent;
+            if (flags[i] & kSnapshotFlagInTangent) {
+                inTangent = Vector2D(tangent[0], tangent[1]);
+                tangent += 2;
+            }
+            std::optional<Vector2D> outTangent;
+            if (flags[i] & kSnapshotFlagOutTangent) {
+                outTangent = Vector2D(tangent[0], tangent[1]);
+                tangent += 2;
+            }
+            std::optional<Vector3D> spatialInTangent;
+            if (flags[i] & kSnapshotFlagSpatialInTangent) {
+                spatialInTangent = Vector3D(tangent[0], tangent[1], tangent[2]);
+                tangent += 3;
+            }
+            std::optional<Vector3D> spatialOutTangent;
+            if (flags[i] & kSnapshotFlagSpatialOutTangent) {
+                spatialOutTangent = Vector3D(tangent[0], tangent[1], tangent[2]);
+                tangent += 3;
+            }
+            
+            if constexpr (valueFloatCount != 0) {
+                keyframes.emplace_back(
+                    SnapshotPackedValue<T>::unpack(values + i * valueFloatCount),
+                    times[i],
+                    (flags[i] & kSnapshotFlagHold) != 0,
+                    inTangent,
+                    outTangent,
+                    spatialInTangent,
+                    spatialOutTangent
+                );
+            } else {
+                keyframes.emplace_back(
+                    reader.read<T>(),
+                    times[i],
+                    (flags[i] & kSnapshotFlagHold) != 0,
+                    inTangent,
+                    outTangent,
+                    spatialInTangent,
+                    spatialOutTangent
+                );
+            }
+        }
+    }
+    
+    /// Writes the keyframe count followed by all times, per-keyframe flags, all present tangents and, for types with a
+    /// `SnapshotPackedValue`, all values, each as a single packed array.
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(isAnimated);
+        writer.write(expression);
+        writer.write(expressionIndex);
+        writer.write(_extraL);
+        writer.writeBool(isSingle);
+        
+        writer.writeCount(keyframes.size());
+        
+        std::vector<float> times;
+        times.reserve(keyframes.size());
+        for (const auto &keyframe : keyframes) {
+            times.push_back(keyframe.time);
+        }
+        writer.writeFloats(times.data(), times.size());
+        
+        std::vector<float> tangents;
+        for (const auto &keyframe : keyframes) {
+            uint8_t keyframeFlags = 0;
+            if (keyframe.isHold) {
+                keyframeFlags |= kSnapshotFlagHold;
+            }
+            if (keyframe.inTangent) {
+                keyframeFlags |= kSnapshotFlagInTangent;
+                tangents.push_back(keyframe.inTangent->x);
+                tangents.push_back(keyframe.inTangent->y);
+            }
+            if (keyframe.outTangent) {
+                keyframeFlags |= kSnapshotFlagOutTangent;
+                tangents.push_back(keyframe.outTangent->x);
+                tangents.push_back(keyframe.outTangent->y);
+            }
+            if (keyframe.spatialInTangent) {
+                keyframeFlags |= kSnapshotFlagSpatialInTangent;
+                tangents.push_back(keyframe.spatialInTangent->x);
+                tangents.push_back(keyframe.spatialInTangent->y);
+                tangents.push_back(keyframe.spatialInTangent->z);
+            }
+            if (keyframe.spatialOutTangent) {
+                keyframeFlags |= kSnapshotFlagSpatialOutTangent;
+                tangents.push_back(keyframe.spatialOutTangent->x);
+                tangents.push_back(keyframe.spatialOutTangent->y);
+                tangents.push_back(keyframe.spatialOutTangent->z);
+            }
+            writer.writeInt(keyframeFlags);
+        }
+        writer.writeCount(tangents.size());
+        writer.writeFloats(tangents.data(), tangents.size());
+        
+        constexpr size_t valueFloatCount = SnapshotPackedValue<T>::floatCount;
+        if constexpr (valueFloatCount != 0) {
+            std::vector<float> values(keyframes.size() * valueFloatCount);
+            for (size_t i = 0; i < keyframes.size(); i++) {
+                SnapshotPackedValue<T>::pack(keyframes[i].value, values.data() + i * valueFloatCount);
+            }
+            writer.writeFloats(values.data(), values.size());
+        } else {
+            for (const auto &keyframe : keyframes) {
+                writer.write(keyframe.value);
+            }
+        }
+    }
+    
+    /// The span tables of `keyframes`, built by the first interpolator that asks for them and shared by all later ones,
+    /// across precomposition instances and renderers of the same animation. May be called from several threads, but
+    /// `keyframes` must not change afterwards.
+    std::shared_ptr<KeyframeSpanTables<T> const> spanTables() const {
+        auto result = std::atomic_load(&_spanTables);
+        if (!result) {
+            auto tables = std::make_shared<KeyframeSpanTables<T> const>(keyframes);
+            /// Another thread may have built them first, in which case `result` is set to its tables.
+            if (std::atomic_compare_exchange_strong(&_spanTables, &result, tables)) {
+                result = tables;
+            }
+        }
+        return result;
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
@@ -109,8 +293,37 @@ public:
         } else {
             lottiejson11::Json::array containerData;
             
-            for (const auto &keyframe : rawKeyframeData) {
-                containerData.push_back(keyframe.toJson());
+            if (!rawKeyframeData.empty() || keyframes.empty()) {
+                for (const auto &keyframe : rawKeyframeData) {
+                    containerData.push_back(keyframe.toJson());
+                }
+            } else {
+                // Loaded from a snapshot. The in tangent of a Lottie keyframe is stored on the previous Body Movin keyframe.
+                for (size_t i = 0; i < keyframes.size(); i++) {
+                    const auto &keyframe = keyframes[i];
+                    lottiejson11::Json::object keyframeData;
+                    keyframeData.insert(std::make_pair("s", keyframe.value.toJson()));
+                    keyframeData.insert(std::make_pair("t", keyframe.time));
+                    if (keyframe.isHold) {
+                        keyframeData.insert(std::make_pair("h", 1));
+                    }
+                    if (keyframe.outTangent) {
+                        keyframeData.insert(std::make_pair("o", keyframe.outTangent->toJson()));
+                    }
+                    if (keyframe.spatialOutTangent) {
+                        keyframeData.insert(std::make_pair("to", keyframe.spatialOutTangent->toJson()));
+                    }
+                    if (i + 1 < keyframes.size()) {
+                        const auto &nextKeyframe = keyframes[i + 1];
+                        if (nextKeyframe.inTangent) {
+                            keyframeData.insert(std::make_pair("i", nextKeyframe.inTangent->toJson()));
+                        }
+                        if (nextKeyframe.spatialInTangent) {
+                            keyframeData.insert(std::make_pair("ti", nextKeyframe.spatialInTangent->toJson()));
+                        }
+                    }
+                    containerData.push_back(keyframeData);
+                }
             }
             
             result.insert(std::make_pair("k", containerData));
@@ -132,6 +345,31 @@ public:
         return result;
     }
     
+private:
+    static constexpr uint8_t kSnapshotFlagHold = 1 << 0;
+    static constexpr uint8_t kSnapshotFlagInTangent = 1 << 1;
+    static constexpr uint8_t kSnapshotFlagOutTangent = 1 << 2;
+    static constexpr uint8_t kSnapshotFlagSpatialInTangent = 1 << 3;
+    static constexpr uint8_t kSnapshotFlagSpatialOutTangent = 1 << 4;
+    static constexpr uint8_t kAllSnapshotFlags = (1 << 5) - 1;
+    
+    static size_t snapshotTangentFloatCount(uint8_t flags) {
+        size_t result = 0;
+        if (flags & kSnapshotFlagInTangent) {
+            result += 2;
+        }
+        if (flags & kSnapshotFlagOutTangent) {
+            result += 2;
+        }
+        if (flags & kSnapshotFlagSpatialInTangent) {
+            result += 3;
+        }
+        if (flags & kSnapshotFlagSpatialOutTangent) {
+            result += 3;
+        }
+        return result;
+    }
+    
 public:
     std::vector<Keyframe<T>> keyframes;
     std::optional<int> isAnimated;
@@ -141,6 +379,9 @@ public:
     std::vector<KeyframeData<T>> rawKeyframeData;
     bool isSingle = false;
     std::optional<int> _extraL;
+    
+private:
+    mutable std::shared_ptr<KeyframeSpanTables<T> const> _spanTables;
 };
 
 }
@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Model/Layers/LayerModel.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -16,6 +17,12 @@ public:
         _sc = getOptionalString(json, "sc");
     }
     
+    explicit ImageLayerModel(SnapshotReader &reader) noexcept(false) :
+    LayerModel(reader, LayerType::Image),
+    referenceID(reader.readString()),
+    _sc(reader.readOptional<std::string>()) {
+    }
+    
     virtual ~ImageLayerModel() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -28,6 +35,13 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        LayerModel::writeSnapshot(writer);
+        
+        writer.write(referenceID);
+        writer.write(_sc);
+    }
+    
 public:
     /// The reference ID of the image.
     std::string referenceID;
@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/Objects/Mask.hpp"
 #include "Lottie/Private/Utility/Primitives/CoordinateSpace.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <string>
 #include <optional>
@@ -135,8 +136,8 @@ public:
         
         if (const auto maskDictionaries = getOptionalObjectArray(json, "masksProperties")) {
             masks = std::vector<std::shared_ptr<Mask>>();
-            for (const auto &maskDictionary : maskDictionaries.value()) {
-                masks->push_back(std::make_shared<Mask>(maskDictionary));
+            for (const auto &maskDictionary : *maskDictionaries) {
+                masks->push_back(std::make_shared<Mask>(maskDictionary.object_items()));
             }
         }
         
@@ -174,6 +175,30 @@ public:
         _extraHidden = getOptionalAny(json, "hidden");
     }
     
+    /// `type_` has already been read by `readLayerModel`, which picks the subclass from it.
+    LayerModel(SnapshotReader &reader, LayerType type_) noexcept(false) :
+    name(reader.readOptional<std::string>()),
+    index(reader.readOptional<int>()),
+    type(type_),
+    autoOrient(reader.readOptional<int>()),
+    coordinateSpace(reader.readOptionalEnum(CoordinateSpace::Type2d, CoordinateSpace::Type3d)),
+    inFrame(reader.readFloat()),
+    outFrame(reader.readFloat()),
+    startTime(reader.readFloat()),
+    transform(std::make_shared<Transform>(reader)),
+    parent(reader.readOptional<int>()),
+    blendMode(reader.readOptionalEnum(BlendMode::Normal, BlendMode::Luminosity)),
+    masks(reader.readOptional<std::vector<std::shared_ptr<Mask>>>()),
+    _timeStretch(reader.readOptional<float>()),
+    matte(reader.readOptionalEnum(MatteType::None, MatteType::Unknown)),
+    hidden(reader.readOptional<bool>()),
+    hasMask(reader.readOptional<bool>()),
+    td(reader.readOptional<int>()),
+    effectsData(reader.readOptional<lottiejson11::Json>()),
+    layerClass(reader.readOptional<std::string>()),
+    _extraHidden(reader.readOptional<lottiejson11::Json>()) {
+    }
+    
     LayerModel(const LayerModel&) = delete;
     LayerModel& operator=(LayerModel&) = delete;
     
@@ -255,6 +280,30 @@ public:
         }
     }
     
+    /// Writes the layer type first, followed by the fields in declaration order.
+    virtual void writeSnapshot(SnapshotWriter &writer) const {
+        writer.writeEnum(type);
+        writer.write(name);
+        writer.write(index);
+        writer.write(autoOrient);
+        writer.writeEnum(coordinateSpace);
+        writer.write(inFrame);
+        writer.write(outFrame);
+        writer.write(startTime);
+        writer.write(transform);
+        writer.write(parent);
+        writer.writeEnum(blendMode);
+        writer.write(masks);
+        writer.write(_timeStretch);
+        writer.writeEnum(matte);
+        writer.write(hidden);
+        writer.write(hasMask);
+        writer.write(td);
+        writer.write(effectsData);
+        writer.write(layerClass);
+        writer.write(_extraHidden);
+    }
+    
     float timeStretch() {
         if (_timeStretch.has_value()) {
             return _timeStretch.value();
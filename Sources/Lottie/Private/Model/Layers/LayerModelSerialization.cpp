@@ -10,6 +10,7 @@ namespace lottie {
 
 std::shared_ptr<LayerModel> parseLayerModel(lottiejson11::Json::object const &json) noexcept(false) {
     LayerType layerType = parseLayerType(json, "ty");
+    ParsingStatistics::reportLayer();
     
     switch (layerType) {
         case LayerType::Precomp:
@@ -31,4 +32,111 @@ std::shared_ptr<LayerModel> parseLayerModel(lottiejson11::Json::object const &js
     }
 }
 
+std::vector<std::shared_ptr<LayerModel>> parseLayerModels(lottiejson11::Json::array const &json) noexcept(false) {
+    std::vector<std::shared_ptr<LayerModel>> layers;
+    layers.reserve(json.size());
+    for (const auto &layerData : json) {
+        try {
+            layers.push_back(parseLayerModel(layerData.object_items()));
+        } catch(...) {
+            throw LottieParsingException();
+        }
+    }
+    return layers;
+}
+
+std::vector<std::shared_ptr<LayerModel>> parseLayerModels(lottiejson11::JsonReader &reader) noexcept(false) {
+    if (!reader.begin_array()) {
+        throw LottieParsingException();
+    }
+    
+    std::vector<std::shared_ptr<LayerModel>> layers;
+    while (reader.next_element()) {
+        auto layerData = readValue(reader);
+        if (!layerData.is_object()) {
+            throw LottieParsingException();
+        }
+        try {
+            layers.push_back(parseLayerModel(layerData.object_items()));
+        } catch(...) {
+            throw LottieParsingException();
+        }
+    }
+    if (reader.failed()) {
+        throw LottieParsingException();
+    }
+    
+    return layers;
+}
+
+void PendingLayerModels::add(ModelBuildTasks &tasks, lottiejson11::Json &&layerData) {
+    auto result = std::make_shared<std::shared_ptr<LayerModel>>();
+    _results.push_back(result);
+    
+    auto sharedLayerData = std::make_shared<lottiejson11::Json>(std::move(layerData));
+    tasks.add([result, sharedLayerData]() {
+        *result = parseLayerModel(sharedLayerData->object_items());
+    });
+}
+
+std::vector<std::shared_ptr<LayerModel>> PendingLayerModels::collect() const {
+    std::vector<std::shared_ptr<LayerModel>> layers;
+    layers.reserve(_results.size());
+    for (const auto &result : _results) {
+        layers.push_back(*result);
+    }
+    return layers;
+}
+
+PendingLayerModels parseLayerModels(lottiejson11::JsonReader &reader, ModelBuildTasks &tasks) noexcept(false) {
+    if (!reader.begin_array()) {
+        throw LottieParsingException();
+    }
+    
+    PendingLayerModels layers;
+    while (reader.next_element()) {
+        auto layerData = readValue(reader);
+        if (!layerData.is_object()) {
+            throw LottieParsingException();
+        }
+        layers.add(tasks, std::move(layerData));
+    }
+    if (reader.failed()) {
+        throw LottieParsingException();
+    }
+    
+    return layers;
+}
+
+std::vector<std::shared_ptr<LayerModel>> readLayerModels(SnapshotReader &reader) noexcept(false) {
+    size_t count = reader.readCount();
+    
+    std::vector<std::shared_ptr<LayerModel>> layers;
+    layers.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        LayerType layerType = reader.readEnum(LayerType::Precomp, LayerType::Text);
+        switch (layerType) {
+            case LayerType::Precomp:
+                layers.push_back(std::make_shared<PreCompLayerModel>(reader));
+                break;
+            case LayerType::Solid:
+                layers.push_back(std::make_shared<SolidLayerModel>(reader));
+                break;
+            case LayerType::Image:
+                layers.push_back(std::make_shared<ImageLayerModel>(reader));
+                break;
+            case LayerType::Null:
+                layers.push_back(std::make_shared<LayerModel>(reader, LayerType::Null));
+                break;
+            case LayerType::Shape:
+                layers.push_back(std::make_shared<ShapeLayerModel>(reader));
+                break;
+            case LayerType::Text:
+                layers.push_back(std::make_shared<TextLayerModel>(reader));
+                break;
+        }
+    }
+    return layers;
+}
+
 }
@@ -3,12 +3,40 @@
 
 #include <LottieCpp/lottiejson11.hpp>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelBuildTasks.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 #include "Lottie/Private/Model/Layers/LayerModel.hpp"
 
 namespace lottie {
 
 std::shared_ptr<LayerModel> parseLayerModel(lottiejson11::Json::object const &json) noexcept(false);
 
+std::vector<std::shared_ptr<LayerModel>> parseLayerModels(lottiejson11::Json::array const &json) noexcept(false);
+
+/// Parses the layer array `reader` is positioned at, materializing the JSON of one layer at a time.
+std::vector<std::shared_ptr<LayerModel>> parseLayerModels(lottiejson11::JsonReader &reader) noexcept(false);
+
+/// The layers of one layer array whose models are being built by `ModelBuildTasks`.
+class PendingLayerModels {
+public:
+    /// Submits a task that builds the model of `layerData`.
+    void add(ModelBuildTasks &tasks, lottiejson11::Json &&layerData);
+    
+    /// Returns the layers in document order. Only call it once `ModelBuildTasks::wait()` has returned.
+    std::vector<std::shared_ptr<LayerModel>> collect() const;
+    
+private:
+    /// Each task only writes its own result, which it shares with this list.
+    std::vector<std::shared_ptr<std::shared_ptr<LayerModel>>> _results;
+};
+
+/// Parses the layer array `reader` is positioned at like `parseLayerModels`, submitting the task that builds the
+/// model of each layer as soon as its JSON has been read.
+PendingLayerModels parseLayerModels(lottiejson11::JsonReader &reader, ModelBuildTasks &tasks) noexcept(false);
+
+/// Reads a layer array written with `SnapshotWriter::write`, each layer starting with its type.
+std::vector<std::shared_ptr<LayerModel>> readLayerModels(SnapshotReader &reader) noexcept(false);
+
 }
 
 #endif /* LayerModelSerialization_hpp */
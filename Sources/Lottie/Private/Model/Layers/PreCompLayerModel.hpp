@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include <LottieCpp/Vectors.h>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <optional>
 
@@ -17,12 +18,20 @@ public:
     LayerModel(json) {
         referenceID = getString(json, "refId");
         if (const auto timeRemappingData = getOptionalObject(json, "tm")) {
-            timeRemapping = KeyframeGroup<Vector1D>(timeRemappingData.value());
+            timeRemapping = KeyframeGroup<Vector1D>(*timeRemappingData);
         }
         width = (float)getDouble(json, "w");
         height = (float)getDouble(json, "h");
     }
     
+    explicit PreCompLayerModel(SnapshotReader &reader) noexcept(false) :
+    LayerModel(reader, LayerType::Precomp),
+    referenceID(reader.readString()),
+    timeRemapping(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    width(reader.readFloat()),
+    height(reader.readFloat()) {
+    }
+    
     virtual ~PreCompLayerModel() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -38,6 +47,15 @@ public:
         json.insert(std::make_pair("h", height));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        LayerModel::writeSnapshot(writer);
+        
+        writer.write(referenceID);
+        writer.write(timeRemapping);
+        writer.write(width);
+        writer.write(height);
+    }
+    
 public:
     /// The reference ID of the precomp.
     std::string referenceID;
@@ -4,6 +4,7 @@
 #include "Lottie/Private/Model/Layers/LayerModel.hpp"
 #include "Lottie/Private/Model/ShapeItems/ShapeItem.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <vector>
 
@@ -14,12 +15,17 @@ class ShapeLayerModel: public LayerModel {
 public:
     ShapeLayerModel(lottiejson11::Json::object const &json) noexcept(false) :
     LayerModel(json) {
-        auto shapeItemsData = getObjectArray(json, "shapes");
+        auto const &shapeItemsData = getObjectArray(json, "shapes");
         for (const auto &shapeItemData : shapeItemsData) {
-            items.push_back(parseShapeItem(shapeItemData));
+            items.push_back(parseShapeItem(shapeItemData.object_items()));
         }
     }
     
+    explicit ShapeLayerModel(SnapshotReader &reader) noexcept(false) :
+    LayerModel(reader, LayerType::Shape),
+    items(readShapeItems(reader)) {
+    }
+    
     virtual ~ShapeLayerModel() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -35,6 +41,12 @@ public:
         json.insert(std::make_pair("shapes", shapeItemArray));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        LayerModel::writeSnapshot(writer);
+        
+        writer.write(items);
+    }
+    
 public:
     /// A list of shape items.
     std::vector<std::shared_ptr<ShapeItem>> items;
@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Model/Layers/LayerModel.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -16,6 +17,13 @@ public:
         height = (float)getDouble(json, "sh");
     }
     
+    explicit SolidLayerModel(SnapshotReader &reader) noexcept(false) :
+    LayerModel(reader, LayerType::Solid),
+    colorHex(reader.readString()),
+    width(reader.readFloat()),
+    height(reader.readFloat()) {
+    }
+    
     virtual ~SolidLayerModel() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -26,6 +34,14 @@ public:
         json.insert(std::make_pair("sh", height));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        LayerModel::writeSnapshot(writer);
+        
+        writer.write(colorHex);
+        writer.write(width);
+        writer.write(height);
+    }
+    
 public:
     /// The color of the solid in Hex // Change to value provider.
     std::string colorHex;
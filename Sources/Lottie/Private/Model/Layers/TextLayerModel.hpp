@@ -6,6 +6,7 @@
 #include "Lottie/Private/Model/Text/TextDocument.hpp"
 #include "Lottie/Private/Model/Text/TextAnimator.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -29,14 +30,14 @@ public:
         std::nullopt,
         std::nullopt
     ))) {
-        auto textContainer = getObject(json, "t");
+        auto const &textContainer = getObject(json, "t");
         
-        auto textData = getObject(textContainer, "d");
+        auto const &textData = getObject(textContainer, "d");
         text = KeyframeGroup<TextDocument>(textData);
         
         if (auto animatorsData = getOptionalObjectArray(textContainer, "a")) {
-            for (const auto &animatorData : animatorsData.value()) {
-                animators.push_back(std::make_shared<TextAnimator>(animatorData));
+            for (const auto &animatorData : *animatorsData) {
+                animators.push_back(std::make_shared<TextAnimator>(animatorData.object_items()));
             }
         }
         
@@ -44,6 +45,15 @@ public:
         _extraP = getOptionalAny(textContainer, "p");
     }
     
+    explicit TextLayerModel(SnapshotReader &reader) noexcept(false) :
+    LayerModel(reader, LayerType::Text),
+    text(reader),
+    animators(reader.read<std::vector<std::shared_ptr<TextAnimator>>>()),
+    _extraM(reader.readOptional<lottiejson11::Json>()),
+    _extraP(reader.readOptional<lottiejson11::Json>()),
+    _extraA(reader.readOptional<lottiejson11::Json>()) {
+    }
+    
     virtual ~TextLayerModel() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -66,6 +76,16 @@ public:
         json.insert(std::make_pair("t", textContainer));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        LayerModel::writeSnapshot(writer);
+        
+        writer.write(text);
+        writer.write(animators);
+        writer.write(_extraM);
+        writer.write(_extraP);
+        writer.write(_extraA);
+    }
+    
 public:
     /// The text for the layer
     KeyframeGroup<TextDocument> text;
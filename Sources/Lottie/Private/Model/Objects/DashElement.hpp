@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 #include "Lottie/Public/Primitives/DashPattern.hpp"
 
 namespace lottie {
@@ -42,6 +43,18 @@ public:
         name = getOptionalString(json, "nm");
     }
     
+    explicit DashElement(SnapshotReader &reader) noexcept(false) :
+    type(reader.readEnum(DashElementType::Offset, DashElementType::Gap)),
+    value(reader),
+    name(reader.readOptional<std::string>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.writeEnum(type);
+        writer.write(value);
+        writer.write(name);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
@@ -2,6 +2,7 @@
 #define FitzModifier_hpp
 
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -16,6 +17,24 @@ public:
         type6 = getOptionalInt(json, "f6");
     }
     
+    explicit FitzModifier(SnapshotReader &reader) noexcept(false) :
+    original(reader.readFloat()),
+    type12(reader.readOptional<float>()),
+    type3(reader.readOptional<float>()),
+    type4(reader.readOptional<float>()),
+    type5(reader.readOptional<float>()),
+    type6(reader.readOptional<float>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(original);
+        writer.write(type12);
+        writer.write(type3);
+        writer.write(type4);
+        writer.write(type5);
+        writer.write(type6);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
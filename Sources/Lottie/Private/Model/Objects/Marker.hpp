@@ -3,6 +3,7 @@
 
 #include "Lottie/Public/Primitives/AnimationTime.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <string>
 
@@ -24,6 +25,18 @@ public:
         dr = getOptionalInt(json, "dr");
     }
     
+    explicit Marker(SnapshotReader &reader) noexcept(false) :
+    name(reader.readString()),
+    frameTime(reader.readFloat()),
+    dr(reader.readOptional<int>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(name);
+        writer.write(frameTime);
+        writer.write(dr);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
@@ -4,6 +4,7 @@
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include <LottieCpp/BezierPath.h>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -45,7 +46,7 @@ public:
         }
         
         if (const auto opacityData = getOptionalObject(json, "o")) {
-            opacity = KeyframeGroup<Vector1D>(opacityData.value());
+            opacity = KeyframeGroup<Vector1D>(*opacityData);
         }
         
         shape = KeyframeGroup<BezierPath>(getObject(json, "pt"));
@@ -55,12 +56,30 @@ public:
         }
         
         if (const auto expansionData = getOptionalObject(json, "x")) {
-            expansion = KeyframeGroup<Vector1D>(expansionData.value());
+            expansion = KeyframeGroup<Vector1D>(*expansionData);
         }
         
         name = getOptionalString(json, "nm");
     }
     
+    explicit Mask(SnapshotReader &reader) noexcept(false) :
+    _mode(reader.readOptionalEnum(MaskMode::Add, MaskMode::None)),
+    opacity(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    shape(reader),
+    inverted(reader.readOptional<bool>()),
+    expansion(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    name(reader.readOptional<std::string>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.writeEnum(_mode);
+        writer.write(opacity);
+        writer.write(shape);
+        writer.write(inverted);
+        writer.write(expansion);
+        writer.write(name);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <optional>
 
@@ -46,33 +47,32 @@ public:
     explicit Transform(lottiejson11::Json::object const &json) noexcept(false) {
         // AnchorPoint
         if (const auto anchorPointDictionary = getOptionalObject(json, "a")) {
-            _anchorPoint = KeyframeGroup<Vector3D>(anchorPointDictionary.value());
+            _anchorPoint = KeyframeGroup<Vector3D>(*anchorPointDictionary);
         }
         
         try {
             auto xDictionary = getOptionalObject(json, "px");
             auto yDictionary = getOptionalObject(json, "py");
-            if (xDictionary.has_value() && yDictionary.has_value()) {
-                _positionX = KeyframeGroup<Vector1D>(xDictionary.value());
-                _positionY = KeyframeGroup<Vector1D>(yDictionary.value());
+            if (xDictionary && yDictionary) {
+                _positionX = KeyframeGroup<Vector1D>(*xDictionary);
+                _positionY = KeyframeGroup<Vector1D>(*yDictionary);
                 _position = std::nullopt;
                 _positionInternalRepresentation = PositionInternalRepresentation::TopLevelXY;
             } else if (const auto positionData = getOptionalObject(json, "p")) {
-                try {
-                    LottieParsingException::Guard expectedGuard;
-                    
-                    _position = KeyframeGroup<Vector3D>(positionData.value());
+                // A separated position ({ "s": true, "x": ..., "y": ... }) has no keyframe payload of its own.
+                if (positionData->find("k") != positionData->end()) {
+                    _position = KeyframeGroup<Vector3D>(*positionData);
                     _positionX = std::nullopt;
                     _positionX = std::nullopt;
                     _positionInternalRepresentation = PositionInternalRepresentation::TopLevelCombined;
-                } catch(...) {
-                    auto xData = getObject(positionData.value(), "x");
-                    auto yData = getObject(positionData.value(), "y");
+                } else {
+                    auto const &xData = getObject(*positionData, "x");
+                    auto const &yData = getObject(*positionData, "y");
                     _positionX = KeyframeGroup<Vector1D>(xData);
                     _positionY = KeyframeGroup<Vector1D>(yData);
                     _position = std::nullopt;
                     _positionInternalRepresentation = PositionInternalRepresentation::NestedXY;
-                    _extra_positionS = getOptionalBool(positionData.value(), "s");
+                    _extra_positionS = getOptionalBool(*positionData, "s");
                 }
             } else {
                 _position = std::nullopt;
@@ -87,21 +87,21 @@ public:
         try {
         // Scale
         if (const auto scaleData = getOptionalObject(json, "s")) {
-            _scale = KeyframeGroup<Vector3D>(scaleData.value());
+            _scale = KeyframeGroup<Vector3D>(*scaleData);
         }
 
         // Rotation
         if (const auto rotationZData = getOptionalObject(json, "rz")) {
-            _rotationZ = KeyframeGroup<Vector1D>(rotationZData.value());
+            _rotationZ = KeyframeGroup<Vector1D>(*rotationZData);
             _rotationZInternalRepresentation = RotationZInternalRepresentation::RZ;
         } else if (const auto rotationData = getOptionalObject(json, "r")) {
-            _rotation = KeyframeGroup<Vector1D>(rotationData.value());
+            _rotation = KeyframeGroup<Vector1D>(*rotationData);
             _rotationZInternalRepresentation = RotationZInternalRepresentation::R;
         }
 
         // Opacity
         if (const auto opacityData = getOptionalObject(json, "o")) {
-            _opacity = KeyframeGroup<Vector1D>(opacityData.value());
+            _opacity = KeyframeGroup<Vector1D>(*opacityData);
         }
         } catch(...) {
             throw LottieParsingException();
@@ -112,6 +112,40 @@ public:
         _extraSk = getOptionalAny(json, "sk");
     }
     
+    explicit Transform(SnapshotReader &reader) noexcept(false) :
+    _anchorPoint(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    _position(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    _positionX(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    _positionY(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    _positionInternalRepresentation(reader.readEnum(PositionInternalRepresentation::None, PositionInternalRepresentation::NestedXY)),
+    _scale(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    _rotation(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    _opacity(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    _rotationZ(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    _rotationZInternalRepresentation(reader.readEnum(RotationZInternalRepresentation::RZ, RotationZInternalRepresentation::R)),
+    _extra_positionS(reader.readOptional<bool>()),
+    _extraTy(reader.readOptional<std::string>()),
+    _extraSa(reader.readOptional<lottiejson11::Json>()),
+    _extraSk(reader.readOptional<lottiejson11::Json>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(_anchorPoint);
+        writer.write(_position);
+        writer.write(_positionX);
+        writer.write(_positionY);
+        writer.writeEnum(_positionInternalRepresentation);
+        writer.write(_scale);
+        writer.write(_rotation);
+        writer.write(_opacity);
+        writer.write(_rotationZ);
+        writer.writeEnum(_rotationZInternalRepresentation);
+        writer.write(_extra_positionS);
+        writer.write(_extraTy);
+        writer.write(_extraSa);
+        writer.write(_extraSk);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
@@ -184,35 +218,41 @@ public:
         return result;
     }
     
-    KeyframeGroup<Vector3D> anchorPoint() {
-        if (_anchorPoint.has_value()) {
+    /// The accessors below return references into the model (or to shared defaults) so that interpolators can
+    /// borrow their keyframes.
+    KeyframeGroup<Vector3D> const &anchorPoint() const {
+        if (_anchorPoint) {
             return _anchorPoint.value();
         } else {
-            return KeyframeGroup<Vector3D>(Vector3D(0.0, 0.0, 0.0));
+            static const KeyframeGroup<Vector3D> defaultValue(Vector3D(0.0, 0.0, 0.0));
+            return defaultValue;
         }
     }
     
-    KeyframeGroup<Vector3D> scale() const {
+    KeyframeGroup<Vector3D> const &scale() const {
         if (_scale) {
             return _scale.value();
         } else {
-            return KeyframeGroup<Vector3D>(Vector3D(100.0, 100.0, 100.0));
+            static const KeyframeGroup<Vector3D> defaultValue(Vector3D(100.0, 100.0, 100.0));
+            return defaultValue;
         }
     }
     
-    KeyframeGroup<Vector1D> rotation() const {
+    KeyframeGroup<Vector1D> const &rotation() const {
         if (_rotation) {
             return _rotation.value();
         } else {
-            return KeyframeGroup<Vector1D>(Vector1D(0.0));
+            static const KeyframeGroup<Vector1D> defaultValue(Vector1D(0.0));
+            return defaultValue;
         }
     }
     
-    KeyframeGroup<Vector1D> opacity() const {
+    KeyframeGroup<Vector1D> const &opacity() const {
         if (_opacity) {
             return _opacity.value();
         } else {
-            return KeyframeGroup<Vector1D>(Vector1D(100.0));
+            static const KeyframeGroup<Vector1D> defaultValue(Vector1D(100.0));
+            return defaultValue;
         }
     }
     
@@ -254,7 +294,7 @@ private:
     
     /// Should always be nil.
     std::optional<KeyframeGroup<Vector1D>> _rotationZ;
-    RotationZInternalRepresentation _rotationZInternalRepresentation;
+    RotationZInternalRepresentation _rotationZInternalRepresentation = RotationZInternalRepresentation::R;
     
     std::optional<bool> _extra_positionS;
     std::optional<std::string> _extraTy;
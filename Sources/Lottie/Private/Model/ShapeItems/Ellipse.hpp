@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include <LottieCpp/Vectors.h>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -41,6 +42,13 @@ public:
         size = KeyframeGroup<Vector3D>(getObject(json, "s"));
     }
     
+    explicit Ellipse(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Ellipse),
+    direction(reader.readOptionalEnum(PathDirection::Clockwise, PathDirection::CounterClockwise)),
+    position(reader),
+    size(reader) {
+    }
+    
     virtual ~Ellipse() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -53,6 +61,14 @@ public:
         json.insert(std::make_pair("s", size.toJson()));
     }
   
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.writeEnum(direction);
+        writer.write(position);
+        writer.write(size);
+    }
+    
 public:
     std::optional<PathDirection> direction;
     KeyframeGroup<Vector3D> position;
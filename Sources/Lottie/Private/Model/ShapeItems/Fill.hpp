@@ -6,6 +6,7 @@
 #import <LottieCpp/Color.h>
 #include <LottieCpp/Vectors.h>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 #include <LottieCpp/ShapeAttributes.h>
 
 namespace lottie {
@@ -38,6 +39,14 @@ public:
         fillEnabled = getOptionalBool(json, "fillEnabled");
     }
     
+    explicit Fill(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Fill),
+    opacity(reader),
+    color(reader),
+    fillRule(reader.readOptionalEnum(FillRule::None, FillRule::EvenOdd)),
+    fillEnabled(reader.readOptional<bool>()) {
+    }
+    
     virtual ~Fill() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -55,6 +64,15 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(opacity);
+        writer.write(color);
+        writer.writeEnum(fillRule);
+        writer.write(fillEnabled);
+    }
+    
 public:
     KeyframeGroup<Vector1D> opacity;
 
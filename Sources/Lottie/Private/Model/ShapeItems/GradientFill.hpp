@@ -4,6 +4,7 @@
 #include "Lottie/Private/Model/ShapeItems/ShapeItem.hpp"
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 #include "Lottie/Public/Primitives/GradientColorSet.hpp"
 #include <LottieCpp/ShapeAttributes.h>
 
@@ -40,19 +41,32 @@ public:
         }
         
         if (const auto highlightLengthData = getOptionalObject(json, "h")) {
-            highlightLength = KeyframeGroup<Vector1D>(highlightLengthData.value());
+            highlightLength = KeyframeGroup<Vector1D>(*highlightLengthData);
         }
         if (const auto highlightAngleData = getOptionalObject(json, "a")) {
-            highlightAngle = KeyframeGroup<Vector1D>(highlightAngleData.value());
+            highlightAngle = KeyframeGroup<Vector1D>(*highlightAngleData);
         }
         
-        auto colorsContainer = getObject(json, "g");
+        auto const &colorsContainer = getObject(json, "g");
         numberOfColors = getInt(colorsContainer, "p");
         colors = KeyframeGroup<GradientColorSet>(getObject(colorsContainer, "k"));
         
         rValue = getOptionalInt(json, "r");
     }
     
+    explicit GradientFill(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::GradientFill),
+    opacity(reader),
+    startPoint(reader),
+    endPoint(reader),
+    gradientType(reader.readEnum(GradientType::None, GradientType::Radial)),
+    highlightLength(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    highlightAngle(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    numberOfColors(reader.readInt()),
+    colors(reader),
+    rValue(reader.readOptional<int>()) {
+    }
+    
     virtual ~GradientFill() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -80,6 +94,20 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(opacity);
+        writer.write(startPoint);
+        writer.write(endPoint);
+        writer.writeEnum(gradientType);
+        writer.write(highlightLength);
+        writer.write(highlightAngle);
+        writer.write(numberOfColors);
+        writer.write(colors);
+        writer.write(rValue);
+    }
+    
 public:
     /// The opacity of the fill
     KeyframeGroup<Vector1D> opacity;
@@ -6,6 +6,7 @@
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Model/Objects/DashElement.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 #include <LottieCpp/ShapeAttributes.h>
 
 namespace lottie {
@@ -44,10 +45,10 @@ public:
         }
         
         if (const auto highlightLengthData = getOptionalObject(json, "h")) {
-            highlightLength = KeyframeGroup<Vector1D>(highlightLengthData.value());
+            highlightLength = KeyframeGroup<Vector1D>(*highlightLengthData);
         }
         if (const auto highlightAngleData = getOptionalObject(json, "a")) {
-            highlightAngle = KeyframeGroup<Vector1D>(highlightAngleData.value());
+            highlightAngle = KeyframeGroup<Vector1D>(*highlightAngleData);
         }
         
         width = KeyframeGroup<Vector1D>(getObject(json, "w"));
@@ -94,19 +95,36 @@ public:
             miterLimit = (float)miterLimitData.value();
         }
         
-        auto colorsContainer = getObject(json, "g");
+        auto const &colorsContainer = getObject(json, "g");
         numberOfColors = getInt(colorsContainer, "p");
-        auto colorsData = getObject(colorsContainer, "k");
+        auto const &colorsData = getObject(colorsContainer, "k");
         colors = KeyframeGroup<GradientColorSet>(colorsData);
         
         if (const auto dashElementsData = getOptionalObjectArray(json, "d")) {
             dashPattern = std::vector<DashElement>();
-            for (const auto &dashElementData : dashElementsData.value()) {
-                dashPattern->push_back(DashElement(dashElementData));
+            for (const auto &dashElementData : *dashElementsData) {
+                dashPattern->push_back(DashElement(dashElementData.object_items()));
             }
         }
     }
     
+    explicit GradientStroke(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::GradientStroke),
+    opacity(reader),
+    startPoint(reader),
+    endPoint(reader),
+    gradientType(reader.readEnum(GradientType::None, GradientType::Radial)),
+    highlightLength(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    highlightAngle(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    numberOfColors(reader.readInt()),
+    colors(reader),
+    width(reader),
+    lineCap(reader.readEnum(LineCap::None, LineCap::Square)),
+    lineJoin(reader.readEnum(LineJoin::None, LineJoin::Bevel)),
+    miterLimit(reader.readOptional<float>()),
+    dashPattern(reader.readOptional<std::vector<DashElement>>()) {
+    }
+    
     virtual ~GradientStroke() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -147,6 +165,24 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(opacity);
+        writer.write(startPoint);
+        writer.write(endPoint);
+        writer.writeEnum(gradientType);
+        writer.write(highlightLength);
+        writer.write(highlightAngle);
+        writer.write(numberOfColors);
+        writer.write(colors);
+        writer.write(width);
+        writer.writeEnum(lineCap);
+        writer.writeEnum(lineJoin);
+        writer.write(miterLimit);
+        writer.write(dashPattern);
+    }
+    
 public:
     /// The opacity of the fill
     KeyframeGroup<Vector1D> opacity;
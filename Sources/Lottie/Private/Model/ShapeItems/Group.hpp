@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Model/ShapeItems/ShapeItem.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <vector>
 #include <memory>
@@ -14,14 +15,20 @@ class Group: public ShapeItem {
 public:
     explicit Group(lottiejson11::Json::object const &json) noexcept(false) :
     ShapeItem(json) {
-        auto itemsData = getObjectArray(json, "it");
+        auto const &itemsData = getObjectArray(json, "it");
         for (const auto &itemData : itemsData) {
-            items.push_back(parseShapeItem(itemData));
+            items.push_back(parseShapeItem(itemData.object_items()));
         }
         
         numberOfProperties = getOptionalInt(json, "np");
     }
     
+    explicit Group(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Group),
+    items(readShapeItems(reader)),
+    numberOfProperties(reader.readOptional<int>()) {
+    }
+    
     virtual ~Group() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -41,6 +48,13 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(items);
+        writer.write(numberOfProperties);
+    }
+    
 public:
     /// A list of shape items.
     std::vector<std::shared_ptr<ShapeItem>> items;
@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Model/ShapeItems/ShapeItem.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -46,6 +47,11 @@ public:
         }
     }
     
+    explicit Merge(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Merge),
+    mode(reader.readEnum(MergeMode::None, MergeMode::Exclude)) {
+    }
+    
     virtual ~Merge() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -54,6 +60,12 @@ public:
         json.insert(std::make_pair("mm", (int)mode));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.writeEnum(mode);
+    }
+    
 public:
     /// The mode of the merge path
     MergeMode mode;
@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/ShapeItems/Ellipse.hpp"
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -37,6 +38,14 @@ public:
         cornerRadius = KeyframeGroup<Vector1D>(getObject(json, "r"));
     }
     
+    explicit Rectangle(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Rectangle),
+    direction(reader.readOptionalEnum(PathDirection::Clockwise, PathDirection::CounterClockwise)),
+    position(reader),
+    size(reader),
+    cornerRadius(reader) {
+    }
+    
     virtual ~Rectangle() = default;
     
     explicit Rectangle(
@@ -82,6 +91,15 @@ public:
         json.insert(std::make_pair("r", cornerRadius.toJson()));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.writeEnum(direction);
+        writer.write(position);
+        writer.write(size);
+        writer.write(cornerRadius);
+    }
+    
 public:
     /// The direction of the rect.
     std::optional<PathDirection> direction;
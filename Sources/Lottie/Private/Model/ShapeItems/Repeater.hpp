@@ -4,6 +4,7 @@
 #include "Lottie/Private/Model/ShapeItems/ShapeItem.hpp"
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -13,30 +14,42 @@ public:
     explicit Repeater(lottiejson11::Json::object const &json) noexcept(false) :
     ShapeItem(json) {
         if (const auto copiesData = getOptionalObject(json, "c")) {
-            copies = KeyframeGroup<Vector1D>(copiesData.value());
+            copies = KeyframeGroup<Vector1D>(*copiesData);
         }
         if (const auto offsetData = getOptionalObject(json, "o")) {
-            offset = KeyframeGroup<Vector1D>(offsetData.value());
+            offset = KeyframeGroup<Vector1D>(*offsetData);
         }
         
-        auto transformContainer = getObject(json, "tr");
+        auto const &transformContainer = getObject(json, "tr");
         if (const auto startOpacityData = getOptionalObject(transformContainer, "so")) {
-            startOpacity = KeyframeGroup<Vector1D>(startOpacityData.value());
+            startOpacity = KeyframeGroup<Vector1D>(*startOpacityData);
         }
         if (const auto endOpacityData = getOptionalObject(transformContainer, "eo")) {
-            endOpacity = KeyframeGroup<Vector1D>(endOpacityData.value());
+            endOpacity = KeyframeGroup<Vector1D>(*endOpacityData);
         }
         if (const auto rotationData = getOptionalObject(transformContainer, "r")) {
-            rotation = KeyframeGroup<Vector1D>(rotationData.value());
+            rotation = KeyframeGroup<Vector1D>(*rotationData);
         }
         if (const auto positionData = getOptionalObject(transformContainer, "p")) {
-            position = KeyframeGroup<Vector3D>(positionData.value());
+            position = KeyframeGroup<Vector3D>(*positionData);
         }
         if (const auto scaleData = getOptionalObject(transformContainer, "s")) {
-            scale = KeyframeGroup<Vector3D>(scaleData.value());
+            scale = KeyframeGroup<Vector3D>(*scaleData);
         }
     }
     
+    explicit Repeater(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Repeater),
+    copies(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    offset(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    startOpacity(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    endOpacity(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    rotation(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    anchorPoint(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    position(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    scale(reader.readOptional<KeyframeGroup<Vector3D>>()) {
+    }
+    
     virtual ~Repeater() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -69,6 +82,19 @@ public:
         json.insert(std::make_pair("tr", transformContainer));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(copies);
+        writer.write(offset);
+        writer.write(startOpacity);
+        writer.write(endOpacity);
+        writer.write(rotation);
+        writer.write(anchorPoint);
+        writer.write(position);
+        writer.write(scale);
+    }
+    
 public:
     /// The number of copies to repeat
     std::optional<KeyframeGroup<Vector1D>> copies;
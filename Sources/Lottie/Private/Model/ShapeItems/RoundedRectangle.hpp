@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/ShapeItems/Ellipse.hpp"
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -31,15 +32,23 @@ public:
         }
         
         if (const auto positionData = getOptionalObject(json, "p")) {
-            position = KeyframeGroup<Vector3D>(positionData.value());
+            position = KeyframeGroup<Vector3D>(*positionData);
         }
         if (const auto sizeData = getOptionalObject(json, "s")) {
-            size = KeyframeGroup<Vector3D>(sizeData.value());
+            size = KeyframeGroup<Vector3D>(*sizeData);
         }
         
         cornerRadius = KeyframeGroup<Vector1D>(getObject(json, "r"));
     }
     
+    explicit RoundedRectangle(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::RoundedRectangle),
+    direction(reader.readOptionalEnum(PathDirection::Clockwise, PathDirection::CounterClockwise)),
+    position(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    size(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    cornerRadius(reader) {
+    }
+    
     virtual ~RoundedRectangle() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -58,6 +67,15 @@ public:
         json.insert(std::make_pair("r", cornerRadius.toJson()));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.writeEnum(direction);
+        writer.write(position);
+        writer.write(size);
+        writer.write(cornerRadius);
+    }
+    
 public:
     /// The direction of the rect.
     std::optional<PathDirection> direction;
@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/ShapeItems/Ellipse.hpp"
 #include <LottieCpp/BezierPath.h>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <optional>
 
@@ -33,6 +34,12 @@ public:
         }
     }
     
+    explicit Shape(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Shape),
+    path(reader),
+    direction(reader.readOptionalEnum(PathDirection::Clockwise, PathDirection::CounterClockwise)) {
+    }
+    
     virtual ~Shape() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -45,6 +52,13 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(path);
+        writer.writeEnum(direction);
+    }
+    
 public:
     KeyframeGroup<BezierPath> path;
     std::optional<PathDirection> direction;
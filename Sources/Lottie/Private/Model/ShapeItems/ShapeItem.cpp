@@ -19,6 +19,7 @@ namespace lottie {
 
 std::shared_ptr<ShapeItem> parseShapeItem(lottiejson11::Json::object const &json) noexcept(false) {
     auto typeRawValue = getString(json, "ty");
+    ParsingStatistics::reportShapeItem();
     if (typeRawValue == "el") {
         return std::make_shared<Ellipse>(json);
     } else if (typeRawValue == "fl") {
@@ -52,4 +53,61 @@ std::shared_ptr<ShapeItem> parseShapeItem(lottiejson11::Json::object const &json
     }
 }
 
+std::vector<std::shared_ptr<ShapeItem>> readShapeItems(SnapshotReader &reader) noexcept(false) {
+    SnapshotReader::NestingScope nestingScope(reader);
+    
+    size_t count = reader.readCount();
+    
+    std::vector<std::shared_ptr<ShapeItem>> items;
+    items.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        ShapeType type = reader.readEnum(ShapeType::Ellipse, ShapeType::RoundedRectangle);
+        switch (type) {
+            case ShapeType::Ellipse:
+                items.push_back(std::make_shared<Ellipse>(reader));
+                break;
+            case ShapeType::Fill:
+                items.push_back(std::make_shared<Fill>(reader));
+                break;
+            case ShapeType::GradientFill:
+                items.push_back(std::make_shared<GradientFill>(reader));
+                break;
+            case ShapeType::Group:
+                items.push_back(std::make_shared<Group>(reader));
+                break;
+            case ShapeType::GradientStroke:
+                items.push_back(std::make_shared<GradientStroke>(reader));
+                break;
+            case ShapeType::Merge:
+                items.push_back(std::make_shared<Merge>(reader));
+                break;
+            case ShapeType::Rectangle:
+                items.push_back(std::make_shared<Rectangle>(reader));
+                break;
+            case ShapeType::Repeater:
+                items.push_back(std::make_shared<Repeater>(reader));
+                break;
+            case ShapeType::Shape:
+                items.push_back(std::make_shared<Shape>(reader));
+                break;
+            case ShapeType::Star:
+                items.push_back(std::make_shared<Star>(reader));
+                break;
+            case ShapeType::Stroke:
+                items.push_back(std::make_shared<Stroke>(reader));
+                break;
+            case ShapeType::Trim:
+                items.push_back(std::make_shared<Trim>(reader));
+                break;
+            case ShapeType::Transform:
+                items.push_back(std::make_shared<ShapeTransform>(reader));
+                break;
+            case ShapeType::RoundedRectangle:
+                items.push_back(std::make_shared<RoundedRectangle>(reader));
+                break;
+        }
+    }
+    return items;
+}
+
 }
@@ -2,6 +2,7 @@
 #define ShapeItem_hpp
 
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <string>
 
@@ -103,6 +104,19 @@ public:
     layerClass(layerClass_) {
     }
     
+    /// `type_` has already been read by `readShapeItems`, which picks the subclass from it.
+    ShapeItem(SnapshotReader &reader, ShapeType type_) noexcept(false) :
+    name(reader.readOptional<std::string>()),
+    matchName(reader.readOptional<std::string>()),
+    expressionIndex(reader.readOptional<int>()),
+    cix(reader.readOptional<int>()),
+    type(type_),
+    _hidden(reader.readOptional<bool>()),
+    index(reader.readOptional<int>()),
+    blendMode(reader.readOptional<int>()),
+    layerClass(reader.readOptional<std::string>()) {
+    }
+    
     ShapeItem(const ShapeItem&) = delete;
     ShapeItem& operator=(ShapeItem&) = delete;
     
@@ -181,6 +195,19 @@ public:
         }
     }
     
+    /// Writes the shape type first, followed by the fields in declaration order.
+    virtual void writeSnapshot(SnapshotWriter &writer) const {
+        writer.writeEnum(type);
+        writer.write(name);
+        writer.write(matchName);
+        writer.write(expressionIndex);
+        writer.write(cix);
+        writer.write(_hidden);
+        writer.write(index);
+        writer.write(blendMode);
+        writer.write(layerClass);
+    }
+    
     bool hidden() const {
         if (_hidden.has_value()) {
             return _hidden.value();
@@ -204,6 +231,9 @@ public:
 
 std::shared_ptr<ShapeItem> parseShapeItem(lottiejson11::Json::object const &json) noexcept(false);
 
+/// Reads a shape item array written with `SnapshotWriter::write`, each item starting with its type.
+std::vector<std::shared_ptr<ShapeItem>> readShapeItems(SnapshotReader &reader) noexcept(false);
+
 }
 
 #endif /* ShapeItem_hpp */
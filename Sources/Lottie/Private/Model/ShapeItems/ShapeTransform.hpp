@@ -4,6 +4,7 @@
 #include "Lottie/Private/Model/ShapeItems/ShapeItem.hpp"
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -13,28 +14,39 @@ public:
     explicit ShapeTransform(lottiejson11::Json::object const &json) noexcept(false) :
     ShapeItem(json) {
         if (const auto anchorData = getOptionalObject(json, "a")) {
-            anchor = KeyframeGroup<Vector3D>(anchorData.value());
+            anchor = KeyframeGroup<Vector3D>(*anchorData);
         }
         if (const auto positionData = getOptionalObject(json, "p")) {
-            position = KeyframeGroup<Vector3D>(positionData.value());
+            position = KeyframeGroup<Vector3D>(*positionData);
         }
         if (const auto scaleData = getOptionalObject(json, "s")) {
-            scale = KeyframeGroup<Vector3D>(scaleData.value());
+            scale = KeyframeGroup<Vector3D>(*scaleData);
         }
         if (const auto rotationData = getOptionalObject(json, "r")) {
-            rotation = KeyframeGroup<Vector1D>(rotationData.value());
+            rotation = KeyframeGroup<Vector1D>(*rotationData);
         }
         if (const auto opacityData = getOptionalObject(json, "o")) {
-            opacity = KeyframeGroup<Vector1D>(opacityData.value());
+            opacity = KeyframeGroup<Vector1D>(*opacityData);
         }
         if (const auto skewData = getOptionalObject(json, "sk")) {
-            skew = KeyframeGroup<Vector1D>(skewData.value());
+            skew = KeyframeGroup<Vector1D>(*skewData);
         }
         if (const auto skewAxisData = getOptionalObject(json, "sa")) {
-            skewAxis = KeyframeGroup<Vector1D>(skewAxisData.value());
+            skewAxis = KeyframeGroup<Vector1D>(*skewAxisData);
         }
     }
     
+    explicit ShapeTransform(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Transform),
+    anchor(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    position(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    scale(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    rotation(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    opacity(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    skew(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    skewAxis(reader.readOptional<KeyframeGroup<Vector1D>>()) {
+    }
+    
     virtual ~ShapeTransform() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -63,6 +75,18 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(anchor);
+        writer.write(position);
+        writer.write(scale);
+        writer.write(rotation);
+        writer.write(opacity);
+        writer.write(skew);
+        writer.write(skewAxis);
+    }
+    
 public:
     /// Anchor Point
     std::optional<KeyframeGroup<Vector3D>> anchor;
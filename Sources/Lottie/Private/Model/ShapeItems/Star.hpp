@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/ShapeItems/Ellipse.hpp"
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <optional>
 
@@ -48,10 +49,10 @@ public:
         outerRoundness = KeyframeGroup<Vector1D>(getObject(json, "os"));
         
         if (const auto innerRadiusData = getOptionalObject(json, "ir")) {
-            innerRadius = KeyframeGroup<Vector1D>(innerRadiusData.value());
+            innerRadius = KeyframeGroup<Vector1D>(*innerRadiusData);
         }
         if (const auto innerRoundnessData = getOptionalObject(json, "is")) {
-            innerRoundness = KeyframeGroup<Vector1D>(innerRoundnessData.value());
+            innerRoundness = KeyframeGroup<Vector1D>(*innerRoundnessData);
         }
         
         rotation = KeyframeGroup<Vector1D>(getObject(json, "r"));
@@ -73,6 +74,19 @@ public:
         }
     }
     
+    explicit Star(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Star),
+    direction(reader.readOptionalEnum(PathDirection::Clockwise, PathDirection::CounterClockwise)),
+    position(reader),
+    outerRadius(reader),
+    outerRoundness(reader),
+    innerRadius(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    innerRoundness(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    rotation(reader),
+    points(reader),
+    starType(reader.readEnum(StarType::None, StarType::Polygon)) {
+    }
+    
     virtual ~Star() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -99,6 +113,20 @@ public:
         json.insert(std::make_pair("sy", (int)starType));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.writeEnum(direction);
+        writer.write(position);
+        writer.write(outerRadius);
+        writer.write(outerRoundness);
+        writer.write(innerRadius);
+        writer.write(innerRoundness);
+        writer.write(rotation);
+        writer.write(points);
+        writer.writeEnum(starType);
+    }
+    
 public:
     /// The direction of the star.
     std::optional<PathDirection> direction;
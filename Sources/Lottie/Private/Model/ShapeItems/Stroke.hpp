@@ -7,6 +7,7 @@
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Model/Objects/DashElement.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <optional>
 
@@ -70,8 +71,8 @@ public:
         
         if (const auto dashElementsData = getOptionalObjectArray(json, "d")) {
             dashPattern = std::vector<DashElement>();
-            for (const auto &dashElementData : dashElementsData.value()) {
-                dashPattern->push_back(DashElement(dashElementData));
+            for (const auto &dashElementData : *dashElementsData) {
+                dashPattern->push_back(DashElement(dashElementData.object_items()));
             }
         }
         
@@ -79,6 +80,19 @@ public:
         ml2 = getOptionalAny(json, "ml2");
     }
     
+    explicit Stroke(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Stroke),
+    opacity(reader),
+    color(reader),
+    width(reader),
+    lineCap(reader.readEnum(LineCap::None, LineCap::Square)),
+    lineJoin(reader.readEnum(LineJoin::None, LineJoin::Bevel)),
+    miterLimit(reader.readOptional<float>()),
+    dashPattern(reader.readOptional<std::vector<DashElement>>()),
+    fillEnabled(reader.readOptional<bool>()),
+    ml2(reader.readOptional<lottiejson11::Json>()) {
+    }
+    
     virtual ~Stroke() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -111,6 +125,20 @@ public:
         }
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(opacity);
+        writer.write(color);
+        writer.write(width);
+        writer.writeEnum(lineCap);
+        writer.writeEnum(lineJoin);
+        writer.write(miterLimit);
+        writer.write(dashPattern);
+        writer.write(fillEnabled);
+        writer.write(ml2);
+    }
+    
 public:
     /// The opacity of the stroke
     KeyframeGroup<Vector1D> opacity;
@@ -5,6 +5,7 @@
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include <LottieCpp/Vectors.h>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 namespace lottie {
 
@@ -34,6 +35,14 @@ public:
         }
     }
     
+    explicit Trim(SnapshotReader &reader) noexcept(false) :
+    ShapeItem(reader, ShapeType::Trim),
+    start(reader),
+    end(reader),
+    offset(reader),
+    trimType(reader.readEnum(TrimType::Simultaneously, TrimType::Individually)) {
+    }
+    
     virtual ~Trim() = default;
     
     virtual void toJson(lottiejson11::Json::object &json) const override {
@@ -45,6 +54,15 @@ public:
         json.insert(std::make_pair("m", (int)trimType));
     }
     
+    virtual void writeSnapshot(SnapshotWriter &writer) const override {
+        ShapeItem::writeSnapshot(writer);
+        
+        writer.write(start);
+        writer.write(end);
+        writer.write(offset);
+        writer.writeEnum(trimType);
+    }
+    
 public:
     KeyframeGroup<Vector1D> start;
     KeyframeGroup<Vector1D> end;
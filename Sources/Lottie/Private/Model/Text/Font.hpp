@@ -2,6 +2,7 @@
 #define Font_hpp
 
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <string>
 #include <vector>
@@ -33,6 +34,28 @@ public:
         origin = getOptionalInt(json, "origin");
     }
     
+    explicit Font(SnapshotReader &reader) noexcept(false) :
+    name(reader.readString()),
+    familyName(reader.readString()),
+    path(reader.readOptional<std::string>()),
+    weight(reader.readOptional<std::string>()),
+    fontClass(reader.readOptional<std::string>()),
+    style(reader.readString()),
+    ascent(reader.readFloat()),
+    origin(reader.readOptional<int>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(name);
+        writer.write(familyName);
+        writer.write(path);
+        writer.write(weight);
+        writer.write(fontClass);
+        writer.write(style);
+        writer.write(ascent);
+        writer.write(origin);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
@@ -76,12 +99,20 @@ public:
     
     explicit FontList(lottiejson11::Json::object const &json) noexcept(false) {
         if (const auto fontsData = getOptionalObjectArray(json, "list")) {
-            for (const auto &fontData : fontsData.value()) {
-                fonts.emplace_back(fontData);
+            for (const auto &fontData : *fontsData) {
+                fonts.emplace_back(fontData.object_items());
             }
         }
     }
     
+    explicit FontList(SnapshotReader &reader) noexcept(false) :
+    fonts(reader.read<std::vector<Font>>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(fonts);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::array fontArray;
         
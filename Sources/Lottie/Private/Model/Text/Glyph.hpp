@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Model/ShapeItems/ShapeItem.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <string>
 #include <vector>
@@ -42,16 +43,38 @@ public:
         if (const auto shapeContainer = getOptionalObject(json, "data")) {
             internalHasData = true;
             
-            if (const auto shapesData = getOptionalObjectArray(shapeContainer.value(), "shapes")) {
+            if (const auto shapesData = getOptionalObjectArray(*shapeContainer, "shapes")) {
                 shapes = std::vector<std::shared_ptr<ShapeItem>>();
                 
-                for (const auto &shapeData : shapesData.value()) {
-                    shapes->push_back(parseShapeItem(shapeData));
+                for (const auto &shapeData : *shapesData) {
+                    shapes->push_back(parseShapeItem(shapeData.object_items()));
                 }
             }
         }
     }
     
+    explicit Glyph(SnapshotReader &reader) noexcept(false) :
+    character(reader.readString()),
+    fontSize(reader.readFloat()),
+    fontFamily(reader.readString()),
+    fontStyle(reader.readString()),
+    width(reader.readFloat()) {
+        if (reader.readBool()) {
+            shapes = readShapeItems(reader);
+        }
+        internalHasData = reader.readBool();
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(character);
+        writer.write(fontSize);
+        writer.write(fontFamily);
+        writer.write(fontStyle);
+        writer.write(width);
+        writer.write(shapes);
+        writer.write(internalHasData);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
@@ -5,6 +5,7 @@
 #import <LottieCpp/Color.h>
 #include "Lottie/Private/Model/Keyframes/KeyframeGroup.hpp"
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <string>
 #include <optional>
@@ -55,40 +56,72 @@ public:
         lottiejson11::Json::object const &animatorContainer = getObject(json, "a");
         
         if (const auto fillColorData = getOptionalObject(animatorContainer, "fc")) {
-            fillColor = KeyframeGroup<Color>(fillColorData.value());
+            fillColor = KeyframeGroup<Color>(*fillColorData);
         }
         if (const auto strokeColorData = getOptionalObject(animatorContainer, "sc")) {
-            strokeColor = KeyframeGroup<Color>(strokeColorData.value());
+            strokeColor = KeyframeGroup<Color>(*strokeColorData);
         }
         if (const auto strokeWidthData = getOptionalObject(animatorContainer, "sw")) {
-            strokeWidth = KeyframeGroup<Vector1D>(strokeWidthData.value());
+            strokeWidth = KeyframeGroup<Vector1D>(*strokeWidthData);
         }
         if (const auto trackingData = getOptionalObject(animatorContainer, "t")) {
-            tracking = KeyframeGroup<Vector1D>(trackingData.value());
+            tracking = KeyframeGroup<Vector1D>(*trackingData);
         }
         if (const auto anchorData = getOptionalObject(animatorContainer, "a")) {
-            anchor = KeyframeGroup<Vector3D>(anchorData.value());
+            anchor = KeyframeGroup<Vector3D>(*anchorData);
         }
         if (const auto positionData = getOptionalObject(animatorContainer, "p")) {
-            position = KeyframeGroup<Vector3D>(positionData.value());
+            position = KeyframeGroup<Vector3D>(*positionData);
         }
         if (const auto scaleData = getOptionalObject(animatorContainer, "s")) {
-            scale = KeyframeGroup<Vector3D>(scaleData.value());
+            scale = KeyframeGroup<Vector3D>(*scaleData);
         }
         if (const auto skewData = getOptionalObject(animatorContainer, "sk")) {
-            skew = KeyframeGroup<Vector1D>(skewData.value());
+            skew = KeyframeGroup<Vector1D>(*skewData);
         }
         if (const auto skewAxisData = getOptionalObject(animatorContainer, "sa")) {
-            skewAxis = KeyframeGroup<Vector1D>(skewAxisData.value());
+            skewAxis = KeyframeGroup<Vector1D>(*skewAxisData);
         }
         if (const auto rotationData = getOptionalObject(animatorContainer, "r")) {
-            rotation = KeyframeGroup<Vector1D>(rotationData.value());
+            rotation = KeyframeGroup<Vector1D>(*rotationData);
         }
         if (const auto opacityData = getOptionalObject(animatorContainer, "o")) {
-            opacity = KeyframeGroup<Vector1D>(opacityData.value());
+            opacity = KeyframeGroup<Vector1D>(*opacityData);
         }
     }
     
+    explicit TextAnimator(SnapshotReader &reader) noexcept(false) :
+    name(reader.readOptional<std::string>()),
+    anchor(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    position(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    scale(reader.readOptional<KeyframeGroup<Vector3D>>()),
+    skew(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    skewAxis(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    rotation(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    opacity(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    strokeColor(reader.readOptional<KeyframeGroup<Color>>()),
+    fillColor(reader.readOptional<KeyframeGroup<Color>>()),
+    strokeWidth(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    tracking(reader.readOptional<KeyframeGroup<Vector1D>>()),
+    _extraS(reader.readOptional<lottiejson11::Json>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(name);
+        writer.write(anchor);
+        writer.write(position);
+        writer.write(scale);
+        writer.write(skew);
+        writer.write(skewAxis);
+        writer.write(rotation);
+        writer.write(opacity);
+        writer.write(strokeColor);
+        writer.write(fillColor);
+        writer.write(strokeWidth);
+        writer.write(tracking);
+        writer.write(_extraS);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object animatorContainer;
         
@@ -4,6 +4,7 @@
 #include <LottieCpp/Vectors.h>
 #import <LottieCpp/Color.h>
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Parsing/ModelSnapshot.hpp"
 
 #include <string>
 #include <optional>
@@ -109,6 +110,38 @@ public:
         }
     }
     
+    explicit TextDocument(SnapshotReader &reader) noexcept(false) :
+    text(reader.readString()),
+    fontSize(reader.readFloat()),
+    fontFamily(reader.readString()),
+    justification(reader.readEnum(TextJustification::Left, TextJustification::Center)),
+    tracking(reader.readInt()),
+    lineHeight(reader.readFloat()),
+    baseline(reader.readOptional<float>()),
+    fillColorData(reader.readOptional<Color>()),
+    strokeColorData(reader.readOptional<Color>()),
+    strokeWidth(reader.readOptional<float>()),
+    strokeOverFill(reader.readOptional<bool>()),
+    textFramePosition(reader.readOptional<Vector3D>()),
+    textFrameSize(reader.readOptional<Vector3D>()) {
+    }
+    
+    void writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(text);
+        writer.write(fontSize);
+        writer.write(fontFamily);
+        writer.writeEnum(justification);
+        writer.write(tracking);
+        writer.write(lineHeight);
+        writer.write(baseline);
+        writer.write(fillColorData);
+        writer.write(strokeColorData);
+        writer.write(strokeWidth);
+        writer.write(strokeOverFill);
+        writer.write(textFramePosition);
+        writer.write(textFrameSize);
+    }
+    
     lottiejson11::Json::object toJson() const {
         lottiejson11::Json::object result;
         
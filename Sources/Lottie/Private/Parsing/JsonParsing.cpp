@@ -1,6 +1,7 @@
 #include "JsonParsing.hpp"
 
 #include <cassert>
+#include <chrono>
 
 namespace lottie {
 
@@ -26,7 +27,55 @@ const char* LottieParsingException::what() const throw() {
     return "Lottie parsing exception";
 }
 
-lottiejson11::Json getAny(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
+static thread_local ParsingStatistics *currentParsingStatistics = nullptr;
+
+ParsingStatistics::Scope::Scope(ParsingStatistics &statistics) :
+_previous(currentParsingStatistics) {
+    currentParsingStatistics = &statistics;
+}
+
+ParsingStatistics::Scope::~Scope() {
+    currentParsingStatistics = _previous;
+}
+
+void ParsingStatistics::reportLayer() {
+    if (currentParsingStatistics) {
+        currentParsingStatistics->layerCount++;
+    }
+}
+
+void ParsingStatistics::reportShapeItem() {
+    if (currentParsingStatistics) {
+        currentParsingStatistics->shapeItemCount++;
+    }
+}
+
+void ParsingStatistics::reportKeyframes(size_t count) {
+    if (currentParsingStatistics) {
+        currentParsingStatistics->keyframeCount += (int)count;
+    }
+}
+
+void ParsingStatistics::reportJsonParseDuration(double duration) {
+    if (currentParsingStatistics) {
+        currentParsingStatistics->jsonParseDuration += duration;
+    }
+}
+
+void ParsingStatistics::reportStatistics(ParsingStatistics const &statistics) {
+    if (currentParsingStatistics) {
+        currentParsingStatistics->add(statistics);
+    }
+}
+
+void ParsingStatistics::add(ParsingStatistics const &statistics) {
+    layerCount += statistics.layerCount;
+    shapeItemCount += statistics.shapeItemCount;
+    keyframeCount += statistics.keyframeCount;
+    jsonParseDuration += statistics.jsonParseDuration;
+}
+
+lottiejson11::Json const &getAny(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
     auto value = object.find(key);
     if (value == object.end()) {
         throw LottieParsingException();
@@ -42,7 +91,7 @@ std::optional<lottiejson11::Json> getOptionalAny(lottiejson11::Json::object cons
     return value->second;
 }
 
-lottiejson11::Json::object getObject(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
+lottiejson11::Json::object const &getObject(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
     auto value = object.find(key);
     if (value == object.end()) {
         throw LottieParsingException();
@@ -53,58 +102,46 @@ lottiejson11::Json::object getObject(lottiejson11::Json::object const &object, s
     return value->second.object_items();
 }
 
-std::optional<lottiejson11::Json::object> getOptionalObject(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
+lottiejson11::Json::object const *getOptionalObject(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
     auto value = object.find(key);
     if (value == object.end()) {
-        return std::nullopt;
+        return nullptr;
     }
     if (!value->second.is_object()) {
         throw LottieParsingException();
     }
-    return value->second.object_items();
+    return &value->second.object_items();
 }
 
-std::vector<lottiejson11::Json::object> getObjectArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
-    auto value = object.find(key);
-    if (value == object.end()) {
+static lottiejson11::Json::array const &validatedObjectArray(lottiejson11::Json const &value) noexcept(false) {
+    if (!value.is_array()) {
         throw LottieParsingException();
     }
-    if (!value->second.is_array()) {
-        throw LottieParsingException();
-    }
-    
-    std::vector<lottiejson11::Json::object> result;
-    for (const auto &item : value->second.array_items()) {
+    for (const auto &item : value.array_items()) {
         if (!item.is_object()) {
             throw LottieParsingException();
         }
-        result.push_back(item.object_items());
     }
-    
-    return result;
+    return value.array_items();
 }
 
-std::optional<std::vector<lottiejson11::Json::object>> getOptionalObjectArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
+lottiejson11::Json::array const &getObjectArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
     auto value = object.find(key);
     if (value == object.end()) {
-        return std::nullopt;
-    }
-    if (!value->second.is_array()) {
         throw LottieParsingException();
     }
-    
-    std::vector<lottiejson11::Json::object> result;
-    for (const auto &item : value->second.array_items()) {
-        if (!item.is_object()) {
-            throw LottieParsingException();
-        }
-        result.push_back(item.object_items());
+    return validatedObjectArray(value->second);
+}
+
+lottiejson11::Json::array const *getOptionalObjectArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
+    auto value = object.find(key);
+    if (value == object.end()) {
+        return nullptr;
     }
-    
-    return result;
+    return &validatedObjectArray(value->second);
 }
 
-std::vector<lottiejson11::Json> getAnyArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
+lottiejson11::Json::array const &getAnyArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
     auto value = object.find(key);
     if (value == object.end()) {
         throw LottieParsingException();
@@ -116,16 +153,16 @@ std::vector<lottiejson11::Json> getAnyArray(lottiejson11::Json::object const &ob
     return value->second.array_items();
 }
 
-std::optional<std::vector<lottiejson11::Json>> getOptionalAnyArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
+lottiejson11::Json::array const *getOptionalAnyArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
     auto value = object.find(key);
     if (value == object.end()) {
-        throw std::nullopt;
+        return nullptr;
     }
     if (!value->second.is_array()) {
         throw LottieParsingException();
     }
     
-    return value->second.array_items();
+    return &value->second.array_items();
 }
 
 std::string getString(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
@@ -194,6 +231,40 @@ std::optional<double> getOptionalDouble(lottiejson11::Json::object const &object
     return value->second.number_value();
 }
 
+lottiejson11::Json readValue(lottiejson11::JsonReader &reader) noexcept(false) {
+    if (!currentParsingStatistics) {
+        return reader.read_value();
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    auto value = reader.read_value();
+    ParsingStatistics::reportJsonParseDuration(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return value;
+}
+
+lottiejson11::Json::object readObject(lottiejson11::JsonReader &reader, std::function<bool(std::string const &key)> const &streamMember) noexcept(false) {
+    if (!reader.begin_object()) {
+        throw LottieParsingException();
+    }
+    
+    lottiejson11::Json::object result;
+    std::string key;
+    while (reader.next_key(key)) {
+        if (!streamMember(key)) {
+            auto value = readValue(reader);
+            if (reader.failed()) {
+                throw LottieParsingException();
+            }
+            result[key] = std::move(value);
+        }
+    }
+    if (reader.failed()) {
+        throw LottieParsingException();
+    }
+    
+    return result;
+}
+
 bool getBool(lottiejson11::Json::object const &object, std::string const &key) noexcept(false) {
     auto value = object.find(key);
     if (value == object.end()) {
@@ -4,6 +4,8 @@
 #include <LottieCpp/lottiejson11.hpp>
 
 #include <exception>
+#include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -23,17 +25,51 @@ public:
     virtual const char* what() const throw();
 };
 
-lottiejson11::Json getAny(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
+/// Load diagnostics for the model parsing code running on the current thread. While a `Scope` is alive,
+/// parsing code reports into its `ParsingStatistics`; with no active scope the report functions do nothing.
+class ParsingStatistics {
+public:
+    class Scope {
+    public:
+        explicit Scope(ParsingStatistics &statistics);
+        ~Scope();
+        
+    private:
+        ParsingStatistics *_previous = nullptr;
+    };
+    
+public:
+    static void reportLayer();
+    static void reportShapeItem();
+    static void reportKeyframes(size_t count);
+    static void reportJsonParseDuration(double duration);
+    /// Adds counts collected on another thread, see `ModelBuildTasks`.
+    static void reportStatistics(ParsingStatistics const &statistics);
+    
+    void add(ParsingStatistics const &statistics);
+    
+public:
+    int layerCount = 0;
+    int shapeItemCount = 0;
+    int keyframeCount = 0;
+    /// Seconds spent turning JSON text into values while streaming, see `readValue`.
+    double jsonParseDuration = 0.0;
+};
+
+/// The accessors below borrow from the DOM instead of copying it: references and pointers stay valid
+/// for as long as the `object` they were obtained from. Optional variants return nullptr when the key is absent.
+lottiejson11::Json const &getAny(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 std::optional<lottiejson11::Json> getOptionalAny(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 
-lottiejson11::Json::object getObject(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
-std::optional<lottiejson11::Json::object> getOptionalObject(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
+lottiejson11::Json::object const &getObject(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
+lottiejson11::Json::object const *getOptionalObject(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 
-std::vector<lottiejson11::Json::object> getObjectArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
-std::optional<std::vector<lottiejson11::Json::object>> getOptionalObjectArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
+/// Every item of the returned array is validated to be an object, read them with `object_items()`.
+lottiejson11::Json::array const &getObjectArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
+lottiejson11::Json::array const *getOptionalObjectArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 
-std::vector<lottiejson11::Json> getAnyArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
-std::optional<std::vector<lottiejson11::Json>> getOptionalAnyArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
+lottiejson11::Json::array const &getAnyArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
+lottiejson11::Json::array const *getOptionalAnyArray(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 
 std::string getString(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 std::optional<std::string> getOptionalString(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
@@ -44,6 +80,13 @@ std::optional<int32_t> getOptionalInt(lottiejson11::Json::object const &object,
 double getDouble(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 std::optional<double> getOptionalDouble(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 
+/// Reads the value `reader` is positioned at, reporting the time spent to the active `ParsingStatistics`.
+lottiejson11::Json readValue(lottiejson11::JsonReader &reader) noexcept(false);
+
+/// Reads the object `reader` is positioned at. Each key is first offered to `streamMember`, which returns true if it
+/// consumed the value from `reader` itself; every other member is materialized into the returned object.
+lottiejson11::Json::object readObject(lottiejson11::JsonReader &reader, std::function<bool(std::string const &key)> const &streamMember) noexcept(false);
+
 bool getBool(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 std::optional<bool> getOptionalBool(lottiejson11::Json::object const &object, std::string const &key) noexcept(false);
 
@@ -0,0 +1,132 @@
+#include "ModelBuildTasks.hpp"
+
+#include "Lottie/Private/Parsing/JsonParsing.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace lottie {
+
+struct ModelBuildTasks::State {
+    struct Entry {
+        std::function<void()> task;
+        bool isClaimed = false;
+    };
+    
+    std::mutex mutex;
+    std::condition_variable completion;
+    std::deque<Entry> entries;
+    size_t completedCount = 0;
+    bool failed = false;
+    /// What the tasks reported, merged into the statistics of the loading thread by `wait()`.
+    ParsingStatistics statistics;
+    
+    /// Runs the task at `index` unless another thread has already claimed it.
+    void run(size_t index) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Entry &entry = entries[index];
+            if (entry.isClaimed) {
+                return;
+            }
+            entry.isClaimed = true;
+            task = std::move(entry.task);
+        }
+        
+        bool taskFailed = false;
+        ParsingStatistics taskStatistics;
+        {
+            ParsingStatistics::Scope scope(taskStatistics);
+            try {
+                task();
+            } catch(...) {
+                taskFailed = true;
+            }
+        }
+        task = nullptr;
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            completedCount++;
+            if (taskFailed) {
+                failed = true;
+            }
+            statistics.add(taskStatistics);
+        }
+        completion.notify_all();
+    }
+    
+    void runRemainingAndWait() {
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            count = entries.size();
+        }
+        for (size_t i = 0; i < count; i++) {
+            run(i);
+        }
+        
+        std::unique_lock<std::mutex> lock(mutex);
+        completion.wait(lock, [&] {
+            return completedCount == entries.size();
+        });
+    }
+};
+
+ModelBuildTasks::ModelBuildTasks(Executor const &executor) :
+_executor(executor),
+_state(std::make_shared<State>()) {
+}
+
+ModelBuildTasks::~ModelBuildTasks() {
+    drain();
+}
+
+void ModelBuildTasks::add(std::function<void()> &&task) {
+    size_t index = 0;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        index = _state->entries.size();
+        _state->entries.emplace_back();
+        _state->entries.back().task = std::move(task);
+    }
+    
+    if (!_executor) {
+        return;
+    }
+    
+    // The executor may run this long after loading finished, so it only holds on to the shared state.
+    // A task the executor refuses stays unclaimed and is picked up by `wait()`.
+    std::shared_ptr<State> state = _state;
+    try {
+        _executor([state, index] {
+            state->run(index);
+        });
+    } catch(...) {
+    }
+}
+
+void ModelBuildTasks::wait() noexcept(false) {
+    drain();
+    
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (_state->failed) {
+        throw LottieParsingException();
+    }
+}
+
+void ModelBuildTasks::drain() {
+    _state->runRemainingAndWait();
+    
+    ParsingStatistics statistics;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        statistics = _state->statistics;
+        _state->statistics = ParsingStatistics();
+    }
+    ParsingStatistics::reportStatistics(statistics);
+}
+
+}
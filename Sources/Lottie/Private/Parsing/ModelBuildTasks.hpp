@@ -0,0 +1,45 @@
+#ifndef ModelBuildTasks_hpp
+#define ModelBuildTasks_hpp
+
+#include <functional>
+#include <memory>
+
+namespace lottie {
+
+/// Builds independent parts of the model on a caller-supplied executor.
+///
+/// Every task is claimed exactly once, either by the executor or by `wait()` on the loading thread, so loading
+/// finishes even if the executor never gets to the tasks it was handed. Each task owns the storage it writes its
+/// result into, and the loading thread only reads that storage once `wait()` has returned.
+class ModelBuildTasks {
+public:
+    typedef std::function<void(std::function<void()> task)> Executor;
+    
+public:
+    explicit ModelBuildTasks(Executor const &executor);
+    /// Waits for outstanding tasks, whose results are discarded if `wait()` was not reached.
+    ~ModelBuildTasks();
+    
+    ModelBuildTasks(ModelBuildTasks const &) = delete;
+    ModelBuildTasks &operator=(ModelBuildTasks const &) = delete;
+    
+    void add(std::function<void()> &&task);
+    
+    /// Runs the tasks no worker has claimed yet on the calling thread, then waits for the rest. What the tasks
+    /// reported to `ParsingStatistics` is added to the statistics active on the calling thread.
+    /// Throws `LottieParsingException` if any task failed.
+    void wait() noexcept(false);
+    
+    /// Waits like `wait()` without reporting failures.
+    void drain();
+    
+private:
+    struct State;
+    
+    Executor _executor;
+    std::shared_ptr<State> _state;
+};
+
+}
+
+#endif /* ModelBuildTasks_hpp */
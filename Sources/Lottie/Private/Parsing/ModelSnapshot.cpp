@@ -0,0 +1,370 @@
+#include "ModelSnapshot.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace lottie {
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Packed float arrays are stored in host byte order");
+#endif
+
+static_assert(sizeof(PathElement) == 6 * sizeof(float), "Path elements are stored as six packed floats");
+static_assert(std::is_trivially_copyable<PathElement>::value, "Path elements are copied with memcpy");
+
+namespace {
+
+enum class SnapshotJsonTag: uint8_t {
+    Null = 0,
+    False = 1,
+    True = 2,
+    Int = 3,
+    Double = 4,
+    String = 5,
+    Array = 6,
+    Object = 7
+};
+
+const uint8_t kSnapshotMagic[4] = { 'L', 'T', 'S', 'N' };
+const int kMaxSnapshotDepth = 200;
+
+bool isInt32(double value) {
+    if (!(value >= (double)std::numeric_limits<int32_t>::min() && value <= (double)std::numeric_limits<int32_t>::max())) {
+        return false;
+    }
+    if ((double)(int32_t)value != value) {
+        return false;
+    }
+    return !(value == 0.0 && std::signbit(value));
+}
+
+}
+
+SnapshotWriter::SnapshotWriter(std::vector<uint8_t> &output) :
+_output(output) {
+    _output.insert(_output.end(), kSnapshotMagic, kSnapshotMagic + 4);
+    for (int i = 0; i < 4; i++) {
+        writeByte((uint8_t)(kModelSnapshotVersion >> (i * 8)));
+    }
+    for (int i = 0; i < 4; i++) {
+        writeByte(0);
+    }
+}
+
+void SnapshotWriter::writeByte(uint8_t value) {
+    _output.push_back(value);
+}
+
+void SnapshotWriter::writeVarint(uint64_t value) {
+    while (value >= 0x80) {
+        writeByte((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    writeByte((uint8_t)value);
+}
+
+void SnapshotWriter::writeBool(bool value) {
+    writeByte(value ? 1 : 0);
+}
+
+void SnapshotWriter::writeInt(int32_t value) {
+    writeVarint(((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+void SnapshotWriter::writeCount(size_t value) {
+    writeVarint(value);
+}
+
+void SnapshotWriter::writeFloat(float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 4; i++) {
+        writeByte((uint8_t)(bits >> (i * 8)));
+    }
+}
+
+void SnapshotWriter::writeDouble(double value) {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++) {
+        writeByte((uint8_t)(bits >> (i * 8)));
+    }
+}
+
+void SnapshotWriter::writeString(std::string const &value) {
+    writeCount(value.size());
+    _output.insert(_output.end(), value.begin(), value.end());
+}
+
+void SnapshotWriter::writeJson(lottiejson11::Json const &value) {
+    switch (value.type()) {
+        case lottiejson11::Json::NUL: {
+            writeByte((uint8_t)SnapshotJsonTag::Null);
+            break;
+        }
+        case lottiejson11::Json::BOOL: {
+            writeByte((uint8_t)(value.bool_value() ? SnapshotJsonTag::True : SnapshotJsonTag::False));
+            break;
+        }
+        case lottiejson11::Json::NUMBER: {
+            if (isInt32(value.number_value())) {
+                writeByte((uint8_t)SnapshotJsonTag::Int);
+                writeInt((int32_t)value.number_value());
+            } else {
+                writeByte((uint8_t)SnapshotJsonTag::Double);
+                writeDouble(value.number_value());
+            }
+            break;
+        }
+        case lottiejson11::Json::STRING: {
+            writeByte((uint8_t)SnapshotJsonTag::String);
+            writeString(value.string_value());
+            break;
+        }
+        case lottiejson11::Json::ARRAY: {
+            writeByte((uint8_t)SnapshotJsonTag::Array);
+            writeCount(value.array_items().size());
+            for (const auto &item : value.array_items()) {
+                writeJson(item);
+            }
+            break;
+        }
+        case lottiejson11::Json::OBJECT: {
+            writeByte((uint8_t)SnapshotJsonTag::Object);
+            writeCount(value.object_items().size());
+            for (const auto &it : value.object_items()) {
+                writeString(it.first);
+                writeJson(it.second);
+            }
+            break;
+        }
+    }
+}
+
+void SnapshotWriter::writeFloats(void const *values, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    while (_output.size() % sizeof(float) != 0) {
+        writeByte(0);
+    }
+    const uint8_t *bytes = (const uint8_t *)values;
+    _output.insert(_output.end(), bytes, bytes + count * sizeof(float));
+}
+
+void SnapshotWriter::writeBezierPath(BezierPath const &value) {
+    write(value.closed());
+    writeCount(value.elements().size());
+    writeFloats(value.elements().data(), value.elements().size() * 6);
+}
+
+void SnapshotWriter::writeGradientColorSet(GradientColorSet const &value) {
+    writeCount(value.colors.size());
+    writeFloats(value.colors.data(), value.colors.size());
+}
+
+SnapshotReader::NestingScope::NestingScope(SnapshotReader &reader) noexcept(false) :
+_reader(reader) {
+    if (_reader._depth >= kMaxSnapshotDepth) {
+        throw LottieParsingException();
+    }
+    _reader._depth++;
+}
+
+SnapshotReader::NestingScope::~NestingScope() {
+    _reader._depth--;
+}
+
+SnapshotReader::SnapshotReader(const void *data, size_t size) noexcept(false) :
+_data((const uint8_t *)data),
+_size(size) {
+    if (!_data || _size < 12 || memcmp(_data, kSnapshotMagic, 4) != 0) {
+        throw LottieParsingException();
+    }
+    if ((uintptr_t)_data % alignof(float) != 0) {
+        _alignedData.resize((_size + sizeof(float) - 1) / sizeof(float));
+        memcpy(_alignedData.data(), _data, _size);
+        _data = (const uint8_t *)_alignedData.data();
+    }
+    _offset = 4;
+    
+    uint32_t version = 0;
+    for (int i = 0; i < 4; i++) {
+        version |= ((uint32_t)readByte()) << (i * 8);
+    }
+    if (version != kModelSnapshotVersion) {
+        throw LottieParsingException();
+    }
+    _offset += 4;
+}
+
+void SnapshotReader::finish() noexcept(false) {
+    if (_offset != _size) {
+        throw LottieParsingException();
+    }
+}
+
+uint8_t SnapshotReader::readByte() noexcept(false) {
+    if (_offset >= _size) {
+        throw LottieParsingException();
+    }
+    return _data[_offset++];
+}
+
+uint64_t SnapshotReader::readVarint() noexcept(false) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = readByte();
+        value |= ((uint64_t)(byte & 0x7f)) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw LottieParsingException();
+}
+
+bool SnapshotReader::readBool() noexcept(false) {
+    uint8_t value = readByte();
+    if (value > 1) {
+        throw LottieParsingException();
+    }
+    return value != 0;
+}
+
+int32_t SnapshotReader::readInt() noexcept(false) {
+    uint64_t encoded = readVarint();
+    if (encoded > 0xffffffffull) {
+        throw LottieParsingException();
+    }
+    uint32_t zigzag = (uint32_t)encoded;
+    return (int32_t)((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+}
+
+size_t SnapshotReader::readCount() noexcept(false) {
+    uint64_t value = readVarint();
+    if (value > _size - _offset) {
+        throw LottieParsingException();
+    }
+    return (size_t)value;
+}
+
+float SnapshotReader::readFloat() noexcept(false) {
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; i++) {
+        bits |= ((uint32_t)readByte()) << (i * 8);
+    }
+    float value = 0.0f;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+double SnapshotReader::readDouble() noexcept(false) {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+        bits |= ((uint64_t)readByte()) << (i * 8);
+    }
+    double value = 0.0;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string SnapshotReader::readString() noexcept(false) {
+    size_t length = readCount();
+    std::string result((const char *)_data + _offset, length);
+    _offset += length;
+    return result;
+}
+
+lottiejson11::Json SnapshotReader::readJson() noexcept(false) {
+    NestingScope nestingScope(*this);
+    
+    switch ((SnapshotJsonTag)readByte()) {
+        case SnapshotJsonTag::Null: {
+            return lottiejson11::Json();
+        }
+        case SnapshotJsonTag::False: {
+            return lottiejson11::Json(false);
+        }
+        case SnapshotJsonTag::True: {
+            return lottiejson11::Json(true);
+        }
+        case SnapshotJsonTag::Int: {
+            return lottiejson11::Json((int)readInt());
+        }
+        case SnapshotJsonTag::Double: {
+            return lottiejson11::Json(readDouble());
+        }
+        case SnapshotJsonTag::String: {
+            return lottiejson11::Json(readString());
+        }
+        case SnapshotJsonTag::Array: {
+            size_t count = readCount();
+            lottiejson11::Json::array result;
+            result.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                result.push_back(readJson());
+            }
+            return lottiejson11::Json(std::move(result));
+        }
+        case SnapshotJsonTag::Object: {
+            size_t count = readCount();
+            lottiejson11::Json::object result;
+            for (size_t i = 0; i < count; i++) {
+                auto key = readString();
+                auto value = readJson();
+                result[std::move(key)] = std::move(value);
+            }
+            return lottiejson11::Json(std::move(result));
+        }
+    }
+    throw LottieParsingException();
+}
+
+float const *SnapshotReader::readFloats(size_t count) noexcept(false) {
+    if (count == 0) {
+        return nullptr;
+    }
+    while (_offset % sizeof(float) != 0) {
+        if (readByte() != 0) {
+            throw LottieParsingException();
+        }
+    }
+    if ((_size - _offset) / sizeof(float) < count) {
+        throw LottieParsingException();
+    }
+    const float *result = (const float *)(_data + _offset);
+    _offset += count * sizeof(float);
+    return result;
+}
+
+BezierPath SnapshotReader::readBezierPath() noexcept(false) {
+    BezierPath result;
+    result.setClosed(readOptional<bool>());
+    
+    size_t count = readCount();
+    const float *values = readFloats(count * 6);
+    
+    auto &elements = result.mutableElements();
+    elements.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const float *element = values + i * 6;
+        elements.emplace_back(CurveVertex::absolute(
+            Vector2D(element[0], element[1]),
+            Vector2D(element[2], element[3]),
+            Vector2D(element[4], element[5])
+        ));
+    }
+    
+    return result;
+}
+
+GradientColorSet SnapshotReader::readGradientColorSet() noexcept(false) {
+    size_t count = readCount();
+    const float *values = readFloats(count);
+    
+    return GradientColorSet(std::vector<float>(values, values + count));
+}
+
+}
@@ -0,0 +1,322 @@
+#ifndef ModelSnapshot_hpp
+#define ModelSnapshot_hpp
+
+#include <LottieCpp/lottiejson11.hpp>
+#include <LottieCpp/Vectors.h>
+#include <LottieCpp/Color.h>
+#include <LottieCpp/BezierPath.h>
+#include "Lottie/Public/Primitives/GradientColorSet.hpp"
+#include "Lottie/Private/Parsing/JsonParsing.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace lottie {
+
+/// Version written by `SnapshotWriter`. Bump whenever the snapshot of any model changes; readers reject every other version.
+constexpr uint32_t kModelSnapshotVersion = 2;
+
+/// Keyframe values stored as fixed-size float tuples. `KeyframeGroup` writes the values of all of its keyframes
+/// as one packed array for these types and falls back to writing them one by one for everything else.
+template<typename T>
+struct SnapshotPackedValue {
+    static constexpr size_t floatCount = 0;
+};
+
+template<>
+struct SnapshotPackedValue<Vector1D> {
+    static constexpr size_t floatCount = 1;
+    
+    static void pack(Vector1D const &value, float *result) {
+        result[0] = value.value;
+    }
+    
+    static Vector1D unpack(float const *values) {
+        return Vector1D(values[0]);
+    }
+};
+
+template<>
+struct SnapshotPackedValue<Vector2D> {
+    static constexpr size_t floatCount = 2;
+    
+    static void pack(Vector2D const &value, float *result) {
+        result[0] = value.x;
+        result[1] = value.y;
+    }
+    
+    static Vector2D unpack(float const *values) {
+        return Vector2D(values[0], values[1]);
+    }
+};
+
+template<>
+struct SnapshotPackedValue<Vector3D> {
+    static constexpr size_t floatCount = 3;
+    
+    static void pack(Vector3D const &value, float *result) {
+        result[0] = value.x;
+        result[1] = value.y;
+        result[2] = value.z;
+    }
+    
+    static Vector3D unpack(float const *values) {
+        return Vector3D(values[0], values[1], values[2]);
+    }
+};
+
+template<>
+struct SnapshotPackedValue<Color> {
+    static constexpr size_t floatCount = 4;
+    
+    static void pack(Color const &value, float *result) {
+        result[0] = value.r;
+        result[1] = value.g;
+        result[2] = value.b;
+        result[3] = value.a;
+    }
+    
+    static Color unpack(float const *values) {
+        return Color(values[0], values[1], values[2], values[3]);
+    }
+};
+
+template<typename T>
+struct IsSnapshotVector: std::false_type {
+};
+
+template<typename T>
+struct IsSnapshotVector<std::vector<T>>: std::true_type {
+};
+
+template<typename T>
+struct IsSnapshotSharedPtr: std::false_type {
+};
+
+template<typename T>
+struct IsSnapshotSharedPtr<std::shared_ptr<T>>: std::true_type {
+};
+
+/// Writes the binary snapshot of a model tree, see `Renderer::makeSnapshot`.
+///
+/// A snapshot starts with a header (magic "LTSN", u32 version, u32 reserved) and then holds the fields of each model
+/// in declaration order, without keys. Every model implements `writeSnapshot(SnapshotWriter &)` and a constructor
+/// taking a `SnapshotReader &` that reads the same fields back; type tags are only written where the reader has to
+/// pick a subclass. Integers are zigzag varints, floats and doubles raw little-endian IEEE-754 values.
+///
+/// Bulk data (keyframe times and values, path elements, gradient stops) is written with `writeFloats`, as packed
+/// float arrays that start at a 4-byte aligned offset from the beginning of the snapshot. A snapshot loaded at a 4-byte
+/// aligned address, such as the vector returned by `Renderer::makeSnapshot` or a memory-mapped file, can therefore be
+/// read as floats in place.
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<uint8_t> &output);
+    
+    void writeBool(bool value);
+    void writeInt(int32_t value);
+    void writeCount(size_t value);
+    void writeFloat(float value);
+    void writeDouble(double value);
+    void writeString(std::string const &value);
+    
+    /// For the fields that the models keep as raw JSON (expressions, effects, metadata).
+    void writeJson(lottiejson11::Json const &value);
+    
+    /// Writes `count` floats read from `values`. The count itself is not written, the caller stores whatever the
+    /// reader needs to know it in advance. An empty array takes no space, not even padding.
+    void writeFloats(void const *values, size_t count);
+    
+    void writeBezierPath(BezierPath const &value);
+    void writeGradientColorSet(GradientColorSet const &value);
+    
+    template<typename T>
+    void write(T const &value) {
+        static_assert(!std::is_enum<T>::value, "Use writeEnum");
+        
+        if constexpr (std::is_same<T, bool>::value) {
+            writeBool(value);
+        } else if constexpr (std::is_same<T, int>::value) {
+            writeInt(value);
+        } else if constexpr (std::is_same<T, float>::value) {
+            writeFloat(value);
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            writeString(value);
+        } else if constexpr (std::is_same<T, lottiejson11::Json>::value) {
+            writeJson(value);
+        } else if constexpr (SnapshotPackedValue<T>::floatCount != 0) {
+            float values[SnapshotPackedValue<T>::floatCount];
+            SnapshotPackedValue<T>::pack(value, values);
+            for (size_t i = 0; i < SnapshotPackedValue<T>::floatCount; i++) {
+                writeFloat(values[i]);
+            }
+        } else if constexpr (std::is_same<T, BezierPath>::value) {
+            writeBezierPath(value);
+        } else if constexpr (std::is_same<T, GradientColorSet>::value) {
+            writeGradientColorSet(value);
+        } else if constexpr (IsSnapshotVector<T>::value) {
+            writeCount(value.size());
+            for (const auto &item : value) {
+                write(item);
+            }
+        } else if constexpr (IsSnapshotSharedPtr<T>::value) {
+            value->writeSnapshot(*this);
+        } else {
+            value.writeSnapshot(*this);
+        }
+    }
+    
+    template<typename T>
+    void write(std::optional<T> const &value) {
+        writeBool(value.has_value());
+        if (value.has_value()) {
+            write(value.value());
+        }
+    }
+    
+    template<typename E>
+    void writeEnum(E value) {
+        writeInt((int32_t)value);
+    }
+    
+    template<typename E>
+    void writeEnum(std::optional<E> const &value) {
+        writeBool(value.has_value());
+        if (value.has_value()) {
+            writeEnum(value.value());
+        }
+    }
+
+private:
+    void writeByte(uint8_t value);
+    void writeVarint(uint64_t value);
+
+private:
+    std::vector<uint8_t> &_output;
+};
+
+/// Reads a snapshot written by `SnapshotWriter`. The buffer is only borrowed for the lifetime of the reader, so it
+/// may point into a memory-mapped file; a buffer that is not 4-byte aligned is copied once into aligned storage
+/// instead. Malformed input, including counts that exceed the remaining bytes and out-of-range enum values, throws
+/// `LottieParsingException`.
+class SnapshotReader {
+public:
+    /// Limits the recursion of nested models (shape groups) and of raw JSON values.
+    class NestingScope {
+    public:
+        explicit NestingScope(SnapshotReader &reader) noexcept(false);
+        ~NestingScope();
+    
+    private:
+        SnapshotReader &_reader;
+    };
+
+public:
+    /// Validates the header.
+    SnapshotReader(const void *data, size_t size) noexcept(false);
+    
+    /// Throws unless every byte of the snapshot has been read.
+    void finish() noexcept(false);
+    
+    bool readBool() noexcept(false);
+    int32_t readInt() noexcept(false);
+    /// Reads an element count; every element takes at least one byte, so it can never exceed what is left.
+    size_t readCount() noexcept(false);
+    float readFloat() noexcept(false);
+    double readDouble() noexcept(false);
+    std::string readString() noexcept(false);
+    lottiejson11::Json readJson() noexcept(false);
+    
+    /// Returns `count` floats written by `writeFloats`, borrowed from the snapshot buffer. The pointer is always
+    /// aligned, so the values can be read in place.
+    float const *readFloats(size_t count) noexcept(false);
+    
+    BezierPath readBezierPath() noexcept(false);
+    GradientColorSet readGradientColorSet() noexcept(false);
+    
+    template<typename T>
+    T read() noexcept(false) {
+        static_assert(!std::is_enum<T>::value, "Use readEnum");
+        
+        if constexpr (std::is_same<T, bool>::value) {
+            return readBool();
+        } else if constexpr (std::is_same<T, int>::value) {
+            return readInt();
+        } else if constexpr (std::is_same<T, float>::value) {
+            return readFloat();
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            return readString();
+        } else if constexpr (std::is_same<T, lottiejson11::Json>::value) {
+            return readJson();
+        } else if constexpr (SnapshotPackedValue<T>::floatCount != 0) {
+            float values[SnapshotPackedValue<T>::floatCount];
+            for (size_t i = 0; i < SnapshotPackedValue<T>::floatCount; i++) {
+                values[i] = readFloat();
+            }
+            return SnapshotPackedValue<T>::unpack(values);
+        } else if constexpr (std::is_same<T, BezierPath>::value) {
+            return readBezierPath();
+        } else if constexpr (std::is_same<T, GradientColorSet>::value) {
+            return readGradientColorSet();
+        } else if constexpr (IsSnapshotVector<T>::value) {
+            size_t count = readCount();
+            T result;
+            result.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                result.push_back(read<typename T::value_type>());
+            }
+            return result;
+        } else if constexpr (IsSnapshotSharedPtr<T>::value) {
+            return std::make_shared<typename T::element_type>(*this);
+        } else {
+            return T(*this);
+        }
+    }
+    
+    template<typename T>
+    std::optional<T> readOptional() noexcept(false) {
+        if (readBool()) {
+            return read<T>();
+        } else {
+            return std::nullopt;
+        }
+    }
+    
+    /// Reads an enum written by `writeEnum`, rejecting raw values outside of [first, last].
+    template<typename E>
+    E readEnum(E first, E last) noexcept(false) {
+        int32_t rawValue = readInt();
+        if (rawValue < (int32_t)first || rawValue > (int32_t)last) {
+            throw LottieParsingException();
+        }
+        return (E)rawValue;
+    }
+    
+    template<typename E>
+    std::optional<E> readOptionalEnum(E first, E last) noexcept(false) {
+        if (readBool()) {
+            return readEnum(first, last);
+        } else {
+            return std::nullopt;
+        }
+    }
+
+private:
+    uint8_t readByte() noexcept(false);
+    uint64_t readVarint() noexcept(false);
+
+private:
+    const uint8_t *_data = nullptr;
+    size_t _size = 0;
+    std::vector<float> _alignedData;
+    size_t _offset = 0;
+    int _depth = 0;
+};
+
+}
+
+#endif /* ModelSnapshot_hpp */
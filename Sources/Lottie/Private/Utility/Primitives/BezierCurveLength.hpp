@@ -0,0 +1,16 @@
+#ifndef BezierCurveLength_hpp
+#define BezierCurveLength_hpp
+
+#include <LottieCpp/Vectors.h>
+
+namespace lottie {
+
+/// The arc length of the cubic bezier curve defined by `from`, `control1`, `control2` and `to`.
+///
+/// The length is integrated with Gauss-Legendre quadrature. Spans where the estimate does not settle, such as cusps
+/// and sharp turns, are split in half and integrated again, so the result is accurate to a small fraction of a point.
+float bezierCurveLength(Vector2D const &from, Vector2D const &control1, Vector2D const &control2, Vector2D const &to);
+
+}
+
+#endif /* BezierCurveLength_hpp */
@@ -1,10 +1,15 @@
 #include <LottieCpp/BezierPath.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
 #if __APPLE__
 #include <Accelerate/Accelerate.h>
 #endif
 
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
+#include "Lottie/Private/Utility/Primitives/PathKernels.hpp"
 
 namespace lottie {
 
@@ -13,17 +18,25 @@ start(start_),
 end(end_) {
 }
 
+static uint64_t makeBezierPathContentsId() {
+    static std::atomic<uint64_t> nextId(1);
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
 BezierPathContents::BezierPathContents(CurveVertex const &startPoint) :
-elements({ PathElement(startPoint) }) {
+elements({ PathElement(startPoint) }),
+id(makeBezierPathContentsId()) {
 }
     
 BezierPathContents::BezierPathContents() :
 elements({}),
-closed(false) {
+closed(false),
+id(makeBezierPathContentsId()) {
 }
 
 BezierPathContents::BezierPathContents(lottiejson11::Json const &jsonAny) noexcept(false) :
-elements({}) {
+elements({}),
+id(makeBezierPathContentsId()) {
     lottiejson11::Json::object const *json = nullptr;
     if (jsonAny.is_object()) {
         json = &jsonAny.object_items();
@@ -41,9 +54,9 @@ elements({}) {
         closed = closedData.value();
     }
     
-    auto vertexContainer = getAnyArray(*json, "v");
-    auto inPointsContainer = getAnyArray(*json, "i");
-    auto outPointsContainer = getAnyArray(*json, "o");
+    auto const &vertexContainer = getAnyArray(*json, "v");
+    auto const &inPointsContainer = getAnyArray(*json, "i");
+    auto const &outPointsContainer = getAnyArray(*json, "o");
     
     if (vertexContainer.size() != inPointsContainer.size() || inPointsContainer.size() != outPointsContainer.size()) {
         throw LottieParsingException();
@@ -91,10 +104,24 @@ lottiejson11::Json BezierPathContents::toJson() const {
     lottiejson11::Json::array inPoints;
     lottiejson11::Json::array outPoints;
     
-    for (const auto &element : elements) {
-        vertices.push_back(element.vertex.point.toJson());
-        inPoints.push_back(element.vertex.inTangentRelative().toJson());
-        outPoints.push_back(element.vertex.outTangentRelative().toJson());
+    /// A closed path ends with the element that leads back to the first vertex, which the parser synthesizes.
+    size_t vertexCount = elements.size();
+    if (closed.value_or(false) && vertexCount > 1) {
+        vertexCount--;
+    }
+    
+    auto pointJson = [](Vector2D const &point) {
+        lottiejson11::Json::array result;
+        result.push_back(point.x);
+        result.push_back(point.y);
+        return lottiejson11::Json(std::move(result));
+    };
+    
+    for (size_t i = 0; i < vertexCount; i++) {
+        const auto &element = elements[i];
+        vertices.push_back(pointJson(element.vertex.point));
+        inPoints.push_back(pointJson(element.vertex.inTangentRelative()));
+        outPoints.push_back(pointJson(element.vertex.outTangentRelative()));
     }
     
     result.insert(std::make_pair("v", vertices));
@@ -130,22 +157,66 @@ lottiejson11::Json BezierPathContents::toJson() const {
     return cgPath;
 }*/
 
+std::shared_ptr<BezierPathContents> BezierPathContents::copy() const {
+    auto result = std::make_shared<BezierPathContents>();
+    result->elements = elements;
+    result->closed = closed;
+    result->generation = generation;
+    
+    std::lock_guard<std::mutex> lock(_measureMutex);
+    result->_length = _length;
+    result->_elementLengths = _elementLengths;
+    result->_cumulativeLengths = _cumulativeLengths;
+    result->_measuredGeneration = _measuredGeneration;
+    return result;
+}
+
 float BezierPathContents::length() {
-    if (_length.has_value()) {
-        return _length.value();
-    } else {
-        float result = 0.0;
-        for (size_t i = 1; i < elements.size(); i++) {
-            result += elements[i].length(elements[i - 1]);
+    std::lock_guard<std::mutex> lock(_measureMutex);
+    measureIfNeeded();
+    return _length.value();
+}
+
+float BezierPathContents::elementLength(size_t index) {
+    std::lock_guard<std::mutex> lock(_measureMutex);
+    measureIfNeeded();
+    return _elementLengths[index];
+}
+
+float BezierPathContents::lengthToElement(size_t index) {
+    std::lock_guard<std::mutex> lock(_measureMutex);
+    measureIfNeeded();
+    return _cumulativeLengths[index];
+}
+
+void BezierPathContents::measureIfNeeded() {
+    if (_length.has_value() && _measuredGeneration == generation && _cumulativeLengths.size() == elements.size()) {
+        return;
+    }
+    
+    _elementLengths.resize(elements.size());
+    _cumulativeLengths.resize(elements.size());
+    float result = 0.0;
+    for (size_t i = 0; i < elements.size(); i++) {
+        float elementLength = 0.0;
+        if (i != 0) {
+            elementLength = elements[i].length(elements[i - 1]);
         }
-        _length = result;
-        return result;
+        result += elementLength;
+        _elementLengths[i] = elementLength;
+        _cumulativeLengths[i] = result;
     }
+    _length = result;
+    _measuredGeneration = generation;
 }
 
 void BezierPathContents::moveToStartPoint(CurveVertex const &vertex) {
     elements = { PathElement(vertex) };
+    
+    std::lock_guard<std::mutex> lock(_measureMutex);
     _length = std::nullopt;
+    _elementLengths.clear();
+    _cumulativeLengths.clear();
 }
 
 void BezierPathContents::addVertex(CurveVertex const &vertex) {
@@ -161,7 +232,10 @@ void BezierPathContents::setElementCount(size_t count) {
 }
 
 void BezierPathContents::invalidateLength() {
+    std::lock_guard<std::mutex> lock(_measureMutex);
     _length.reset();
+    _elementLengths.clear();
+    _cumulativeLengths.clear();
 }
 
 void BezierPathContents::addCurve(Vector2D const &toPoint, Vector2D const &outTangent, Vector2D const &inTangent) {
@@ -287,13 +361,43 @@ std::vector<std::shared_ptr<BezierPathContents>> BezierPathContents::trimPathAtL
     
     float runningLength = 0.0;
     bool finishedTrimming = false;
-    auto pathElements = elements;
+    
+    /// Splitting a span replaces the two elements around it. Only the span of the last split can be visited again, so
+    /// its elements are kept aside instead of copying the path, and all other spans keep their measured lengths.
+    int splitIndex = -1;
+    std::optional<PathElement> splitStart;
+    std::optional<PathElement> splitEnd;
+    auto elementAt = [&](int index) -> PathElement const & {
+        if (index == splitIndex) {
+            return splitEnd.value();
+        } else if (index == splitIndex - 1) {
+            return splitStart.value();
+        } else {
+            return elements[index];
+        }
+    };
+    
+    lengthToElement(0);
+    std::vector<float> const &elementLengths = _elementLengths;
+    std::vector<float> const &cumulativeLengths = _cumulativeLengths;
     
     auto currentPath = std::make_shared<BezierPathContents>();
     int i = 0;
     
     while (!finishedTrimming) {
-        if (pathElements.size() <= i) {
+        if (currentPath->elements.size() == 0 && i != splitIndex && i < elements.size() && runningLength == (i == 0 ? 0.0f : cumulativeLengths[i - 1])) {
+            /// Skip the elements that end before the trim starts with a binary search of the measured lengths. The
+            /// prefix sums are the running lengths the walk below would compute, so this only applies until a split
+            /// moves the running length away from them.
+            auto firstIncluded = std::lower_bound(cumulativeLengths.begin() + i, cumulativeLengths.end(), trim.start);
+            int firstIncludedIndex = (int)(firstIncluded - cumulativeLengths.begin());
+            if (firstIncludedIndex > i) {
+                runningLength = cumulativeLengths[firstIncludedIndex - 1];
+                i = firstIncludedIndex;
+            }
+        }
+        
+        if (elements.size() <= i) {
             /// Do this for rounding errors
             paths.push_back(currentPath);
             finishedTrimming = true;
@@ -301,10 +405,12 @@ std::vector<std::shared_ptr<BezierPathContents>> BezierPathContents::trimPathAtL
         }
         /// Loop through and add elements within start->end range.
         /// Get current element
-        auto element = pathElements[i];
+        auto element = elementAt(i);
         float elementLength = 0.0;
-        if (i != 0) {
-            elementLength = element.length(pathElements[i - 1]);
+        if (i == splitIndex) {
+            elementLength = element.length(elementAt(i - 1));
+        } else {
+            elementLength = elementLengths[i];
         }
         
         /// Calculate new running length.
@@ -331,15 +437,16 @@ std::vector<std::shared_ptr<BezierPathContents>> BezierPathContents::trimPathAtL
         if (runningLength < trim.start && trim.start < newLength && currentPath->elements.size() == 0) {
             /// The start of the trim is between this element and the previous, trim.
             /// Get previous element.
-            auto previousElement = pathElements[i - 1];
+            auto previousElement = elementAt(i - 1);
             /// Trim it
             auto trimLength = trim.start - runningLength;
             auto trimResults = element.splitElementAtPosition(previousElement, trimLength);
             /// Add the right span start.
             currentPath->moveToStartPoint(trimResults.rightSpan.start.vertex);
             
-            pathElements[i] = trimResults.rightSpan.end;
-            pathElements[i - 1] = trimResults.rightSpan.start;
+            splitIndex = i;
+            splitEnd = trimResults.rightSpan.end;
+            splitStart = trimResults.rightSpan.start;
             runningLength = runningLength + trimResults.leftSpan.end.length(trimResults.leftSpan.start);
             /// Dont increment index or the current length, the end of this path can be within this span.
             continue;
@@ -367,7 +474,7 @@ std::vector<std::shared_ptr<BezierPathContents>> BezierPathContents::trimPathAtL
         if (runningLength < trim.end && trim.end < newLength) {
             /// New element must be cut for end.
             /// Get previous element.
-            auto previousElement = pathElements[i - 1];
+            auto previousElement = elementAt(i - 1);
             /// Trim it
             auto trimLength = trim.end - runningLength;
             auto trimResults = element.splitElementAtPosition(previousElement, trimLength);
@@ -376,8 +483,9 @@ std::vector<std::shared_ptr<BezierPathContents>> BezierPathContents::trimPathAtL
             currentPath->updateVertex(trimResults.leftSpan.start.vertex, (int)currentPath->elements.size() - 1, false);
             currentPath->addElement(trimResults.leftSpan.end);
             
-            pathElements[i] = trimResults.rightSpan.end;
-            pathElements[i - 1] = trimResults.rightSpan.start;
+            splitIndex = i;
+            splitEnd = trimResults.rightSpan.end;
+            splitStart = trimResults.rightSpan.start;
             runningLength = runningLength + trimResults.leftSpan.end.length(trimResults.leftSpan.start);
             /// Dont increment index or the current length, the start of the next path can be within this span.
             /// We are done with this span.
@@ -418,43 +526,43 @@ float BezierPath::length() {
 }
 
 void BezierPath::moveToStartPoint(CurveVertex const &vertex) {
-    _contents->moveToStartPoint(vertex);
+    mutableContents().moveToStartPoint(vertex);
 }
 
 void BezierPath::addVertex(CurveVertex const &vertex) {
-    _contents->addVertex(vertex);
+    mutableContents().addVertex(vertex);
 }
 
 void BezierPath::reserveCapacity(size_t capacity) {
-    _contents->reserveCapacity(capacity);
+    mutableContents().reserveCapacity(capacity);
 }
 
 void BezierPath::setElementCount(size_t count) {
-    _contents->setElementCount(count);
+    mutableContents().setElementCount(count);
 }
 
 void BezierPath::invalidateLength() {
-    _contents->invalidateLength();
+    mutableContents().invalidateLength();
 }
 
 void BezierPath::addCurve(Vector2D const &toPoint, Vector2D const &outTangent, Vector2D const &inTangent) {
-    _contents->addCurve(toPoint, outTangent, inTangent);
+    mutableContents().addCurve(toPoint, outTangent, inTangent);
 }
 
 void BezierPath::addLine(Vector2D const &toPoint) {
-    _contents->addLine(toPoint);
+    mutableContents().addLine(toPoint);
 }
 
 void BezierPath::close() {
-    _contents->close();
+    mutableContents().close();
 }
 
 void BezierPath::addElement(PathElement const &pathElement) {
-    _contents->addElement(pathElement);
+    mutableContents().addElement(pathElement);
 }
 
 void BezierPath::updateVertex(CurveVertex const &vertex, int atIndex, bool remeasure) {
-    _contents->updateVertex(vertex, atIndex, remeasure);
+    mutableContents().updateVertex(vertex, atIndex, remeasure);
 }
 
 std::vector<BezierPath> BezierPath::trim(float fromLength, float toLength, float offsetLength) {
@@ -462,7 +570,7 @@ std::vector<BezierPath> BezierPath::trim(float fromLength, float toLength, float
     
     auto resultContents = _contents->trim(fromLength, toLength, offsetLength);
     for (const auto &resultContent : resultContents) {
-        result.emplace_back(resultContent);
+        result.push_back(BezierPath(resultContent));
     }
     
     return result;
@@ -473,14 +581,14 @@ std::vector<PathElement> const &BezierPath::elements() const {
 }
 
 std::vector<PathElement> &BezierPath::mutableElements() {
-    return _contents->elements;
+    return mutableContents().elements;
 }
 
 std::optional<bool> const &BezierPath::closed() const {
     return _contents->closed;
 }
 void BezierPath::setClosed(std::optional<bool> const &closed) {
-    _contents->closed = closed;
+    mutableContents().closed = closed;
 }
 
 /*std::shared_ptr<CGPath> BezierPath::cgPath() const {
@@ -493,10 +601,78 @@ BezierPath BezierPath::copyUsingTransform(Transform2D const &transform) const {
     }
     BezierPath result;
     result._contents->closed = _contents->closed;
-    result.reserveCapacity(_contents->elements.size());
-    for (const auto &element : _contents->elements) {
-        result._contents->elements.emplace_back(element.vertex.transformed(transform));
+    result._contents->setElementCount(_contents->elements.size());
+    
+    /// Every element is three absolute points (point, in tangent, out tangent), all transformed alike.
+    float matrix[6];
+    pathKernelsMatrix(transform, matrix);
+    PathKernels::current().transformPoints(
+        pathElementFloats(_contents->elements.data()),
+        pathElementFloats(result._contents->elements.data()),
+        (int)_contents->elements.size() * 3,
+        matrix
+    );
+    return result;
+}
+
+/// Curves are split into at most this many segments, which bounds the work spent on huge or degenerate curves.
+static const int maxFlattenedCurveSegments = 1024;
+
+void BezierPath::flatten(float tolerance, float scale, FlattenedBezierPath &result) const {
+    result.points.clear();
+    result.closed = _contents->closed.value_or(true);
+    
+    auto const &elements = _contents->elements;
+    if (elements.empty()) {
+        return;
+    }
+    result.points.push_back(elements[0].vertex.point);
+    
+    /// A cubic split into `n` equal parameter steps stays within `3 / 4 * M / n^2` of its chords (Wang's formula), where
+    /// `M` is the largest second difference of its control points.
+    float segmentFactor = 0.75f * scale / tolerance;
+    for (size_t i = 1; i < elements.size(); i++) {
+        CurveVertex const &previous = elements[i - 1].vertex;
+        CurveVertex const &current = elements[i].vertex;
+        if (previous.outTangentRelative().isZero() && current.inTangentRelative().isZero()) {
+            result.points.push_back(current.point);
+            continue;
+        }
+        
+        Vector2D p0 = previous.point;
+        Vector2D p1 = previous.outTangent;
+        Vector2D p2 = current.inTangent;
+        Vector2D p3 = current.point;
+        Vector2D d1 = p0 - p1 * 2.0f + p2;
+        Vector2D d2 = p1 - p2 * 2.0f + p3;
+        float secondDifference = sqrtf(std::max(d1.x * d1.x + d1.y * d1.y, d2.x * d2.x + d2.y * d2.y));
+        float steps = sqrtf(secondDifference * segmentFactor);
+        int segmentCount = maxFlattenedCurveSegments;
+        if (steps < (float)maxFlattenedCurveSegments) {
+            segmentCount = std::max(1, (int)ceilf(steps));
+        }
+        
+        float step = 1.0f / (float)segmentCount;
+        for (int j = 1; j < segmentCount; j++) {
+            float t = (float)j * step;
+            float u = 1.0f - t;
+            float w0 = u * u * u;
+            float w1 = 3.0f * u * u * t;
+            float w2 = 3.0f * u * t * t;
+            float w3 = t * t * t;
+            result.points.push_back(Vector2D(
+                p0.x * w0 + p1.x * w1 + p2.x * w2 + p3.x * w3,
+                p0.y * w0 + p1.y * w1 + p2.y * w2 + p3.y * w3
+            ));
+        }
+        result.points.push_back(p3);
     }
+}
+
+BezierPathCacheKey BezierPath::cacheKey() const {
+    BezierPathCacheKey result;
+    result.pathId = _contents->id;
+    result.generation = _contents->generation;
     return result;
 }
 
@@ -504,6 +680,14 @@ BezierPath::BezierPath(std::shared_ptr<BezierPathContents> contents) :
 _contents(contents) {
 }
 
+BezierPathContents &BezierPath::mutableContents() {
+    if (_contents.use_count() > 1) {
+        _contents = _contents->copy();
+    }
+    _contents->generation++;
+    return *_contents;
+}
+
 BezierPathsBoundingBoxContext::BezierPathsBoundingBoxContext() :
 pointsX((float *)malloc(1024 * 4)),
 pointsY((float *)malloc(1024 * 4)),
@@ -513,6 +697,7 @@ pointsSize(1024) {
 BezierPathsBoundingBoxContext::~BezierPathsBoundingBoxContext() {
     free(pointsX);
     free(pointsY);
+    free(curveValues);
 }
 
 static CGRect calculateBoundingRectOpt(float const *pointsX, float const *pointsY, int count) {
@@ -529,19 +714,15 @@ static CGRect calculateBoundingRectOpt(float const *pointsX, float const *points
     
     return CGRect(minX, minY, maxX - minX, maxY - minY);
 #else
-    float minX = pointsX[0];
-    float maxX = pointsX[0];
-    for (int i = 0; i < count; i++) {
-        minX = std::min(minX, pointsX[i]);
-        maxX = std::max(maxX, pointsX[i]);
-    }
+    PathKernels const &kernels = PathKernels::current();
     
-    float minY = pointsY[0];
-    float maxY = pointsY[0];
-    for (int i = 0; i < count; i++) {
-        minY = std::min(minY, pointsY[i]);
-        maxY = std::max(maxY, pointsY[i]);
-    }
+    float minX = 0.0;
+    float maxX = 0.0;
+    kernels.minMax(pointsX, count, minX, maxX);
+    
+    float minY = 0.0;
+    float maxY = 0.0;
+    kernels.minMax(pointsY, count, minY, maxY);
     
     return CGRect(minX, minY, maxX - minX, maxY - minY);
 #endif
@@ -653,6 +834,71 @@ CGRect bezierPathsBoundingBoxParallel(BezierPathsBoundingBoxContext &context, Be
     return calculateBoundingRectOpt(pointsX, pointsY, pointCount);
 }
 
+CGRect bezierPathsExactBoundingBox(BezierPathsBoundingBoxContext &context, BezierPath const &path) {
+    PathElement const *pathElements = path.elements().data();
+    int pathElementCount = (int)path.elements().size();
+    
+    if (pathElementCount == 0) {
+        return CGRect(0.0, 0.0, 0.0, 0.0);
+    }
+    
+    int curveCount = 0;
+    for (int i = 1; i < pathElementCount; i++) {
+        if (!(pathElements[i - 1].vertex.outTangentRelative().isZero() && pathElements[i].vertex.inTangentRelative().isZero())) {
+            curveCount++;
+        }
+    }
+    
+    /// The end points of all spans, followed by two extrema candidates per curve.
+    int pointCount = pathElementCount + curveCount * 2;
+    if (context.pointsSize < pointCount) {
+        context.pointsSize = pointCount * 2;
+        context.pointsX = (float *)realloc(context.pointsX, context.pointsSize * 4);
+        context.pointsY = (float *)realloc(context.pointsY, context.pointsSize * 4);
+    }
+    /// The four control values of every curve, each in its own block, first for x and then for y.
+    if (context.curveValuesSize < curveCount * 8) {
+        context.curveValuesSize = curveCount * 8 * 2;
+        context.curveValues = (float *)realloc(context.curveValues, context.curveValuesSize * 4);
+    }
+    
+    float *pointsX = context.pointsX;
+    float *pointsY = context.pointsY;
+    float *curveValuesX = context.curveValues;
+    float *curveValuesY = context.curveValues + curveCount * 4;
+    
+    int curveIndex = 0;
+    for (int i = 0; i < pathElementCount; i++) {
+        const auto &element = pathElements[i];
+        pointsX[i] = element.vertex.point.x;
+        pointsY[i] = element.vertex.point.y;
+        
+        if (i != 0) {
+            const auto &previousElement = pathElements[i - 1];
+            if (previousElement.vertex.outTangentRelative().isZero() && element.vertex.inTangentRelative().isZero()) {
+            } else {
+                curveValuesX[curveIndex] = previousElement.vertex.point.x;
+                curveValuesX[curveCount + curveIndex] = previousElement.vertex.outTangent.x;
+                curveValuesX[curveCount * 2 + curveIndex] = element.vertex.inTangent.x;
+                curveValuesX[curveCount * 3 + curveIndex] = element.vertex.point.x;
+                curveValuesY[curveIndex] = previousElement.vertex.point.y;
+                curveValuesY[curveCount + curveIndex] = previousElement.vertex.outTangent.y;
+                curveValuesY[curveCount * 2 + curveIndex] = element.vertex.inTangent.y;
+                curveValuesY[curveCount * 3 + curveIndex] = element.vertex.point.y;
+                curveIndex++;
+            }
+        }
+    }
+    
+    if (curveCount != 0) {
+        PathKernels const &kernels = PathKernels::current();
+        kernels.curveExtrema(curveValuesX, curveValuesX + curveCount, curveValuesX + curveCount * 2, curveValuesX + curveCount * 3, curveCount, pointsX + pathElementCount, pointsX + pathElementCount + curveCount);
+        kernels.curveExtrema(curveValuesY, curveValuesY + curveCount, curveValuesY + curveCount * 2, curveValuesY + curveCount * 3, curveCount, pointsY + pathElementCount, pointsY + pathElementCount + curveCount);
+    }
+    
+    return calculateBoundingRectOpt(pointsX, pointsY, pointCount);
+}
+
 CGRect bezierPathsBoundingBox(std::vector<BezierPath> const &paths) {
     int pointCount = 0;
     
@@ -696,14 +942,15 @@ CGRect bezierPathsBoundingBox(std::vector<BezierPath> const &paths) {
         }
     }
     
+    CGRect result = CGRect(0.0, 0.0, 0.0, 0.0);
+    if (pointCount != 0) {
+        result = calculateBoundingRectOpt(pointsX, pointsY, pointCount);
+    }
+    
     free(pointsX);
     free(pointsY);
     
-    if (pointCount == 0) {
-        return CGRect(0.0, 0.0, 0.0, 0.0);
-    }
-    
-    return calculateBoundingRectOpt(pointsX, pointsY, pointCount);
+    return result;
 }
 
 PathContents::PathContents(BezierPathContents const &bezierPath) {
@@ -1,5 +1,10 @@
 #include <LottieCpp/CurveVertex.h>
 
+#include "Lottie/Private/Utility/Primitives/BezierCurveLength.hpp"
+
+#include <algorithm>
+#include <cmath>
+
 namespace lottie {
 
 Vector2D transformVector(Vector2D const &v, Transform2D const &m) {
@@ -8,4 +13,130 @@ Vector2D transformVector(Vector2D const &v, Transform2D const &m) {
     return Vector2D(transformedX, transformedY);
 }
 
+namespace {
+
+/// Nodes and weights of the 5-point Gauss-Legendre rule on [-1, 1].
+const float gaussLegendreNodes[5] = { 0.0f, -0.5384693101f, 0.5384693101f, -0.9061798459f, 0.9061798459f };
+const float gaussLegendreWeights[5] = { 0.5688888889f, 0.4786286705f, 0.4786286705f, 0.2369268851f, 0.2369268851f };
+
+/// Spans are halved at most this many times, which bounds the work spent on degenerate curves.
+const int maxCurveLengthDepth = 8;
+
+/// The derivative of a cubic bezier is the quadratic bezier `3 * ((1 - t)^2 * a + 2 * (1 - t) * t * b + t^2 * c)`.
+struct CurveDerivative {
+    Vector2D a;
+    Vector2D b;
+    Vector2D c;
+    
+    float speed(float t) const {
+        float u = 1.0f - t;
+        float wa = 3.0f * u * u;
+        float wb = 6.0f * u * t;
+        float wc = 3.0f * t * t;
+        float x = a.x * wa + b.x * wb + c.x * wc;
+        float y = a.y * wa + b.y * wb + c.y * wc;
+        return sqrtf(x * x + y * y);
+    }
+    
+    float integrate(float from, float to) const {
+        float halfWidth = (to - from) * 0.5f;
+        float center = from + halfWidth;
+        float result = 0.0f;
+        for (int i = 0; i < 5; i++) {
+            result += gaussLegendreWeights[i] * speed(center + halfWidth * gaussLegendreNodes[i]);
+        }
+        return result * halfWidth;
+    }
+    
+    /// Accepts the estimate of a span once integrating its two halves separately no longer changes it.
+    float integrateAdaptive(float from, float to, float estimate, float tolerance, int depth) const {
+        float middle = (from + to) * 0.5f;
+        float left = integrate(from, middle);
+        float right = integrate(middle, to);
+        float refined = left + right;
+        if (depth >= maxCurveLengthDepth || std::abs(refined - estimate) <= tolerance) {
+            return refined;
+        }
+        return integrateAdaptive(from, middle, left, tolerance * 0.5f, depth + 1) + integrateAdaptive(middle, to, right, tolerance * 0.5f, depth + 1);
+    }
+};
+
+/// Appends the roots in (0, 1) of one coordinate of the derivative, `(1 - t)^2 * a + 2 * (1 - t) * t * b + t^2 * c`.
+void appendDerivativeRoots(float a, float b, float c, float *roots, int &rootCount) {
+    float qa = a - 2.0f * b + c;
+    float qb = 2.0f * (b - a);
+    float qc = a;
+    float candidates[2];
+    int candidateCount = 0;
+    if (std::abs(qa) < 1e-12f) {
+        if (std::abs(qb) >= 1e-12f) {
+            candidates[candidateCount++] = -qc / qb;
+        }
+    } else {
+        float discriminant = qb * qb - 4.0f * qa * qc;
+        if (discriminant >= 0.0f) {
+            float root = sqrtf(discriminant);
+            candidates[candidateCount++] = (-qb - root) / (2.0f * qa);
+            candidates[candidateCount++] = (-qb + root) / (2.0f * qa);
+        }
+    }
+    for (int i = 0; i < candidateCount; i++) {
+        if (candidates[i] > 0.0f && candidates[i] < 1.0f) {
+            roots[rootCount++] = candidates[i];
+        }
+    }
+}
+
+}
+
+float bezierCurveLength(Vector2D const &from, Vector2D const &control1, Vector2D const &control2, Vector2D const &to) {
+    float chordLength = from.distanceTo(to);
+    float polygonLength = from.distanceTo(control1) + control1.distanceTo(control2) + control2.distanceTo(to);
+    /// The arc length lies between the chord and the control polygon, a flat curve needs no integration.
+    if (polygonLength - chordLength <= polygonLength * 1e-6f) {
+        return chordLength;
+    }
+    
+    CurveDerivative derivative = { control1 - from, control2 - control1, to - control2 };
+    
+    /// The speed has a kink wherever the curve stops, which quadrature converges on poorly. The curve can only stop where
+    /// both coordinates of the derivative vanish, so the integral is split at the roots of each coordinate.
+    float bounds[6];
+    int boundCount = 1;
+    bounds[0] = 0.0f;
+    appendDerivativeRoots(derivative.a.x, derivative.b.x, derivative.c.x, bounds, boundCount);
+    appendDerivativeRoots(derivative.a.y, derivative.b.y, derivative.c.y, bounds, boundCount);
+    /// At most four interior roots, sorted in place.
+    for (int i = 2; i < boundCount; i++) {
+        float root = bounds[i];
+        int j = i;
+        for (; j > 1 && bounds[j - 1] > root; j--) {
+            bounds[j] = bounds[j - 1];
+        }
+        bounds[j] = root;
+    }
+    bounds[boundCount++] = 1.0f;
+    
+    float tolerance = std::max(polygonLength * 1e-5f, 1e-4f);
+    float result = 0.0f;
+    for (int i = 1; i < boundCount; i++) {
+        float spanStart = bounds[i - 1];
+        float spanEnd = bounds[i];
+        if (spanEnd <= spanStart) {
+            continue;
+        }
+        result += derivative.integrateAdaptive(spanStart, spanEnd, derivative.integrate(spanStart, spanEnd), tolerance * (spanEnd - spanStart), 0);
+    }
+    return result;
+}
+
+float CurveVertex::distanceTo(CurveVertex const &toVertex, int /* sampleCount */) const {
+    if (outTangentRelative().isZero() && toVertex.inTangentRelative().isZero()) {
+        /// Return a linear distance.
+        return point.distanceTo(toVertex.point);
+    }
+    
+    return bezierCurveLength(point, outTangent, toVertex.inTangent, toVertex.point);
+}
+
 }
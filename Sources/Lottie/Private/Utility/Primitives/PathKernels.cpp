@@ -0,0 +1,432 @@
+#include "PathKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define LOTTIE_PATH_KERNELS_SSE2 1
+#include <immintrin.h>
+#endif
+
+#if LOTTIE_PATH_KERNELS_SSE2 && defined(__GNUC__)
+#define LOTTIE_PATH_KERNELS_AVX2 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LOTTIE_PATH_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace lottie {
+
+namespace {
+
+void lerpScalar(float const *from, float const *to, float *result, int count, float amount) {
+    for (int i = 0; i < count; i++) {
+        result[i] = from[i] + ((to[i] - from[i]) * amount);
+    }
+}
+
+void minMaxScalar(float const *values, int count, float &minValue, float &maxValue) {
+    float minResult = values[0];
+    float maxResult = values[0];
+    for (int i = 0; i < count; i++) {
+        minResult = std::min(minResult, values[i]);
+        maxResult = std::max(maxResult, values[i]);
+    }
+    minValue = minResult;
+    maxValue = maxResult;
+}
+
+void transformPointsScalar(float const *points, float *result, int count, float const *matrix) {
+    for (int i = 0; i < count; i++) {
+        float x = points[i * 2];
+        float y = points[i * 2 + 1];
+        result[i * 2] = matrix[0] * x + matrix[2] * y + matrix[4] * 1.0f;
+        result[i * 2 + 1] = matrix[1] * x + matrix[3] * y + matrix[5] * 1.0f;
+    }
+}
+
+/// Same selection as `_mm_max_ps` and `_mm_min_ps`: the second operand wins ties and NaN.
+float selectMax(float a, float b) {
+    return a > b ? a : b;
+}
+
+float selectMin(float a, float b) {
+    return a < b ? a : b;
+}
+
+float curveValueScalar(float p0, float p1, float p2, float p3, float t) {
+    float u = 1.0f - t;
+    float uu = u * u;
+    float tt = t * t;
+    return p0 * (uu * u) + p1 * (3.0f * uu * t) + p2 * (3.0f * u * tt) + p3 * (tt * t);
+}
+
+void curveExtremaScalar(float const *p0, float const *p1, float const *p2, float const *p3, int count, float *first, float *second) {
+    for (int i = 0; i < count; i++) {
+        /// A third of the derivative is `qa * t^2 + qb * t + qc`.
+        float a = p1[i] - p0[i];
+        float b = p2[i] - p1[i];
+        float c = p3[i] - p2[i];
+        float qa = (a - b) - (b - c);
+        float qb = 2.0f * (b - a);
+        float qc = a;
+        /// Without real roots any point of the span will do, the discriminant is clamped instead of tested.
+        float root = sqrtf(selectMax(qb * qb - 4.0f * qa * qc, 0.0f));
+        /// The stable form of the roots, `qc / q` also covers a linear derivative.
+        float q = -0.5f * (qb + copysignf(root, qb));
+        float t1 = selectMin(selectMax(q / qa, 0.0f), 1.0f);
+        float t2 = selectMin(selectMax(qc / q, 0.0f), 1.0f);
+        first[i] = curveValueScalar(p0[i], p1[i], p2[i], p3[i], t1);
+        second[i] = curveValueScalar(p0[i], p1[i], p2[i], p3[i], t2);
+    }
+}
+
+/// Folds per-lane results in lane order, then the remaining values, so ties resolve as in `minMaxScalar`.
+void finishMinMax(float const *laneMin, float const *laneMax, int laneCount, float const *values, int begin, int count, float &minValue, float &maxValue) {
+    float minResult = laneMin[0];
+    float maxResult = laneMax[0];
+    for (int i = 1; i < laneCount; i++) {
+        minResult = std::min(minResult, laneMin[i]);
+        maxResult = std::max(maxResult, laneMax[i]);
+    }
+    for (int i = begin; i < count; i++) {
+        minResult = std::min(minResult, values[i]);
+        maxResult = std::max(maxResult, values[i]);
+    }
+    minValue = minResult;
+    maxValue = maxResult;
+}
+
+PathKernels const scalarKernels = { &lerpScalar, &minMaxScalar, &transformPointsScalar, &curveExtremaScalar, "scalar" };
+
+#if LOTTIE_PATH_KERNELS_SSE2
+
+void lerpSSE2(float const *from, float const *to, float *result, int count, float amount) {
+    __m128 amountVector = _mm_set1_ps(amount);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 fromVector = _mm_loadu_ps(from + i);
+        __m128 toVector = _mm_loadu_ps(to + i);
+        _mm_storeu_ps(result + i, _mm_add_ps(fromVector, _mm_mul_ps(_mm_sub_ps(toVector, fromVector), amountVector)));
+    }
+    lerpScalar(from + i, to + i, result + i, count - i, amount);
+}
+
+void minMaxSSE2(float const *values, int count, float &minValue, float &maxValue) {
+    if (count < 4) {
+        minMaxScalar(values, count, minValue, maxValue);
+        return;
+    }
+    /// `_mm_min_ps(a, b)` is `a < b ? a : b`, the same selection as `std::min(b, a)`.
+    __m128 minVector = _mm_loadu_ps(values);
+    __m128 maxVector = minVector;
+    int i = 4;
+    for (; i + 4 <= count; i += 4) {
+        __m128 value = _mm_loadu_ps(values + i);
+        minVector = _mm_min_ps(value, minVector);
+        maxVector = _mm_max_ps(value, maxVector);
+    }
+    float laneMin[4];
+    float laneMax[4];
+    _mm_storeu_ps(laneMin, minVector);
+    _mm_storeu_ps(laneMax, maxVector);
+    finishMinMax(laneMin, laneMax, 4, values, i, count, minValue, maxValue);
+}
+
+void transformPointsSSE2(float const *points, float *result, int count, float const *matrix) {
+    __m128 xFactors = _mm_setr_ps(matrix[0], matrix[1], matrix[0], matrix[1]);
+    __m128 yFactors = _mm_setr_ps(matrix[2], matrix[3], matrix[2], matrix[3]);
+    __m128 translation = _mm_setr_ps(matrix[4], matrix[5], matrix[4], matrix[5]);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128 value = _mm_loadu_ps(points + i * 2);
+        __m128 x = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 y = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm_storeu_ps(result + i * 2, _mm_add_ps(_mm_add_ps(_mm_mul_ps(xFactors, x), _mm_mul_ps(yFactors, y)), translation));
+    }
+    transformPointsScalar(points + i * 2, result + i * 2, count - i, matrix);
+}
+
+__m128 curveValueSSE2(__m128 p0, __m128 p1, __m128 p2, __m128 p3, __m128 t) {
+    __m128 three = _mm_set1_ps(3.0f);
+    __m128 u = _mm_sub_ps(_mm_set1_ps(1.0f), t);
+    __m128 uu = _mm_mul_ps(u, u);
+    __m128 tt = _mm_mul_ps(t, t);
+    __m128 result = _mm_add_ps(_mm_mul_ps(p0, _mm_mul_ps(uu, u)), _mm_mul_ps(p1, _mm_mul_ps(_mm_mul_ps(three, uu), t)));
+    result = _mm_add_ps(result, _mm_mul_ps(p2, _mm_mul_ps(_mm_mul_ps(three, u), tt)));
+    return _mm_add_ps(result, _mm_mul_ps(p3, _mm_mul_ps(tt, t)));
+}
+
+void curveExtremaSSE2(float const *p0, float const *p1, float const *p2, float const *p3, int count, float *first, float *second) {
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 v0 = _mm_loadu_ps(p0 + i);
+        __m128 v1 = _mm_loadu_ps(p1 + i);
+        __m128 v2 = _mm_loadu_ps(p2 + i);
+        __m128 v3 = _mm_loadu_ps(p3 + i);
+        __m128 a = _mm_sub_ps(v1, v0);
+        __m128 b = _mm_sub_ps(v2, v1);
+        __m128 c = _mm_sub_ps(v3, v2);
+        __m128 qa = _mm_sub_ps(_mm_sub_ps(a, b), _mm_sub_ps(b, c));
+        __m128 qb = _mm_mul_ps(_mm_set1_ps(2.0f), _mm_sub_ps(b, a));
+        __m128 qc = a;
+        __m128 discriminant = _mm_sub_ps(_mm_mul_ps(qb, qb), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(4.0f), qa), qc));
+        __m128 root = _mm_sqrt_ps(_mm_max_ps(discriminant, zero));
+        __m128 q = _mm_mul_ps(_mm_set1_ps(-0.5f), _mm_add_ps(qb, _mm_or_ps(root, _mm_and_ps(qb, signMask))));
+        __m128 t1 = _mm_min_ps(_mm_max_ps(_mm_div_ps(q, qa), zero), one);
+        __m128 t2 = _mm_min_ps(_mm_max_ps(_mm_div_ps(qc, q), zero), one);
+        _mm_storeu_ps(first + i, curveValueSSE2(v0, v1, v2, v3, t1));
+        _mm_storeu_ps(second + i, curveValueSSE2(v0, v1, v2, v3, t2));
+    }
+    curveExtremaScalar(p0 + i, p1 + i, p2 + i, p3 + i, count - i, first + i, second + i);
+}
+
+PathKernels const sse2Kernels = { &lerpSSE2, &minMaxSSE2, &transformPointsSSE2, &curveExtremaSSE2, "sse2" };
+
+#endif
+
+#if LOTTIE_PATH_KERNELS_AVX2
+
+__attribute__((target("avx2")))
+void lerpAVX2(float const *from, float const *to, float *result, int count, float amount) {
+    __m256 amountVector = _mm256_set1_ps(amount);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 fromVector = _mm256_loadu_ps(from + i);
+        __m256 toVector = _mm256_loadu_ps(to + i);
+        _mm256_storeu_ps(result + i, _mm256_add_ps(fromVector, _mm256_mul_ps(_mm256_sub_ps(toVector, fromVector), amountVector)));
+    }
+    lerpSSE2(from + i, to + i, result + i, count - i, amount);
+}
+
+__attribute__((target("avx2")))
+void minMaxAVX2(float const *values, int count, float &minValue, float &maxValue) {
+    if (count < 8) {
+        minMaxSSE2(values, count, minValue, maxValue);
+        return;
+    }
+    __m256 minVector = _mm256_loadu_ps(values);
+    __m256 maxVector = minVector;
+    int i = 8;
+    for (; i + 8 <= count; i += 8) {
+        __m256 value = _mm256_loadu_ps(values + i);
+        minVector = _mm256_min_ps(value, minVector);
+        maxVector = _mm256_max_ps(value, maxVector);
+    }
+    float laneMin[8];
+    float laneMax[8];
+    _mm256_storeu_ps(laneMin, minVector);
+    _mm256_storeu_ps(laneMax, maxVector);
+    finishMinMax(laneMin, laneMax, 8, values, i, count, minValue, maxValue);
+}
+
+__attribute__((target("avx2")))
+void transformPointsAVX2(float const *points, float *result, int count, float const *matrix) {
+    __m256 xFactors = _mm256_setr_ps(matrix[0], matrix[1], matrix[0], matrix[1], matrix[0], matrix[1], matrix[0], matrix[1]);
+    __m256 yFactors = _mm256_setr_ps(matrix[2], matrix[3], matrix[2], matrix[3], matrix[2], matrix[3], matrix[2], matrix[3]);
+    __m256 translation = _mm256_setr_ps(matrix[4], matrix[5], matrix[4], matrix[5], matrix[4], matrix[5], matrix[4], matrix[5]);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256 value = _mm256_loadu_ps(points + i * 2);
+        /// Points never straddle the two 128-bit lanes, so in-lane permutes are enough.
+        __m256 x = _mm256_permute_ps(value, _MM_SHUFFLE(2, 2, 0, 0));
+        __m256 y = _mm256_permute_ps(value, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm256_storeu_ps(result + i * 2, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xFactors, x), _mm256_mul_ps(yFactors, y)), translation));
+    }
+    transformPointsSSE2(points + i * 2, result + i * 2, count - i, matrix);
+}
+
+__attribute__((target("avx2")))
+__m256 curveValueAVX2(__m256 p0, __m256 p1, __m256 p2, __m256 p3, __m256 t) {
+    __m256 three = _mm256_set1_ps(3.0f);
+    __m256 u = _mm256_sub_ps(_mm256_set1_ps(1.0f), t);
+    __m256 uu = _mm256_mul_ps(u, u);
+    __m256 tt = _mm256_mul_ps(t, t);
+    __m256 result = _mm256_add_ps(_mm256_mul_ps(p0, _mm256_mul_ps(uu, u)), _mm256_mul_ps(p1, _mm256_mul_ps(_mm256_mul_ps(three, uu), t)));
+    result = _mm256_add_ps(result, _mm256_mul_ps(p2, _mm256_mul_ps(_mm256_mul_ps(three, u), tt)));
+    return _mm256_add_ps(result, _mm256_mul_ps(p3, _mm256_mul_ps(tt, t)));
+}
+
+__attribute__((target("avx2")))
+void curveExtremaAVX2(float const *p0, float const *p1, float const *p2, float const *p3, int count, float *first, float *second) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 signMask = _mm256_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 v0 = _mm256_loadu_ps(p0 + i);
+        __m256 v1 = _mm256_loadu_ps(p1 + i);
+        __m256 v2 = _mm256_loadu_ps(p2 + i);
+        __m256 v3 = _mm256_loadu_ps(p3 + i);
+        __m256 a = _mm256_sub_ps(v1, v0);
+        __m256 b = _mm256_sub_ps(v2, v1);
+        __m256 c = _mm256_sub_ps(v3, v2);
+        __m256 qa = _mm256_sub_ps(_mm256_sub_ps(a, b), _mm256_sub_ps(b, c));
+        __m256 qb = _mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_sub_ps(b, a));
+        __m256 qc = a;
+        __m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(qb, qb), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(4.0f), qa), qc));
+        __m256 root = _mm256_sqrt_ps(_mm256_max_ps(discriminant, zero));
+        __m256 q = _mm256_mul_ps(_mm256_set1_ps(-0.5f), _mm256_add_ps(qb, _mm256_or_ps(root, _mm256_and_ps(qb, signMask))));
+        __m256 t1 = _mm256_min_ps(_mm256_max_ps(_mm256_div_ps(q, qa), zero), one);
+        __m256 t2 = _mm256_min_ps(_mm256_max_ps(_mm256_div_ps(qc, q), zero), one);
+        _mm256_storeu_ps(first + i, curveValueAVX2(v0, v1, v2, v3, t1));
+        _mm256_storeu_ps(second + i, curveValueAVX2(v0, v1, v2, v3, t2));
+    }
+    curveExtremaSSE2(p0 + i, p1 + i, p2 + i, p3 + i, count - i, first + i, second + i);
+}
+
+PathKernels const avx2Kernels = { &lerpAVX2, &minMaxAVX2, &transformPointsAVX2, &curveExtremaAVX2, "avx2" };
+
+bool supportsAVX2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+#if LOTTIE_PATH_KERNELS_NEON
+
+void lerpNEON(float const *from, float const *to, float *result, int count, float amount) {
+    float32x4_t amountVector = vdupq_n_f32(amount);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t fromVector = vld1q_f32(from + i);
+        float32x4_t toVector = vld1q_f32(to + i);
+        vst1q_f32(result + i, vaddq_f32(fromVector, vmulq_f32(vsubq_f32(toVector, fromVector), amountVector)));
+    }
+    lerpScalar(from + i, to + i, result + i, count - i, amount);
+}
+
+void minMaxNEON(float const *values, int count, float &minValue, float &maxValue) {
+    if (count < 4) {
+        minMaxScalar(values, count, minValue, maxValue);
+        return;
+    }
+    /// Explicit selects instead of `vminq_f32`, which propagates NaN unlike `std::min`.
+    float32x4_t minVector = vld1q_f32(values);
+    float32x4_t maxVector = minVector;
+    int i = 4;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t value = vld1q_f32(values + i);
+        minVector = vbslq_f32(vcltq_f32(value, minVector), value, minVector);
+        maxVector = vbslq_f32(vcgtq_f32(value, maxVector), value, maxVector);
+    }
+    float laneMin[4];
+    float laneMax[4];
+    vst1q_f32(laneMin, minVector);
+    vst1q_f32(laneMax, maxVector);
+    finishMinMax(laneMin, laneMax, 4, values, i, count, minValue, maxValue);
+}
+
+void transformPointsNEON(float const *points, float *result, int count, float const *matrix) {
+    float32x4_t xFactors = { matrix[0], matrix[1], matrix[0], matrix[1] };
+    float32x4_t yFactors = { matrix[2], matrix[3], matrix[2], matrix[3] };
+    float32x4_t translation = { matrix[4], matrix[5], matrix[4], matrix[5] };
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        /// De-interleaves two points into x0, x1 and y0, y1.
+        float32x2x2_t value = vld2_f32(points + i * 2);
+        float32x4_t x = vcombine_f32(vdup_lane_f32(value.val[0], 0), vdup_lane_f32(value.val[0], 1));
+        float32x4_t y = vcombine_f32(vdup_lane_f32(value.val[1], 0), vdup_lane_f32(value.val[1], 1));
+        vst1q_f32(result + i * 2, vaddq_f32(vaddq_f32(vmulq_f32(xFactors, x), vmulq_f32(yFactors, y)), translation));
+    }
+    transformPointsScalar(points + i * 2, result + i * 2, count - i, matrix);
+}
+
+#if defined(__aarch64__)
+
+/// Explicit selects instead of `vmaxq_f32` and `vminq_f32`, which propagate NaN unlike `selectMax` and `selectMin`.
+float32x4_t selectMaxNEON(float32x4_t a, float32x4_t b) {
+    return vbslq_f32(vcgtq_f32(a, b), a, b);
+}
+
+float32x4_t selectMinNEON(float32x4_t a, float32x4_t b) {
+    return vbslq_f32(vcltq_f32(a, b), a, b);
+}
+
+float32x4_t curveValueNEON(float32x4_t p0, float32x4_t p1, float32x4_t p2, float32x4_t p3, float32x4_t t) {
+    float32x4_t u = vsubq_f32(vdupq_n_f32(1.0f), t);
+    float32x4_t uu = vmulq_f32(u, u);
+    float32x4_t tt = vmulq_f32(t, t);
+    float32x4_t result = vaddq_f32(vmulq_f32(p0, vmulq_f32(uu, u)), vmulq_f32(p1, vmulq_f32(vmulq_n_f32(uu, 3.0f), t)));
+    result = vaddq_f32(result, vmulq_f32(p2, vmulq_f32(vmulq_n_f32(u, 3.0f), tt)));
+    return vaddq_f32(result, vmulq_f32(p3, vmulq_f32(tt, t)));
+}
+
+void curveExtremaNEON(float const *p0, float const *p1, float const *p2, float const *p3, int count, float *first, float *second) {
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    float32x4_t one = vdupq_n_f32(1.0f);
+    uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v0 = vld1q_f32(p0 + i);
+        float32x4_t v1 = vld1q_f32(p1 + i);
+        float32x4_t v2 = vld1q_f32(p2 + i);
+        float32x4_t v3 = vld1q_f32(p3 + i);
+        float32x4_t a = vsubq_f32(v1, v0);
+        float32x4_t b = vsubq_f32(v2, v1);
+        float32x4_t c = vsubq_f32(v3, v2);
+        float32x4_t qa = vsubq_f32(vsubq_f32(a, b), vsubq_f32(b, c));
+        float32x4_t qb = vmulq_n_f32(vsubq_f32(b, a), 2.0f);
+        float32x4_t qc = a;
+        float32x4_t discriminant = vsubq_f32(vmulq_f32(qb, qb), vmulq_f32(vmulq_n_f32(qa, 4.0f), qc));
+        float32x4_t root = vsqrtq_f32(selectMaxNEON(discriminant, zero));
+        float32x4_t q = vmulq_n_f32(vaddq_f32(qb, vbslq_f32(signMask, qb, root)), -0.5f);
+        float32x4_t t1 = selectMinNEON(selectMaxNEON(vdivq_f32(q, qa), zero), one);
+        float32x4_t t2 = selectMinNEON(selectMaxNEON(vdivq_f32(qc, q), zero), one);
+        vst1q_f32(first + i, curveValueNEON(v0, v1, v2, v3, t1));
+        vst1q_f32(second + i, curveValueNEON(v0, v1, v2, v3, t2));
+    }
+    curveExtremaScalar(p0 + i, p1 + i, p2 + i, p3 + i, count - i, first + i, second + i);
+}
+
+PathKernels const neonKernels = { &lerpNEON, &minMaxNEON, &transformPointsNEON, &curveExtremaNEON, "neon" };
+
+#else
+
+/// Vector division and square roots are only available on arm64.
+PathKernels const neonKernels = { &lerpNEON, &minMaxNEON, &transformPointsNEON, &curveExtremaScalar, "neon" };
+
+#endif
+
+#endif
+
+}
+
+PathKernels const &PathKernels::current() {
+    static PathKernels const &kernels = *supported().back();
+    return kernels;
+}
+
+std::vector<PathKernels const *> PathKernels::supported() {
+    std::vector<PathKernels const *> result;
+    result.push_back(&scalarKernels);
+#if LOTTIE_PATH_KERNELS_SSE2
+    result.push_back(&sse2Kernels);
+#endif
+#if LOTTIE_PATH_KERNELS_AVX2
+    if (supportsAVX2()) {
+        result.push_back(&avx2Kernels);
+    }
+#endif
+#if LOTTIE_PATH_KERNELS_NEON
+    result.push_back(&neonKernels);
+#endif
+    return result;
+}
+
+void pathKernelsMatrix(Transform2D const &transform, float *matrix) {
+    matrix[0] = transform.rows().columns[0][0];
+    matrix[1] = transform.rows().columns[0][1];
+    matrix[2] = transform.rows().columns[1][0];
+    matrix[3] = transform.rows().columns[1][1];
+    matrix[4] = transform.rows().columns[2][0];
+    matrix[5] = transform.rows().columns[2][1];
+}
+
+}
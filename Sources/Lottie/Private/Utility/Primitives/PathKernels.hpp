@@ -0,0 +1,63 @@
+#ifndef PathKernels_hpp
+#define PathKernels_hpp
+
+#include <LottieCpp/Vectors.h>
+#include <LottieCpp/PathElement.h>
+
+#include <vector>
+
+namespace lottie {
+
+/// Float loops behind path interpolation, bounding boxes and path transforms, with SSE2, AVX2 and NEON versions.
+///
+/// `current()` picks the widest implementation the CPU supports the first time it is called: AVX2 is detected at
+/// runtime on x86, while SSE2 and NEON are part of the x86-64 and arm64 baselines. Every implementation performs the
+/// same float operations in the same order as the scalar one, so results do not depend on the CPU. This relies on the
+/// compiler not fusing multiply-adds, the build compiles PathKernels.cpp with `-ffp-contract=off`. Apple platforms
+/// keep using vDSP for interpolation and bounds.
+struct PathKernels {
+    /// `result[i] = from[i] + (to[i] - from[i]) * amount` for `count` floats.
+    void (*lerp)(float const *from, float const *to, float *result, int count, float amount);
+    
+    /// Minimum and maximum of `count` floats, `count` must be positive. Same as folding the values with `std::min` and
+    /// `std::max` in order.
+    void (*minMax)(float const *values, int count, float &minValue, float &maxValue);
+    
+    /// Applies an affine transform to `count` points stored as consecutive x, y pairs, same as `transformVector`.
+    /// `matrix` holds the six affine components in the order a, b, c, d, tx, ty. `points` may equal `result`.
+    void (*transformPoints)(float const *points, float *result, int count, float const *matrix);
+    
+    /// For `count` one-dimensional cubic bezier spans with control values `p0`, `p1`, `p2` and `p3`, writes the value of
+    /// every span at the two roots of its derivative to `first` and `second`. Roots are clamped to [0, 1], so every value
+    /// lies on its span, and the extrema of a span are among these values and its end points.
+    void (*curveExtrema)(float const *p0, float const *p1, float const *p2, float const *p3, int count, float *first, float *second);
+    
+    char const *name;
+    
+    /// The fastest kernels the CPU supports.
+    static PathKernels const &current();
+    
+    /// Every implementation the CPU supports, starting with the scalar one.
+    static std::vector<PathKernels const *> supported();
+};
+
+/// The affine components of `transform` as expected by `PathKernels::transformPoints`.
+void pathKernelsMatrix(Transform2D const &transform, float *matrix);
+
+static_assert(sizeof(PathElement) == sizeof(float) * 6, "PathElement must be three points of two floats without padding");
+
+/// The coordinates of `elements` as consecutive floats, six per element. `PathElement` is packed, but element arrays
+/// come from the allocator and are a multiple of four bytes long, so their floats are aligned.
+inline float const *pathElementFloats(PathElement const *elements) {
+    void const *data = elements;
+    return static_cast<float const *>(data);
+}
+
+inline float *pathElementFloats(PathElement *elements) {
+    void *data = elements;
+    return static_cast<float *>(data);
+}
+
+}
+
+#endif /* PathKernels_hpp */
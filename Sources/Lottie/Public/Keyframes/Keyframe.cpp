@@ -80,4 +80,72 @@ float cubicBezierInterpolate(float value, Vector2D const &P1, Vector2D const &P2
     return result;
 }
 
+CubicBezierEasing::CubicBezierEasing(Vector2D const &P1, Vector2D const &P2) {
+    _cx = 3.0f * P1.x;
+    _bx = 3.0f * (P2.x - P1.x) - _cx;
+    _ax = 1.0f - _cx - _bx;
+    
+    _cy = 3.0f * P1.y;
+    _by = 3.0f * (P2.y - P1.y) - _cy;
+    _ay = 1.0f - _cy - _by;
+    
+    for (int i = 0; i < kSampleCount; i++) {
+        _samples[i] = evaluateX((float)i / (float)(kSampleCount - 1));
+    }
+}
+
+float CubicBezierEasing::value(float progress) const {
+    if (isApproximatelyEqual(progress, 0.0f)) {
+        return 0.0f;
+    } else if (isApproximatelyEqual(progress, 1.0f)) {
+        return 1.0f;
+    }
+    
+    const float sampleStep = 1.0f / (float)(kSampleCount - 1);
+    
+    int sampleIndex = 0;
+    while (sampleIndex < kSampleCount - 2 && _samples[sampleIndex + 1] <= progress) {
+        sampleIndex++;
+    }
+    float lowerT = (float)sampleIndex * sampleStep;
+    float upperT = lowerT + sampleStep;
+    
+    float t = lowerT;
+    float sampleDelta = _samples[sampleIndex + 1] - _samples[sampleIndex];
+    if (sampleDelta > 0.0f) {
+        t += std::clamp((progress - _samples[sampleIndex]) / sampleDelta, 0.0f, 1.0f) * sampleStep;
+    }
+    
+    const int kMaxNewtonIterations = 4;
+    float error = evaluateX(t) - progress;
+    for (int i = 0; i < kMaxNewtonIterations && std::fabs(error) > kTolerance; i++) {
+        float derivative = evaluateDerivativeX(t);
+        if (std::fabs(derivative) < 1e-3f) {
+            break;
+        }
+        t -= error / derivative;
+        error = evaluateX(t) - progress;
+    }
+    
+    if (std::fabs(error) > kTolerance && (evaluateX(lowerT) - progress) * (evaluateX(upperT) - progress) <= 0.0f) {
+        /// Newton did not converge, the root is bracketed by the sample interval.
+        const int kMaxBisectionIterations = 24;
+        for (int i = 0; i < kMaxBisectionIterations; i++) {
+            t = 0.5f * (lowerT + upperT);
+            error = evaluateX(t) - progress;
+            if (std::fabs(error) <= kTolerance) {
+                break;
+            }
+            if ((evaluateX(lowerT) - progress) * error > 0.0f) {
+                lowerT = t;
+            } else {
+                upperT = t;
+            }
+        }
+    }
+    
+    t = std::clamp(t, 0.0f, 1.0f);
+    return evaluateY(t);
+}
+
 }
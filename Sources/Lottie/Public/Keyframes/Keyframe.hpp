@@ -7,11 +7,53 @@
 #include "Lottie/Public/Keyframes/ValueInterpolators.hpp"
 
 #include <optional>
+#include <type_traits>
+#include <vector>
 
 namespace lottie {
 
 float cubicBezierInterpolate(float value, Vector2D const &P1, Vector2D const &P2);
 
+/// The timing curve of a keyframe span, preprocessed so that evaluating it does not need the general cubic solver
+/// used by `cubicBezierInterpolate`.
+///
+/// `x(t)` is sampled at construction. Evaluation seeds `t` from the samples and refines it with Newton steps, falling
+/// back to bisection inside the bracketing sample interval when the curve is too flat for Newton to converge. The
+/// returned value is `y(t)` for a `t` with `|x(t) - progress| <= kTolerance`, provided that `x` is monotonic (both
+/// control point `x` values in [0, 1], as exported by After Effects); `cubicBezierInterpolate` stops at 5e-5.
+class CubicBezierEasing {
+public:
+    static constexpr float kTolerance = 1e-6f;
+    
+    CubicBezierEasing(Vector2D const &P1, Vector2D const &P2);
+    
+    float value(float progress) const;
+    
+private:
+    float evaluateX(float t) const {
+        return ((_ax * t + _bx) * t + _cx) * t;
+    }
+    
+    float evaluateY(float t) const {
+        return ((_ay * t + _by) * t + _cy) * t;
+    }
+    
+    float evaluateDerivativeX(float t) const {
+        return (3.0f * _ax * t + 2.0f * _bx) * t + _cx;
+    }
+    
+private:
+    static constexpr int kSampleCount = 11;
+    
+    float _ax = 0.0f;
+    float _bx = 0.0f;
+    float _cx = 0.0f;
+    float _ay = 0.0f;
+    float _by = 0.0f;
+    float _cy = 0.0f;
+    float _samples[kSampleCount];
+};
+
 /// A keyframe with a single value, and timing information
 /// about when the value should be displayed and how it
 /// should be interpolated.
@@ -67,7 +109,7 @@ public:
     }
     
 public:
-    T interpolate(Keyframe<T> const &to, float progress) {
+    T interpolate(Keyframe<T> const &to, float progress) const {
         std::optional<Vector2D> spatialOutTangent2d;
         if (spatialOutTangent) {
             spatialOutTangent2d = Vector2D(spatialOutTangent->x, spatialOutTangent->y);
@@ -79,8 +121,37 @@ public:
         return ValueInterpolator<T>::interpolate(value, to.value, progress, spatialOutTangent2d, spatialInTangent2d);
     }
     
-    /// Interpolates the keyTime into a value from 0-1
-    float interpolatedProgress(Keyframe<T> const &to, float keyTime) {
+    /// Same as `interpolate`, but writes into `result`, reusing its storage (see `InplaceValueInterpolator`).
+    void interpolateInplace(Keyframe<T> const &to, float progress, T &result) const {
+        std::optional<Vector2D> spatialOutTangent2d;
+        if (spatialOutTangent) {
+            spatialOutTangent2d = Vector2D(spatialOutTangent->x, spatialOutTangent->y);
+        }
+        std::optional<Vector2D> spatialInTangent2d;
+        if (to.spatialInTangent) {
+            spatialInTangent2d = Vector2D(to.spatialInTangent->x, to.spatialInTangent->y);
+        }
+        InplaceValueInterpolator<T>::interpolateInplace(value, to.value, progress, spatialOutTangent2d, spatialInTangent2d, result);
+    }
+    
+    /// The timing curve from this keyframe to `to`, or nothing if the span is linear.
+    std::optional<CubicBezierEasing> easing(Keyframe<T> const &to) const {
+        Vector2D outTanPoint = Vector2D::Zero();
+        if (outTangent.has_value()) {
+            outTanPoint = outTangent.value();
+        }
+        Vector2D inTanPoint = Vector2D(1.0, 1.0);
+        if (to.inTangent.has_value()) {
+            inTanPoint = to.inTangent.value();
+        }
+        if (!outTanPoint.isZero() || inTanPoint != Vector2D(1.0f, 1.0f)) {
+            return CubicBezierEasing(outTanPoint, inTanPoint);
+        }
+        return std::nullopt;
+    }
+    
+    /// Interpolates the keyTime into a value from 0-1. `easing` must be `easing(to)`.
+    float interpolatedProgress(Keyframe<T> const &to, float keyTime, std::optional<CubicBezierEasing> const &easing) const {
         float startTime = time;
         float endTime = to.time;
         if (keyTime <= startTime) {
@@ -94,18 +165,10 @@ public:
             return 0.0;
         }
         
-        Vector2D outTanPoint = Vector2D::Zero();
-        if (outTangent.has_value()) {
-            outTanPoint = outTangent.value();
-        }
-        Vector2D inTanPoint = Vector2D(1.0, 1.0);
-        if (to.inTangent.has_value()) {
-            inTanPoint = to.inTangent.value();
-        }
         float progress = remapFloat(keyTime, startTime, endTime, 0.0f, 1.0f);
-        if (!outTanPoint.isZero() || inTanPoint != Vector2D(1.0f, 1.0f)) {
+        if (easing) {
             /// Cubic interpolation
-            progress = cubicBezierInterpolate(progress, outTanPoint, inTanPoint);
+            progress = easing->value(progress);
         }
         return progress;
     }
@@ -128,6 +191,61 @@ public:
     std::optional<Vector3D> spatialOutTangent;
 };
 
+/// Preprocessed timing curves of `keyframes`; entry `i` covers the span from `keyframes[i]` to `keyframes[i + 1]`.
+template<typename T>
+std::vector<std::optional<CubicBezierEasing>> makeKeyframeSpanEasings(std::vector<Keyframe<T>> const &keyframes) {
+    std::vector<std::optional<CubicBezierEasing>> result;
+    if (keyframes.size() > 1) {
+        result.reserve(keyframes.size() - 1);
+        for (size_t i = 0; i + 1 < keyframes.size(); i++) {
+            result.push_back(keyframes[i].easing(keyframes[i + 1]));
+        }
+    }
+    return result;
+}
+
+/// Motion paths of the spans of `keyframes` that have spatial tangents, indexed like `makeKeyframeSpanEasings`.
+/// Only position keyframes (`Vector3D`) follow a motion path; for every other type the result is empty.
+template<typename T>
+std::vector<std::optional<SpatialInterpolationPath>> makeKeyframeSpanSpatialPaths(std::vector<Keyframe<T>> const &keyframes) {
+    std::vector<std::optional<SpatialInterpolationPath>> result;
+    if constexpr (std::is_same<T, Vector3D>::value) {
+        for (size_t i = 0; i + 1 < keyframes.size(); i++) {
+            Keyframe<T> const &from = keyframes[i];
+            Keyframe<T> const &to = keyframes[i + 1];
+            if (!(from.spatialOutTangent && to.spatialInTangent)) {
+                continue;
+            }
+            if (result.empty()) {
+                result.resize(keyframes.size() - 1);
+            }
+            
+            Vector2D from2d(from.value.x, from.value.y);
+            Vector2D to2d(to.value.x, to.value.y);
+            result[i] = SpatialInterpolationPath(
+                from2d,
+                to2d,
+                from2d + Vector2D(from.spatialOutTangent->x, from.spatialOutTangent->y),
+                to2d + Vector2D(to.spatialInTangent->x, to.spatialInTangent->y)
+            );
+        }
+    }
+    return result;
+}
+
+/// The easings and motion paths of the spans of `keyframes`. They only depend on the keyframes, so one instance is
+/// shared by every interpolator of the same keyframe group, see `KeyframeGroup::spanTables`.
+template<typename T>
+struct KeyframeSpanTables {
+    explicit KeyframeSpanTables(std::vector<Keyframe<T>> const &keyframes) :
+    spanEasings(makeKeyframeSpanEasings(keyframes)),
+    spanSpatialPaths(makeKeyframeSpanSpatialPaths(keyframes)) {
+    }
+    
+    std::vector<std::optional<CubicBezierEasing>> const spanEasings;
+    std::vector<std::optional<SpatialInterpolationPath>> const spanSpatialPaths;
+};
+
 template<typename T>
 class KeyframeData {
 public:
@@ -171,11 +289,11 @@ public:
         hold = getOptionalInt(json.object_items(), "h");
         
         if (const auto inTangentData = getOptionalObject(json.object_items(), "i")) {
-            inTangent = Vector2D(inTangentData.value());
+            inTangent = Vector2D(*inTangentData);
         }
         
         if (const auto outTangentData = getOptionalObject(json.object_items(), "o")) {
-            outTangent = Vector2D(outTangentData.value());
+            outTangent = Vector2D(*outTangentData);
         }
         
         if (const auto spatialInTangentData = getOptionalAny(json.object_items(), "ti")) {
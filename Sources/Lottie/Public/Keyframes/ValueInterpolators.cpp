@@ -1,11 +1,130 @@
 #include "ValueInterpolators.hpp"
 
+#include "Lottie/Public/Keyframes/Interpolatable.hpp"
+#include "Lottie/Private/Utility/Primitives/PathKernels.hpp"
+
 #if __APPLE__
 #include <Accelerate/Accelerate.h>
 #endif
 
+#include <algorithm>
+
 namespace lottie {
 
+SpatialInterpolationPath::SpatialInterpolationPath(
+    Vector2D const &from,
+    Vector2D const &to,
+    Vector2D const &outTangent,
+    Vector2D const &inTangent,
+    int samples
+) :
+_from(from),
+_to(to),
+_outTangent(outTangent),
+_inTangent(inTangent) {
+    if (from.colinear(outTangent, inTangent) && outTangent.colinear(inTangent, to)) {
+        _isLinear = true;
+        return;
+    }
+    
+    _step = 1.0 / (float)samples;
+    
+    _samples.reserve(samples + 2);
+    _samples.push_back(Sample(from, 0.0, 0.0));
+    float totalLength = 0.0;
+    
+    Vector2D previousPoint = from;
+    float previousAmount = 0.0;
+    
+    /// Accumulates the step the same way the per-frame sampling used to, so that the samples are unchanged.
+    while (previousAmount < 1.0) {
+        previousAmount = previousAmount + _step;
+        
+        auto newPoint = from.pointOnPath(to, outTangent, inTangent, previousAmount);
+        auto distance = previousPoint.distanceTo(newPoint);
+        totalLength = totalLength + distance;
+        _samples.push_back(Sample(newPoint, previousAmount, totalLength));
+        previousPoint = newPoint;
+    }
+}
+
+Vector2D SpatialInterpolationPath::point(float amount, int maxIterations, float accuracy) const {
+    if (amount == 0.0) {
+        return _from;
+    }
+    if (amount == 1.0) {
+        return _to;
+    }
+    
+    if (_isLinear) {
+        return _from.interpolate(_to, amount);
+    }
+    
+    /// Start from the last sample taken before `amount`.
+    int closestPoint = (int)(std::lower_bound(_samples.begin() + 1, _samples.end(), amount, [](Sample const &sample, float value) {
+        return sample.amount < value;
+    }) - (_samples.begin() + 1));
+    
+    float totalLength = _samples.back().distance;
+    float accurateDistance = amount * totalLength;
+    Vector2D point = _samples[closestPoint].point;
+    float pointDistance = _samples[closestPoint].distance;
+    
+    bool foundPoint = false;
+    
+    float pointAmount = ((float)closestPoint) * _step;
+    float nextPointAmount = pointAmount + _step;
+    
+    int refineIterations = 0;
+    while (!foundPoint) {
+        refineIterations = refineIterations + 1;
+        /// First see if the next point is still less than the projected length.
+        auto const &nextPoint = _samples[std::min(closestPoint + 1, (int)_samples.size() - 1)];
+        if (nextPoint.distance < accurateDistance) {
+            point = nextPoint.point;
+            pointDistance = nextPoint.distance;
+            closestPoint = closestPoint + 1;
+            pointAmount = ((float)closestPoint) * _step;
+            nextPointAmount = pointAmount + _step;
+            if (closestPoint == (int)_samples.size()) {
+                foundPoint = true;
+            }
+            continue;
+        }
+        if (accurateDistance < pointDistance) {
+            closestPoint = closestPoint - 1;
+            if (closestPoint < 0) {
+                foundPoint = true;
+                continue;
+            }
+            point = _samples[closestPoint].point;
+            pointDistance = _samples[closestPoint].distance;
+            pointAmount = ((float)closestPoint) * _step;
+            nextPointAmount = pointAmount + _step;
+            continue;
+        }
+        
+        /// Now we are certain the point is the closest point under the distance
+        auto pointDiff = nextPoint.distance - pointDistance;
+        auto proposedPointAmount = remapFloat((accurateDistance - pointDistance) / pointDiff, 0.0, 1.0, pointAmount, nextPointAmount);
+        
+        auto newPoint = _from.pointOnPath(_to, _outTangent, _inTangent, proposedPointAmount);
+        auto newDistance = pointDistance + point.distanceTo(newPoint);
+        pointAmount = proposedPointAmount;
+        point = newPoint;
+        pointDistance = newDistance;
+        if (accurateDistance - newDistance <= accuracy ||
+            newDistance - accurateDistance <= accuracy) {
+            foundPoint = true;
+        }
+        
+        if (refineIterations == maxIterations) {
+            foundPoint = true;
+        }
+    }
+    return point;
+}
+
 #if __APPLE__
 
 void batchInterpolate(std::vector<PathElement> const &from, std::vector<PathElement> const &to, BezierPath &resultPath, float amount) {
@@ -18,7 +137,7 @@ void batchInterpolate(std::vector<PathElement> const &from, std::vector<PathElem
     
     resultPath.setElementCount(elementCount);
     float floatAmount = (float)amount;
-    vDSP_vintb((float *)&from[0], 1, (float *)&to[0], 1, &floatAmount, (float *)&resultPath.elements()[0], 1, elementCount * 2 * 3);
+    vDSP_vintb(pathElementFloats(from.data()), 1, pathElementFloats(to.data()), 1, &floatAmount, pathElementFloats(resultPath.mutableElements().data()), 1, elementCount * 2 * 3);
 }
 
 #else
@@ -29,18 +148,14 @@ void batchInterpolate(std::vector<PathElement> const &from, std::vector<PathElem
         elementCount = (int)to.size();
     }
 
-    static_assert(sizeof(PathElement) == 4 * 2 * 3);
-
     resultPath.setElementCount(elementCount);
     
-    float *fromValues = (float *)&from[0];
-    float *toValues = (float *)&to[0];
-    float *outValues = (float *)&resultPath.elements()[0];
+    float const *fromValues = pathElementFloats(from.data());
+    float const *toValues = pathElementFloats(to.data());
+    float *outValues = pathElementFloats(resultPath.mutableElements().data());
     int numValues = elementCount * 2 * 3;
     
-    for (int i = 0; i < numValues; i++) {
-        outValues[i] = fromValues[i] + ((toValues[i] - fromValues[i]) * amount);
-    }
+    PathKernels::current().lerp(fromValues, toValues, outValues, numValues, amount);
 }
 
 #endif
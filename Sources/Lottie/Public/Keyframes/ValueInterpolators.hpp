@@ -8,11 +8,53 @@
 #include "Lottie/Public/Primitives/GradientColorSet.hpp"
 #include "Lottie/Public/Primitives/DashPattern.hpp"
 
+#include <algorithm>
 #include <optional>
 #include <cassert>
+#include <cstring>
+#include <vector>
 
 namespace lottie {
 
+/// Arc-length samples of a spatial (motion path) bezier span, used to move along the path at a constant speed.
+///
+/// Sampling the path is the expensive part of `Vector2D::interpolate(to, outTangent, inTangent, amount)`. Keyframe
+/// interpolators build one table per spatial span when they are created and only call `point(amount)` per frame, which
+/// is a lookup in the table plus one bezier evaluation and does not allocate.
+class SpatialInterpolationPath {
+public:
+    SpatialInterpolationPath(
+        Vector2D const &from,
+        Vector2D const &to,
+        Vector2D const &outTangent,
+        Vector2D const &inTangent,
+        int samples = 20
+    );
+    
+    Vector2D point(float amount, int maxIterations = 3, float accuracy = 1.0) const;
+    
+private:
+    struct Sample {
+        Sample(Vector2D const &point_, float amount_, float distance_) :
+        point(point_), amount(amount_), distance(distance_) {
+        }
+        
+        Vector2D point;
+        /// The path parameter the point was sampled at.
+        float amount;
+        /// The length of the path up to the point.
+        float distance;
+    };
+    
+    Vector2D _from;
+    Vector2D _to;
+    Vector2D _outTangent;
+    Vector2D _inTangent;
+    bool _isLinear = false;
+    float _step = 0.0f;
+    std::vector<Sample> _samples;
+};
+
 template<typename T>
 struct ValueInterpolator {
 };
@@ -51,6 +93,17 @@ public:
 template<>
 struct ValueInterpolator<Vector3D> {
 public:
+    /// Same as `interpolate` for a span with spatial tangents, with the motion path sampled in advance.
+    static Vector3D interpolate(Vector3D const &value, Vector3D const &to, float amount, SpatialInterpolationPath const &path) {
+        Vector2D result2d = path.point(amount);
+        
+        return Vector3D(
+            result2d.x,
+            result2d.y,
+            ValueInterpolator<float>::interpolate(value.z, to.z, amount, std::nullopt, std::nullopt)
+        );
+    }
+    
     static Vector3D interpolate(Vector3D const &value, Vector3D const &to, float amount, std::optional<Vector2D> spatialOutTangent, std::optional<Vector2D> spatialInTangent) {
         if (spatialOutTangent && spatialInTangent) {
             Vector2D from2d(value.x, value.y);
@@ -203,10 +256,26 @@ public:
 #endif
         std::vector<float> colors;
         size_t colorCount = std::min(value.colors.size(), to.colors.size());
+        colors.reserve(colorCount);
         for (size_t i = 0; i < colorCount; i++) {
             colors.push_back(ValueInterpolator<float>::interpolate(value.colors[i], to.colors[i], amount, spatialOutTangent, spatialInTangent));
         }
-        return GradientColorSet(colors);
+        return GradientColorSet(std::move(colors));
+    }
+    
+    static void setInplace(GradientColorSet const &value, GradientColorSet &result) {
+        result.colors.assign(value.colors.begin(), value.colors.end());
+    }
+    
+    static void interpolateInplace(GradientColorSet const &value, GradientColorSet const &to, float amount, std::optional<Vector2D> spatialOutTangent, std::optional<Vector2D> spatialInTangent, GradientColorSet &result) {
+#if DEBUG
+        assert(value.colors.size() == to.colors.size());
+#endif
+        size_t colorCount = std::min(value.colors.size(), to.colors.size());
+        result.colors.resize(colorCount);
+        for (size_t i = 0; i < colorCount; i++) {
+            result.colors[i] = ValueInterpolator<float>::interpolate(value.colors[i], to.colors[i], amount, spatialOutTangent, spatialInTangent);
+        }
     }
 };
 
@@ -224,6 +293,50 @@ public:
         }
         return DashPattern(std::move(values));
     }
+    
+    static void setInplace(DashPattern const &value, DashPattern &result) {
+        result.values.assign(value.values.begin(), value.values.end());
+    }
+    
+    static void interpolateInplace(DashPattern const &value, DashPattern const &to, float amount, std::optional<Vector2D> spatialOutTangent, std::optional<Vector2D> spatialInTangent, DashPattern &result) {
+#if DEBUG
+        assert(value.values.size() == to.values.size());
+#endif
+        size_t valueCount = std::min(value.values.size(), to.values.size());
+        result.values.resize(valueCount);
+        for (size_t i = 0; i < valueCount; i++) {
+            result.values[i] = ValueInterpolator<float>::interpolate(value.values[i], to.values[i], amount, spatialOutTangent, spatialInTangent);
+        }
+    }
+};
+
+/// Writes keyframe values into an existing `result` instead of returning a new value.
+///
+/// Types that keep their data on the heap (`BezierPath`, `GradientColorSet`, `DashPattern`) reuse the storage of
+/// `result`, so once it has grown to the largest keyframe, evaluating a keyframe span no longer allocates. For every
+/// other type this is a plain assignment.
+template<typename T>
+struct InplaceValueInterpolator {
+public:
+    static void setInplace(T const &value, T &result) {
+        result = value;
+    }
+    
+    static void interpolateInplace(T const &value, T const &to, float amount, std::optional<Vector2D> spatialOutTangent, std::optional<Vector2D> spatialInTangent, T &result) {
+        result = ValueInterpolator<T>::interpolate(value, to, amount, spatialOutTangent, spatialInTangent);
+    }
+};
+
+template<>
+struct InplaceValueInterpolator<BezierPath>: public ValueInterpolator<BezierPath> {
+};
+
+template<>
+struct InplaceValueInterpolator<GradientColorSet>: public ValueInterpolator<GradientColorSet> {
+};
+
+template<>
+struct InplaceValueInterpolator<DashPattern>: public ValueInterpolator<DashPattern> {
 };
 
 }
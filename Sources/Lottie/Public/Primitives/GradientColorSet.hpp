@@ -3,6 +3,7 @@
 
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace lottie {
@@ -11,6 +12,10 @@ struct GradientColorSet {
     GradientColorSet() {
     }
     
+    explicit GradientColorSet(std::vector<float> &&colors_) :
+    colors(std::move(colors_)) {
+    }
+    
     explicit GradientColorSet(lottiejson11::Json const &jsonAny) noexcept(false) {
         if (!jsonAny.is_array()) {
             throw LottieParsingException();
@@ -2,6 +2,7 @@
 
 #include "Lottie/Private/Parsing/JsonParsing.hpp"
 #include "Lottie/Public/Keyframes/Interpolatable.hpp"
+#include "Lottie/Public/Keyframes/ValueInterpolators.hpp"
 
 #include <math.h>
 #include <cfloat>
@@ -51,7 +52,7 @@ Vector2D::Vector2D(lottiejson11::Json const &json) noexcept(false) {
             index++;
         }
     } else if (json.is_object()) {
-        auto xAny = getAny(json.object_items(), "x");
+        auto const &xAny = getAny(json.object_items(), "x");
         if (xAny.is_number()) {
             x = xAny.number_value();
         } else if (xAny.is_array()) {
@@ -64,7 +65,7 @@ Vector2D::Vector2D(lottiejson11::Json const &json) noexcept(false) {
             x = xAny.array_items()[0].number_value();
         }
         
-        auto yAny = getAny(json.object_items(), "y");
+        auto const &yAny = getAny(json.object_items(), "y");
         if (yAny.is_number()) {
             y = yAny.number_value();
         } else if (yAny.is_array()) {
@@ -267,15 +268,6 @@ Vector3D interpolate(
     return Vector3D(interpolate(from.x, to.x, amount), interpolate(from.y, to.y, amount), interpolate(from.z, to.z, amount));
 }
 
-struct InterpolationPoint2D {
-    InterpolationPoint2D(Vector2D const point_, float distance_) :
-    point(point_), distance(distance_) {
-    }
-    
-    Vector2D point;
-    float distance;
-};
-
 namespace {
     float interpolateFloat(float value, float to, float amount) {
         return value + ((to - value) * amount);
@@ -315,88 +307,7 @@ Vector2D Vector2D::interpolate(
         return to;
     }
         
-    if (colinear(outTangent, inTangent) && outTangent.colinear(inTangent, to)) {
-        return interpolate(to, amount);
-    }
-        
-    float step = 1.0 / (float)samples;
-    
-    std::vector<InterpolationPoint2D> points;
-    points.push_back(InterpolationPoint2D(*this, 0.0));
-    float totalLength = 0.0;
-    
-    Vector2D previousPoint = *this;
-    float previousAmount = 0.0;
-    
-    int closestPoint = 0;
-    
-    while (previousAmount < 1.0) {
-        previousAmount = previousAmount + step;
-        
-        if (previousAmount < amount) {
-            closestPoint = closestPoint + 1;
-        }
-        
-        auto newPoint = pointOnPath(to, outTangent, inTangent, previousAmount);
-        auto distance = previousPoint.distanceTo(newPoint);
-        totalLength = totalLength + distance;
-        points.push_back(InterpolationPoint2D(newPoint, totalLength));
-        previousPoint = newPoint;
-    }
-    
-    float accurateDistance = amount * totalLength;
-    auto point = points[closestPoint];
-    
-    bool foundPoint = false;
-    
-    float pointAmount = ((float)closestPoint) * step;
-    float nextPointAmount = pointAmount + step;
-    
-    int refineIterations = 0;
-    while (!foundPoint) {
-        refineIterations = refineIterations + 1;
-        /// First see if the next point is still less than the projected length.
-        auto nextPoint = points[std::min(closestPoint + 1, (int)points.size() - 1)];
-        if (nextPoint.distance < accurateDistance) {
-            point = nextPoint;
-            closestPoint = closestPoint + 1;
-            pointAmount = ((float)closestPoint) * step;
-            nextPointAmount = pointAmount + step;
-            if (closestPoint == (int)points.size()) {
-                foundPoint = true;
-            }
-            continue;
-        }
-        if (accurateDistance < point.distance) {
-            closestPoint = closestPoint - 1;
-            if (closestPoint < 0) {
-                foundPoint = true;
-                continue;
-            }
-            point = points[closestPoint];
-            pointAmount = ((float)closestPoint) * step;
-            nextPointAmount = pointAmount + step;
-            continue;
-        }
-        
-        /// Now we are certain the point is the closest point under the distance
-        auto pointDiff = nextPoint.distance - point.distance;
-        auto proposedPointAmount = remapFloat((accurateDistance - point.distance) / pointDiff, 0.0, 1.0, pointAmount, nextPointAmount);
-        
-        auto newPoint = pointOnPath(to, outTangent, inTangent, proposedPointAmount);
-        auto newDistance = point.distance + point.point.distanceTo(newPoint);
-        pointAmount = proposedPointAmount;
-        point = InterpolationPoint2D(newPoint, newDistance);
-        if (accurateDistance - newDistance <= accuracy ||
-            newDistance - accurateDistance <= accuracy) {
-            foundPoint = true;
-        }
-        
-        if (refineIterations == maxIterations) {
-            foundPoint = true;
-        }
-    }
-    return point.point;
+    return SpatialInterpolationPath(*this, to, outTangent, inTangent, samples).point(amount, maxIterations, accuracy);
 }
 
 bool CGRect::intersects(CGRect const &other) const {
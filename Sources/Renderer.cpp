@@ -2,13 +2,17 @@
 
 #include <LottieCpp/lottiejson11.hpp>
 #include "Lottie/Private/Model/Animation.hpp"
+#include "Lottie/Private/Parsing/ModelBuildTasks.hpp"
 #include "Lottie/Private/MainThread/LayerContainers/MainThreadAnimationLayer.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 namespace lottie {
 
 class Renderer::Impl {
 public:
-    Impl(std::shared_ptr<Animation> animation) :
+    Impl(std::shared_ptr<Animation const> animation) :
     _animation(animation) {
         _layer = std::make_shared<MainThreadAnimationLayer>(
             *_animation.get(),
@@ -35,29 +39,61 @@ public:
         _layer->setCurrentFrame(_animation->startFrame + index);
     }
     
+    bool framesRenderIdentically(float index, float otherIndex) {
+        return !_layer->changeTimeline().changes(_animation->startFrame + index, _animation->startFrame + otherIndex);
+    }
+    
     std::shared_ptr<RenderTreeNode> renderNode() {
         return _layer->renderTreeNode();
     }
     
 private:
-    std::shared_ptr<Animation> _animation;
+    std::shared_ptr<Animation const> _animation;
     std::shared_ptr<MainThreadAnimationLayer> _layer;
 };
 
-Renderer::Renderer(std::shared_ptr<Impl> impl) :
-_impl(impl) {
+ParsedAnimation::ParsedAnimation(std::shared_ptr<Animation const> animation) :
+_animation(animation) {
 }
 
-std::shared_ptr<Renderer> Renderer::make(std::string const &jsonString) {
-    std::string errorText;
-    auto json = lottiejson11::Json::parse(jsonString, errorText);
-    if (!json.is_object()) {
+std::shared_ptr<ParsedAnimation> ParsedAnimation::make(std::string const &jsonString) {
+    return make(jsonString.data(), jsonString.size());
+}
+
+std::shared_ptr<ParsedAnimation> ParsedAnimation::make(const char *data, size_t size) {
+    std::shared_ptr<Animation> animation;
+    try {
+        animation = Animation::fromData(data, size);
+    } catch(...) {
+        return nullptr;
+    }
+    if (!animation) {
+        return nullptr;
+    }
+    
+    return std::shared_ptr<ParsedAnimation>(new ParsedAnimation(animation));
+}
+
+std::shared_ptr<ParsedAnimation> ParsedAnimation::make(const char *data, size_t size, Executor const &executor) {
+    std::shared_ptr<Animation> animation;
+    try {
+        lottiejson11::JsonReader reader(data, size);
+        ModelBuildTasks tasks(executor);
+        animation = Animation::fromReader(reader, &tasks);
+    } catch(...) {
+        return nullptr;
+    }
+    if (!animation) {
         return nullptr;
     }
     
+    return std::shared_ptr<ParsedAnimation>(new ParsedAnimation(animation));
+}
+
+std::shared_ptr<ParsedAnimation> ParsedAnimation::makeFromSnapshot(const void *data, size_t size) {
     std::shared_ptr<Animation> animation;
     try {
-        animation = Animation::fromJson(json.object_items());
+        animation = Animation::fromSnapshot(data, size);
     } catch(...) {
         return nullptr;
     }
@@ -65,10 +101,117 @@ std::shared_ptr<Renderer> Renderer::make(std::string const &jsonString) {
         return nullptr;
     }
     
+    return std::shared_ptr<ParsedAnimation>(new ParsedAnimation(animation));
+}
+
+int ParsedAnimation::frameCount() const {
+    return (int)(_animation->endFrame - _animation->startFrame);
+}
+
+int ParsedAnimation::framesPerSecond() const {
+    return (int)_animation->framerate;
+}
+
+Vector2D ParsedAnimation::size() const {
+    return Vector2D(_animation->width, _animation->height);
+}
+
+Renderer::Renderer(std::shared_ptr<Impl> impl) :
+_impl(impl) {
+}
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void setErrorLocation(Renderer::LoadResult &result, const char *data, size_t offset) {
+    result.errorOffset = offset;
+    result.errorLine = 1;
+    result.errorColumn = 1;
+    for (size_t i = 0; i < offset; i++) {
+        if (data[i] == '\n') {
+            result.errorLine++;
+            result.errorColumn = 1;
+        } else {
+            result.errorColumn++;
+        }
+    }
+}
+
+}
+
+std::shared_ptr<Renderer> Renderer::make(std::string const &jsonString) {
+    return make(jsonString.data(), jsonString.size()).renderer;
+}
+
+Renderer::LoadResult Renderer::make(const char *data, size_t size) {
+    LoadResult result;
+    result.statistics.byteCount = size;
+    
+    lottiejson11::JsonReader reader(data, size);
+    ParsingStatistics parsingStatistics;
+    
+    std::shared_ptr<Animation> animation;
+    auto loadStart = std::chrono::steady_clock::now();
+    {
+        ParsingStatistics::Scope scope(parsingStatistics);
+        try {
+            animation = Animation::fromReader(reader);
+        } catch(...) {
+            animation = nullptr;
+        }
+    }
+    double loadDuration = secondsSince(loadStart);
+    
+    result.statistics.layerCount = parsingStatistics.layerCount;
+    result.statistics.shapeItemCount = parsingStatistics.shapeItemCount;
+    result.statistics.keyframeCount = parsingStatistics.keyframeCount;
+    result.statistics.jsonParseDuration = parsingStatistics.jsonParseDuration;
+    result.statistics.modelBuildDuration = std::max(0.0, loadDuration - parsingStatistics.jsonParseDuration);
+    
+    if (!animation) {
+        result.error = reader.failed() ? reader.error() : "unsupported or invalid animation data";
+        setErrorLocation(result, data, std::min(reader.offset(), size));
+        return result;
+    }
+    
+    auto layerStart = std::chrono::steady_clock::now();
     auto impl = std::make_shared<Impl>(animation);
+    result.statistics.layerConstructionDuration = secondsSince(layerStart);
+    
+    result.renderer = std::shared_ptr<Renderer>(new Renderer(impl));
+    return result;
+}
+
+std::shared_ptr<Renderer> Renderer::make(std::shared_ptr<ParsedAnimation> const &animation) {
+    if (!animation) {
+        return nullptr;
+    }
+    
+    auto impl = std::make_shared<Impl>(animation->_animation);
     return std::shared_ptr<Renderer>(new Renderer(impl));
 }
 
+std::shared_ptr<Renderer> Renderer::makeFromSnapshot(const void *data, size_t size) {
+    return make(ParsedAnimation::makeFromSnapshot(data, size));
+}
+
+std::vector<uint8_t> Renderer::makeSnapshot(std::string const &jsonString) {
+    std::vector<uint8_t> result;
+    try {
+        auto animation = Animation::fromData(jsonString.data(), jsonString.size());
+        if (!animation) {
+            return result;
+        }
+        animation->writeSnapshot(result);
+    } catch(...) {
+        result.clear();
+    }
+    return result;
+}
+
 int Renderer::frameCount() {
     return _impl->frameCount();
 }
@@ -85,6 +228,10 @@ void Renderer::setFrame(float index) {
     _impl->setFrame(index);
 }
 
+bool Renderer::framesRenderIdentically(float index, float otherIndex) {
+    return _impl->framesRenderIdentically(index, otherIndex);
+}
+
 std::shared_ptr<RenderTreeNode> Renderer::renderNode() {
     return _impl->renderNode();
 }
@@ -20,11 +20,16 @@
  */
 
 #include <LottieCpp/lottiejson11.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <limits>
+#include <new>
+#include <unordered_map>
 
 namespace lottiejson11 {
 
@@ -317,6 +322,46 @@ bool Json::operator< (const Json &other) const {
     return m_ptr->less(other.m_ptr.get());
 }
 
+/* * * * * * * * * * * * * * * * * * * *
+ * Arena
+ */
+
+JsonArena::JsonArena(size_t chunk_size) : m_chunk_size(std::max(chunk_size, static_cast<size_t>(1024))) {}
+
+JsonArena::~JsonArena() {
+    for (char *chunk : m_chunks)
+        ::operator delete(chunk);
+}
+
+static inline uintptr_t align_up(uintptr_t value, size_t alignment) {
+    return (value + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+}
+
+void * JsonArena::allocate(size_t size, size_t alignment) {
+    uintptr_t result = align_up(reinterpret_cast<uintptr_t>(m_cursor), alignment);
+    if (!m_cursor || result + size > reinterpret_cast<uintptr_t>(m_end)) {
+        size_t required = size + alignment;
+        char *chunk = static_cast<char *>(::operator new(std::max(m_chunk_size, required)));
+        m_chunks.push_back(chunk);
+        m_bytes_allocated += size;
+
+        // Oversized requests get a chunk of their own so that the current chunk stays in use.
+        if (required > m_chunk_size / 4) {
+            m_bytes_reserved += required;
+            return reinterpret_cast<void *>(align_up(reinterpret_cast<uintptr_t>(chunk), alignment));
+        }
+
+        m_bytes_reserved += m_chunk_size;
+        m_cursor = chunk;
+        m_end = chunk + m_chunk_size;
+        result = align_up(reinterpret_cast<uintptr_t>(m_cursor), alignment);
+    } else {
+        m_bytes_allocated += size;
+    }
+    m_cursor = reinterpret_cast<char *>(result + size);
+    return reinterpret_cast<void *>(result);
+}
+
 /* * * * * * * * * * * * * * * * * * * *
  * Parsing
  */
@@ -339,7 +384,197 @@ static inline bool in_range(long x, long lower, long upper) {
     return (x >= lower && x <= upper);
 }
 
-namespace {
+namespace detail {
+
+/* JsonInput
+ *
+ * Bounded view over the bytes being parsed. Reads past the end yield '\0', which is
+ * what the parser relied on when it only ever ran over NUL-terminated std::strings.
+ */
+struct JsonInput final {
+    const char *data;
+    size_t length;
+
+    char operator[](size_t j) const {
+        return j < length ? data[j] : static_cast<char>(0);
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    int compare(size_t pos, size_t n, const string &s) const {
+        if (pos > length || length - pos < n)
+            return 1;
+        return std::memcmp(data + pos, s.data(), n);
+    }
+
+    string substr(size_t pos, size_t n) const {
+        if (pos >= length)
+            return string();
+        return string(data + pos, std::min(n, length - pos));
+    }
+};
+
+/* JsonHeapBuilder
+ *
+ * Builds the reference-counted Json tree returned by Json::parse and JsonReader.
+ */
+struct JsonHeapBuilder final {
+    typedef Json Value;
+    typedef map<string, Json> Object;
+    typedef vector<Json> Array;
+
+    Json make_null() { return Json(); }
+    Json make_bool(bool value) { return value; }
+    Json make_int(int value) { return value; }
+    Json make_double(double value) { return value; }
+    Json make_string(string &&value) { return std::move(value); }
+
+    Object begin_object() { return Object(); }
+    void add_member(Object &object, string &&key, Json &&value) {
+        object[std::move(key)] = std::move(value);
+    }
+    Json end_object(Object &object) { return std::move(object); }
+
+    Array begin_array() { return Array(); }
+    void add_element(Array &array, Json &&value) { array.push_back(std::move(value)); }
+    Json end_array(Array &array) { return std::move(array); }
+};
+
+/* JsonArenaBuilder
+ *
+ * Builds the JsonNode tree of a JsonDocument. Members and elements of the containers being
+ * parsed are collected on two scratch stacks and copied into the arena in one block when their
+ * container closes, so a parse does no per-value heap allocation.
+ */
+struct JsonArenaBuilder final {
+    typedef JsonNode Value;
+    typedef size_t Object;
+    typedef size_t Array;
+
+    JsonArena &arena;
+    vector<JsonNode> elements;
+    vector<JsonNode::Member> members;
+    std::unordered_map<string, const char *> interned_keys;
+
+    explicit JsonArenaBuilder(JsonArena &arena) : arena(arena) {}
+
+    JsonNode make_null() { return JsonNode(); }
+
+    JsonNode make_bool(bool value) {
+        JsonNode node;
+        node.m_type = Json::BOOL;
+        node.m_bool = value;
+        return node;
+    }
+
+    JsonNode make_int(int value) {
+        JsonNode node = make_double(value);
+        node.m_is_int = true;
+        return node;
+    }
+
+    JsonNode make_double(double value) {
+        JsonNode node;
+        node.m_type = Json::NUMBER;
+        node.m_number = value;
+        return node;
+    }
+
+    JsonNode make_string(string &&value) {
+        JsonNode node;
+        node.m_type = Json::STRING;
+        node.m_string = copy_string(value);
+        node.m_size = static_cast<uint32_t>(value.size());
+        return node;
+    }
+
+    Object begin_object() { return members.size(); }
+
+    void add_member(Object, string &&key, JsonNode &&value) {
+        uint32_t key_size = static_cast<uint32_t>(key.size());
+        members.push_back(JsonNode::Member { intern(std::move(key)), key_size, value });
+    }
+
+    JsonNode end_object(Object start) {
+        size_t count = members.size() - start;
+        JsonNode::Member *items = copy_items(members.data() + start, count);
+        members.resize(start);
+
+        // Repeated keys resolve to their last occurrence, as with Json::parse. The sort is stable,
+        // so that is the last item of each run of equal keys.
+        if (count <= 16) {
+            for (size_t i = 1; i < count; i++) {
+                JsonNode::Member item = items[i];
+                size_t j = i;
+                for (; j > 0 && key_less(item, items[j - 1]); j--)
+                    items[j] = items[j - 1];
+                items[j] = item;
+            }
+        } else {
+            std::stable_sort(items, items + count, key_less);
+        }
+        size_t out = 0;
+        for (size_t i = 0; i < count; i++) {
+            // Interned keys are equal exactly when their pointers are.
+            if (i + 1 < count && items[i + 1].key == items[i].key)
+                continue;
+            items[out++] = items[i];
+        }
+
+        JsonNode node;
+        node.m_type = Json::OBJECT;
+        node.m_members = items;
+        node.m_size = static_cast<uint32_t>(out);
+        return node;
+    }
+
+    Array begin_array() { return elements.size(); }
+
+    void add_element(Array, JsonNode &&value) { elements.push_back(value); }
+
+    JsonNode end_array(Array start) {
+        size_t count = elements.size() - start;
+        JsonNode node;
+        node.m_type = Json::ARRAY;
+        node.m_items = copy_items(elements.data() + start, count);
+        node.m_size = static_cast<uint32_t>(count);
+        elements.resize(start);
+        return node;
+    }
+
+    static bool key_less(const JsonNode::Member &lhs, const JsonNode::Member &rhs) {
+        int result = std::memcmp(lhs.key, rhs.key, std::min(lhs.key_size, rhs.key_size));
+        return result < 0 || (result == 0 && lhs.key_size < rhs.key_size);
+    }
+
+    template <typename T>
+    T *copy_items(const T *items, size_t count) {
+        if (count == 0)
+            return nullptr;
+        T *result = static_cast<T *>(arena.allocate(count * sizeof(T), alignof(T)));
+        std::copy(items, items + count, result);
+        return result;
+    }
+
+    const char *copy_string(const string &value) {
+        char *result = static_cast<char *>(arena.allocate(value.size() + 1, 1));
+        std::memcpy(result, value.data(), value.size());
+        result[value.size()] = 0;
+        return result;
+    }
+
+    const char *intern(string &&key) {
+        auto it = interned_keys.find(key);
+        if (it != interned_keys.end())
+            return it->second;
+        const char *result = copy_string(key);
+        interned_keys.emplace(std::move(key), result);
+        return result;
+    }
+};
+
 /* JsonParser
  *
  * Object that tracks all state of an in-progress parse.
@@ -348,7 +583,7 @@ struct JsonParser final {
 
     /* State
      */
-    const string &str;
+    const JsonInput str;
     size_t i;
     string &err;
     bool failed;
@@ -566,11 +801,13 @@ struct JsonParser final {
         }
     }
 
-    /* parse_number()
+    /* parse_number(builder)
      *
      * Parse a double.
      */
-    Json parse_number() {
+    template <typename Builder>
+    typename Builder::Value parse_number(Builder &builder) {
+        typedef typename Builder::Value Value;
         size_t start_pos = i;
 
         if (str[i] == '-')
@@ -580,25 +817,26 @@ struct JsonParser final {
         if (str[i] == '0') {
             i++;
             if (in_range(str[i], '0', '9'))
-                return fail("leading 0s not permitted in numbers");
+                return fail("leading 0s not permitted in numbers", Value());
         } else if (in_range(str[i], '1', '9')) {
             i++;
             while (in_range(str[i], '0', '9'))
                 i++;
         } else {
-            return fail("invalid " + esc(str[i]) + " in number");
+            return fail("invalid " + esc(str[i]) + " in number", Value());
         }
 
         if (str[i] != '.' && str[i] != 'e' && str[i] != 'E'
                 && (i - start_pos) <= static_cast<size_t>(std::numeric_limits<int>::digits10)) {
-            return std::atoi(str.c_str() + start_pos);
+            char buf[16];
+            return builder.make_int(std::atoi(number_token(start_pos, buf, sizeof buf)));
         }
 
         // Decimal part
         if (str[i] == '.') {
             i++;
             if (!in_range(str[i], '0', '9'))
-                return fail("at least one digit required in fractional part");
+                return fail("at least one digit required in fractional part", Value());
 
             while (in_range(str[i], '0', '9'))
                 i++;
@@ -612,13 +850,35 @@ struct JsonParser final {
                 i++;
 
             if (!in_range(str[i], '0', '9'))
-                return fail("at least one digit required in exponent");
+                return fail("at least one digit required in exponent", Value());
 
             while (in_range(str[i], '0', '9'))
                 i++;
         }
 
-        return std::strtod(str.c_str() + start_pos, nullptr);
+        char buf[64];
+        string long_token;
+        const char *token = number_token(start_pos, buf, sizeof buf);
+        if (!token) {
+            long_token.assign(str.data + start_pos, i - start_pos);
+            token = long_token.c_str();
+        }
+        return builder.make_double(std::strtod(token, nullptr));
+    }
+
+    /* number_token(start_pos, buf, buf_size)
+     *
+     * Copy the number that was just scanned into buf as a NUL-terminated string so that
+     * the C conversion functions never read past the end of the input. Returns nullptr if
+     * the literal does not fit.
+     */
+    const char *number_token(size_t start_pos, char *buf, size_t buf_size) const {
+        size_t length = i - start_pos;
+        if (length >= buf_size)
+            return nullptr;
+        std::memcpy(buf, str.data + start_pos, length);
+        buf[length] = 0;
+        return buf;
     }
 
     /* expect(str, res)
@@ -626,14 +886,15 @@ struct JsonParser final {
      * Expect that 'str' starts at the character that was just read. If it does, advance
      * the input and return res. If not, flag an error.
      */
-    Json expect(const string &expected, Json res) {
+    template <typename T>
+    T expect(const string &expected, T res) {
         assert(i != 0);
         i--;
         if (str.compare(i, expected.length(), expected) == 0) {
             i += expected.length();
             return res;
         } else {
-            return fail("parse error: expected " + expected + ", got " + str.substr(i, expected.length()));
+            return fail("parse error: expected " + expected + ", got " + str.substr(i, expected.length()), T());
         }
     }
 
@@ -642,102 +903,125 @@ struct JsonParser final {
      * Parse a JSON object.
      */
     Json parse_json(int depth) {
+        JsonHeapBuilder builder;
+        return parse_json(builder, depth);
+    }
+
+    /* parse_json(builder, depth)
+     *
+     * Parse a JSON object into the tree representation of builder.
+     */
+    template <typename Builder>
+    typename Builder::Value parse_json(Builder &builder, int depth) {
+        typedef typename Builder::Value Value;
+
         if (depth > max_depth) {
-            return fail("exceeded maximum nesting depth");
+            return fail("exceeded maximum nesting depth", Value());
         }
 
         char ch = get_next_token();
         if (failed)
-            return Json();
+            return Value();
 
         if (ch == '-' || (ch >= '0' && ch <= '9')) {
             i--;
-            return parse_number();
+            return parse_number(builder);
         }
 
         if (ch == 't')
-            return expect("true", true);
+            return expect("true", builder.make_bool(true));
 
         if (ch == 'f')
-            return expect("false", false);
+            return expect("false", builder.make_bool(false));
 
         if (ch == 'n')
-            return expect("null", Json());
+            return expect("null", builder.make_null());
 
-        if (ch == '"')
-            return parse_string();
+        if (ch == '"') {
+            string value = parse_string();
+            if (failed)
+                return Value();
+            return builder.make_string(std::move(value));
+        }
 
         if (ch == '{') {
-            map<string, Json> data;
+            typename Builder::Object data = builder.begin_object();
             ch = get_next_token();
             if (ch == '}')
-                return data;
+                return builder.end_object(data);
 
             while (1) {
                 if (ch != '"')
-                    return fail("expected '\"' in object, got " + esc(ch));
+                    return fail("expected '\"' in object, got " + esc(ch), Value());
 
                 string key = parse_string();
                 if (failed)
-                    return Json();
+                    return Value();
 
                 ch = get_next_token();
                 if (ch != ':')
-                    return fail("expected ':' in object, got " + esc(ch));
+                    return fail("expected ':' in object, got " + esc(ch), Value());
 
-                data[std::move(key)] = parse_json(depth + 1);
+                Value value = parse_json(builder, depth + 1);
                 if (failed)
-                    return Json();
+                    return Value();
+                builder.add_member(data, std::move(key), std::move(value));
 
                 ch = get_next_token();
                 if (ch == '}')
                     break;
                 if (ch != ',')
-                    return fail("expected ',' in object, got " + esc(ch));
+                    return fail("expected ',' in object, got " + esc(ch), Value());
 
                 ch = get_next_token();
             }
-            return data;
+            return builder.end_object(data);
         }
 
         if (ch == '[') {
-            vector<Json> data;
+            typename Builder::Array data = builder.begin_array();
             ch = get_next_token();
             if (ch == ']')
-                return data;
+                return builder.end_array(data);
 
             while (1) {
                 i--;
-                data.push_back(parse_json(depth + 1));
+                Value value = parse_json(builder, depth + 1);
                 if (failed)
-                    return Json();
+                    return Value();
+                builder.add_element(data, std::move(value));
 
                 ch = get_next_token();
                 if (ch == ']')
                     break;
                 if (ch != ',')
-                    return fail("expected ',' in list, got " + esc(ch));
+                    return fail("expected ',' in list, got " + esc(ch), Value());
 
                 ch = get_next_token();
                 (void)ch;
             }
-            return data;
+            return builder.end_array(data);
         }
 
-        return fail("expected value, got " + esc(ch));
+        return fail("expected value, got " + esc(ch), Value());
     }
 };
-}//namespace {
+
+} // namespace detail
 
 Json Json::parse(const string &in, string &err, JsonParse strategy) {
-    JsonParser parser { in, 0, err, false, strategy };
+    return parse(in.data(), in.size(), err, strategy);
+}
+
+Json Json::parse(const char *in, size_t size, string &err, JsonParse strategy) {
+    detail::JsonParser parser { detail::JsonInput { in, size }, 0, err, false, strategy };
     Json result = parser.parse_json(0);
 
     // Check for any trailing garbage
     parser.consume_garbage();
     if (parser.failed)
         return Json();
-    if (parser.i != in.size())
+    if (parser.i != size)
         return parser.fail("unexpected trailing " + esc(in[parser.i]));
 
     return result;
@@ -748,7 +1032,7 @@ vector<Json> Json::parse_multi(const string &in,
                                std::string::size_type &parser_stop_pos,
                                string &err,
                                JsonParse strategy) {
-    JsonParser parser { in, 0, err, false, strategy };
+    detail::JsonParser parser { detail::JsonInput { in.data(), in.size() }, 0, err, false, strategy };
     parser_stop_pos = 0;
     vector<Json> json_vec;
     while (parser.i != in.size() && !parser.failed) {
@@ -765,6 +1049,296 @@ vector<Json> Json::parse_multi(const string &in,
     return json_vec;
 }
 
+/* * * * * * * * * * * * * * * * * * * *
+ * Pull reader
+ */
+
+struct JsonReader::State {
+    string err;
+    detail::JsonParser parser;
+    // One entry per open object/array: true until its first member has been read.
+    vector<bool> expect_first;
+
+    State(const char *data, size_t size, JsonParse strategy) :
+        parser { detail::JsonInput { data, size }, 0, err, false, strategy } {
+    }
+
+    bool fail(string &&msg) {
+        return parser.fail(std::move(msg), false);
+    }
+
+    bool begin_container(char open) {
+        char ch = parser.get_next_token();
+        if (parser.failed)
+            return false;
+        if (ch != open)
+            return fail(string("expected '") + open + "', got " + esc(ch));
+        if (expect_first.size() >= static_cast<size_t>(max_depth))
+            return fail("exceeded maximum nesting depth");
+        expect_first.push_back(true);
+        return true;
+    }
+
+    /* next_member(close, ch)
+     *
+     * Consume the separator before the next member of the innermost container. Returns
+     * false once the closing character has been consumed, leaving the first character of
+     * the member in ch otherwise.
+     */
+    bool next_member(char close, char &ch) {
+        if (expect_first.empty())
+            return fail("no open container");
+        ch = parser.get_next_token();
+        if (parser.failed)
+            return false;
+        if (ch == close) {
+            expect_first.pop_back();
+            return false;
+        }
+        if (expect_first.back()) {
+            expect_first.back() = false;
+            return true;
+        }
+        if (ch != ',')
+            return fail(string("expected ',' or '") + close + "', got " + esc(ch));
+        ch = parser.get_next_token();
+        return !parser.failed;
+    }
+};
+
+JsonReader::JsonReader(const char *data, size_t size, JsonParse strategy) :
+    m_state(new State(data, size, strategy)) {
+}
+
+JsonReader::~JsonReader() {
+}
+
+bool JsonReader::begin_object() {
+    return !m_state->parser.failed && m_state->begin_container('{');
+}
+
+bool JsonReader::begin_array() {
+    return !m_state->parser.failed && m_state->begin_container('[');
+}
+
+bool JsonReader::next_key(string &key) {
+    if (m_state->parser.failed)
+        return false;
+    char ch = 0;
+    if (!m_state->next_member('}', ch))
+        return false;
+    if (ch != '"')
+        return m_state->fail("expected '\"' in object, got " + esc(ch));
+
+    key = m_state->parser.parse_string();
+    if (m_state->parser.failed)
+        return false;
+
+    ch = m_state->parser.get_next_token();
+    if (ch != ':')
+        return m_state->fail("expected ':' in object, got " + esc(ch));
+    return !m_state->parser.failed;
+}
+
+bool JsonReader::next_element() {
+    if (m_state->parser.failed)
+        return false;
+    char ch = 0;
+    if (!m_state->next_member(']', ch))
+        return false;
+    // Leave the first character of the element for read_value()/begin_*().
+    m_state->parser.i--;
+    return true;
+}
+
+Json JsonReader::read_value() {
+    if (m_state->parser.failed)
+        return Json();
+    Json result = m_state->parser.parse_json(static_cast<int>(m_state->expect_first.size()));
+    if (m_state->parser.failed)
+        return Json();
+    return result;
+}
+
+bool JsonReader::finish() {
+    if (m_state->parser.failed)
+        return false;
+    if (!m_state->expect_first.empty())
+        return m_state->fail("unexpected end of input");
+    m_state->parser.consume_garbage();
+    if (m_state->parser.failed)
+        return false;
+    if (m_state->parser.i != m_state->parser.str.size())
+        return m_state->fail("unexpected trailing " + esc(m_state->parser.str[m_state->parser.i]));
+    return true;
+}
+
+bool JsonReader::failed() const {
+    return m_state->parser.failed;
+}
+
+const string &JsonReader::error() const {
+    return m_state->err;
+}
+
+size_t JsonReader::offset() const {
+    return m_state->parser.i;
+}
+
+/* * * * * * * * * * * * * * * * * * * *
+ * Arena documents
+ */
+
+static const JsonNode & static_null_node() {
+    static const JsonNode null_node;
+    return null_node;
+}
+
+double JsonNode::number_value() const {
+    return m_type == Json::NUMBER ? m_number : 0;
+}
+
+int JsonNode::int_value() const {
+    return m_type == Json::NUMBER ? static_cast<int>(m_number) : 0;
+}
+
+bool JsonNode::bool_value() const {
+    return m_type == Json::BOOL ? m_bool : false;
+}
+
+const char * JsonNode::string_data() const {
+    return m_type == Json::STRING ? m_string : "";
+}
+
+size_t JsonNode::string_size() const {
+    return m_type == Json::STRING ? m_size : 0;
+}
+
+size_t JsonNode::size() const {
+    return (m_type == Json::ARRAY || m_type == Json::OBJECT) ? m_size : 0;
+}
+
+const JsonNode * JsonNode::array_begin() const {
+    return m_type == Json::ARRAY ? m_items : nullptr;
+}
+
+const JsonNode * JsonNode::array_end() const {
+    return m_type == Json::ARRAY ? m_items + m_size : nullptr;
+}
+
+const JsonNode::Member * JsonNode::object_begin() const {
+    return m_type == Json::OBJECT ? m_members : nullptr;
+}
+
+const JsonNode::Member * JsonNode::object_end() const {
+    return m_type == Json::OBJECT ? m_members + m_size : nullptr;
+}
+
+const JsonNode & JsonNode::operator[] (size_t i) const {
+    if (m_type != Json::ARRAY || i >= m_size)
+        return static_null_node();
+    return m_items[i];
+}
+
+const JsonNode & JsonNode::operator[] (const string &key) const {
+    const JsonNode *value = find(key.data(), key.size());
+    return value ? *value : static_null_node();
+}
+
+const JsonNode * JsonNode::find(const char *key, size_t key_size) const {
+    if (m_type != Json::OBJECT)
+        return nullptr;
+    Member probe { key, static_cast<uint32_t>(std::min(key_size, static_cast<size_t>(UINT32_MAX))), JsonNode() };
+    if (probe.key_size != key_size)
+        return nullptr;
+    const Member *end = m_members + m_size;
+    const Member *it = std::lower_bound(m_members, end, probe, detail::JsonArenaBuilder::key_less);
+    if (it == end || detail::JsonArenaBuilder::key_less(probe, *it))
+        return nullptr;
+    return &it->value;
+}
+
+Json JsonNode::to_json() const {
+    switch (m_type) {
+        case Json::NUL:
+            return Json();
+        case Json::NUMBER:
+            if (m_is_int)
+                return static_cast<int>(m_number);
+            return m_number;
+        case Json::BOOL:
+            return m_bool;
+        case Json::STRING:
+            return string(m_string, m_size);
+        case Json::ARRAY: {
+            Json::array items;
+            items.reserve(m_size);
+            for (const JsonNode *it = array_begin(); it != array_end(); ++it)
+                items.push_back(it->to_json());
+            return items;
+        }
+        case Json::OBJECT: {
+            Json::object items;
+            for (const Member *it = object_begin(); it != object_end(); ++it)
+                items.emplace_hint(items.end(), string(it->key, it->key_size), it->value.to_json());
+            return items;
+        }
+    }
+    return Json();
+}
+
+JsonDocument::JsonDocument() noexcept : m_root(nullptr) {
+}
+
+JsonDocument::~JsonDocument() {
+}
+
+JsonDocument::JsonDocument(JsonDocument &&other) noexcept :
+    m_arena(std::move(other.m_arena)),
+    m_root(other.m_root) {
+    other.m_root = nullptr;
+}
+
+JsonDocument & JsonDocument::operator=(JsonDocument &&other) noexcept {
+    if (this != &other) {
+        m_arena = std::move(other.m_arena);
+        m_root = other.m_root;
+        other.m_root = nullptr;
+    }
+    return *this;
+}
+
+const JsonNode & JsonDocument::root() const {
+    return m_root ? *m_root : static_null_node();
+}
+
+JsonDocument JsonDocument::parse(const char *in, size_t size, string &err, JsonParse strategy, size_t chunk_size) {
+    // Lengths and counts are stored as 32 bits; no string or container can exceed the input size.
+    if (size > UINT32_MAX) {
+        err = "input too large";
+        return JsonDocument();
+    }
+
+    std::unique_ptr<JsonArena> arena(new JsonArena(chunk_size));
+    detail::JsonArenaBuilder builder(*arena);
+    detail::JsonParser parser { detail::JsonInput { in, size }, 0, err, false, strategy };
+    JsonNode root = parser.parse_json(builder, 0);
+
+    // Check for any trailing garbage
+    parser.consume_garbage();
+    if (parser.failed)
+        return JsonDocument();
+    if (parser.i != size) {
+        parser.fail("unexpected trailing " + esc(in[parser.i]));
+        return JsonDocument();
+    }
+
+    JsonDocument document;
+    document.m_root = new (arena->allocate(sizeof(JsonNode), alignof(JsonNode))) JsonNode(root);
+    document.m_arena = std::move(arena);
+    return document;
+}
+
 /* * * * * * * * * * * * * * * * * * * *
  * Shape-checking
  */